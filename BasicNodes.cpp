@@ -6,6 +6,7 @@
 
 // 开始节点实现
 StartNodeModel::StartNodeModel()
+    : m_flowData(std::make_shared<FlowData>())
 {
     m_label = new QLabel("开始");
     m_label->setAlignment(Qt::AlignCenter);
@@ -25,7 +26,8 @@ NodeDataType StartNodeModel::dataType(PortType portType, PortIndex portIndex) co
 
 std::shared_ptr<NodeData> StartNodeModel::outData(PortIndex port)
 {
-    return std::make_shared<FlowData>();
+    // FlowData 不携带状态，所有下游共享同一个实例
+    return m_flowData;
 }
 
 void StartNodeModel::setInData(std::shared_ptr<NodeData> data, PortIndex portIndex)
@@ -40,7 +42,7 @@ QWidget* StartNodeModel::embeddedWidget()
 
 QJsonObject StartNodeModel::save() const
 {
-    return QJsonObject{};
+    return NodeDelegateModel::save();
 }
 
 void StartNodeModel::load(QJsonObject const& json)
@@ -88,7 +90,7 @@ QWidget* EndNodeModel::embeddedWidget()
 
 QJsonObject EndNodeModel::save() const
 {
-    return QJsonObject{};
+    return NodeDelegateModel::save();
 }
 
 void EndNodeModel::load(QJsonObject const& json)
@@ -41,6 +41,7 @@ public:
 
 private:
     QLabel* m_label = nullptr;
+    std::shared_ptr<FlowData> m_flowData;
 };
 
 // 结束节点
@@ -0,0 +1,79 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_BOUNDEDQUEUE_H
+#define NODEEDITORDEMO_BOUNDEDQUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+// 有界阻塞队列，用于线程之间传递数据
+// 队列满时 push 阻塞，形成背压；close 之后 push 失败，pop 取完剩余元素后返回 false
+template<typename T>
+class BoundedQueue
+{
+public:
+    explicit BoundedQueue(size_t capacity = 4)
+        : m_capacity(capacity > 0 ? capacity : 1)
+    {
+    }
+
+    bool push(T value)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notFull.wait(lock, [this] { return m_closed || m_items.size() < m_capacity; });
+        if (m_closed) return false;
+        m_items.push_back(std::move(value));
+        lock.unlock();
+        m_notEmpty.notify_one();
+        return true;
+    }
+
+    bool pop(T& value)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notEmpty.wait(lock, [this] { return m_closed || !m_items.empty(); });
+        if (m_items.empty()) return false;
+        value = std::move(m_items.front());
+        m_items.pop_front();
+        lock.unlock();
+        m_notFull.notify_one();
+        return true;
+    }
+
+    // 不等待，队列为空时立即返回 false
+    bool tryPop(T& value)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_items.empty()) return false;
+        value = std::move(m_items.front());
+        m_items.pop_front();
+        lock.unlock();
+        m_notFull.notify_one();
+        return true;
+    }
+
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+        }
+        m_notFull.notify_all();
+        m_notEmpty.notify_all();
+    }
+
+    size_t capacity() const { return m_capacity; }
+
+private:
+    const size_t m_capacity;
+    std::mutex m_mutex;
+    std::condition_variable m_notFull;
+    std::condition_variable m_notEmpty;
+    std::deque<T> m_items;
+    bool m_closed = false;
+};
+
+#endif // NODEEDITORDEMO_BOUNDEDQUEUE_H
\ No newline at end of file
@@ -0,0 +1,137 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "BufferNodes.h"
+#include "Logging.h"
+#include <QFile>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QLocale>
+
+// 文件数据节点实现
+FileSourceModel::FileSourceModel()
+    : m_data(std::make_shared<BufferData>())
+{
+    m_button = new QPushButton("选择文件...");
+    m_button->setMinimumWidth(110);
+    connect(m_button, &QPushButton::clicked, this, &FileSourceModel::chooseFile);
+}
+
+unsigned int FileSourceModel::nPorts(PortType portType) const
+{
+    return (portType == PortType::Out) ? 1 : 0; // 只有输出端口
+}
+
+NodeDataType FileSourceModel::dataType(PortType portType, PortIndex portIndex) const
+{
+    return BufferData().type();
+}
+
+std::shared_ptr<NodeData> FileSourceModel::outData(PortIndex port)
+{
+    // 所有下游共享同一个实例，也就共享同一块数据
+    return m_data;
+}
+
+void FileSourceModel::setInData(std::shared_ptr<NodeData> data, PortIndex portIndex)
+{
+    // 文件数据节点没有输入端口
+}
+
+QWidget* FileSourceModel::embeddedWidget()
+{
+    return m_button;
+}
+
+QJsonObject FileSourceModel::save() const
+{
+    QJsonObject json = NodeDelegateModel::save();
+    json["file"] = m_filePath;
+    return json;
+}
+
+void FileSourceModel::load(QJsonObject const& json)
+{
+    setFilePath(filePathFromState(json));
+}
+
+QString FileSourceModel::filePathFromState(const QJsonObject& state)
+{
+    return state["file"].toString();
+}
+
+SharedBuffer FileSourceModel::loadFile(const QString& filePath)
+{
+    QFile file(filePath);
+    if (filePath.isEmpty() || !file.open(QIODevice::ReadOnly)) {
+        return SharedBuffer();
+    }
+    return SharedBuffer::fromByteArray(file.readAll(), QFileInfo(filePath).suffix());
+}
+
+void FileSourceModel::setFilePath(const QString& filePath)
+{
+    if (m_filePath == filePath) return;
+
+    m_filePath = filePath;
+    SharedBuffer buffer = loadFile(filePath);
+    if (!filePath.isEmpty() && buffer.isNull()) {
+        qCWarning(lcUi) << "无法读取文件:" << filePath;
+    }
+    m_button->setText(filePath.isEmpty() ? QString("选择文件...") : QFileInfo(filePath).fileName());
+    m_button->setToolTip(filePath);
+    m_data = std::make_shared<BufferData>(std::move(buffer));
+    emit filePathChanged();
+    emit dataUpdated(0);
+}
+
+void FileSourceModel::chooseFile()
+{
+    const QString filePath = QFileDialog::getOpenFileName(m_button, "选择文件", m_filePath);
+    if (!filePath.isEmpty()) {
+        setFilePath(filePath);
+    }
+}
+
+// 数据块信息节点实现
+BufferInfoModel::BufferInfoModel()
+{
+    m_label = new QLabel("-");
+    m_label->setAlignment(Qt::AlignCenter);
+    m_label->setStyleSheet("QLabel { background-color: #ECEFF1; color: #263238; border: 1px solid #90A4AE; border-radius: 4px; padding: 6px; }");
+    m_label->setMinimumSize(80, 30);
+}
+
+unsigned int BufferInfoModel::nPorts(PortType portType) const
+{
+    return (portType == PortType::In) ? 1 : 0; // 只有输入端口
+}
+
+NodeDataType BufferInfoModel::dataType(PortType portType, PortIndex portIndex) const
+{
+    return BufferData().type();
+}
+
+std::shared_ptr<NodeData> BufferInfoModel::outData(PortIndex port)
+{
+    return nullptr;
+}
+
+void BufferInfoModel::setInData(std::shared_ptr<NodeData> data, PortIndex portIndex)
+{
+    // 只保存句柄，不复制数据
+    m_data = std::dynamic_pointer_cast<BufferData>(data);
+    const SharedBuffer current = buffer();
+    if (current.isNull()) {
+        m_label->setText("-");
+        return;
+    }
+    const QString format = current.format().isEmpty() ? QString() : QString(" (%1)").arg(current.format());
+    m_label->setText(QLocale().formattedDataSize(static_cast<qint64>(current.size())) + format);
+}
+
+QWidget* BufferInfoModel::embeddedWidget()
+{
+    return m_label;
+}
\ No newline at end of file
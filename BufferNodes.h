@@ -0,0 +1,96 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_BUFFERNODES_H
+#define NODEEDITORDEMO_BUFFERNODES_H
+
+#include <QtNodes/NodeDelegateModel>
+#include <QtNodes/NodeData>
+#include <QLabel>
+#include <QPushButton>
+#include "SharedBuffer.h"
+
+using namespace QtNodes;
+
+// 大块数据类型（图像、张量、字节块），端口之间传递 SharedBuffer 句柄，不复制数据；
+// 创建后不再修改，数据变化时下发新的实例，扇出到多个下游时它们共享同一个实例
+class BufferData : public NodeData
+{
+public:
+    BufferData() = default;
+    explicit BufferData(SharedBuffer buffer) : m_buffer(std::move(buffer)) {}
+
+    NodeDataType type() const override
+    {
+        return NodeDataType{"buffer", "Buffer"};
+    }
+
+    const SharedBuffer& buffer() const { return m_buffer; }
+
+private:
+    SharedBuffer m_buffer;
+};
+
+// 文件数据节点：把选择的文件整体读入一个 SharedBuffer，从一个数据块输出端口下发
+class FileSourceModel : public NodeDelegateModel
+{
+    Q_OBJECT
+public:
+    FileSourceModel();
+
+    QString caption() const override { return "文件数据"; }
+    QString name() const override { return "FileSource"; }
+
+    unsigned int nPorts(PortType portType) const override;
+    NodeDataType dataType(PortType portType, PortIndex portIndex) const override;
+    std::shared_ptr<NodeData> outData(PortIndex port) override;
+    void setInData(std::shared_ptr<NodeData> data, PortIndex portIndex) override;
+    QWidget* embeddedWidget() override;
+    QJsonObject save() const override;
+    void load(QJsonObject const& json) override;
+
+    QString filePath() const { return m_filePath; }
+    void setFilePath(const QString& filePath);
+
+    // 读取整个文件；读取失败返回空缓冲区。数据由 QByteArray 持有，转换为 SharedBuffer 时不复制
+    static SharedBuffer loadFile(const QString& filePath);
+    static QString filePathFromState(const QJsonObject& state);
+
+signals:
+    // 文件改变会影响执行计划（执行器按保存的路径绑定）
+    void filePathChanged();
+
+private:
+    void chooseFile();
+
+    QPushButton* m_button = nullptr;
+    QString m_filePath;
+    std::shared_ptr<BufferData> m_data;
+};
+
+// 数据块信息节点：显示输入数据块的大小和格式
+class BufferInfoModel : public NodeDelegateModel
+{
+    Q_OBJECT
+public:
+    BufferInfoModel();
+
+    QString caption() const override { return "数据块信息"; }
+    QString name() const override { return "BufferInfo"; }
+
+    unsigned int nPorts(PortType portType) const override;
+    NodeDataType dataType(PortType portType, PortIndex portIndex) const override;
+    std::shared_ptr<NodeData> outData(PortIndex port) override;
+    void setInData(std::shared_ptr<NodeData> data, PortIndex portIndex) override;
+    QWidget* embeddedWidget() override;
+
+    // 最近收到的数据块，未连接时为空
+    SharedBuffer buffer() const { return m_data ? m_data->buffer() : SharedBuffer(); }
+
+private:
+    QLabel* m_label = nullptr;
+    std::shared_ptr<BufferData> m_data;
+};
+
+#endif // NODEEDITORDEMO_BUFFERNODES_H
\ No newline at end of file
@@ -0,0 +1,170 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "CheckpointStore.h"
+#include "Logging.h"
+#include "WorkerProtocol.h"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QtConcurrent/QtConcurrentRun>
+
+namespace {
+
+constexpr quint32 CheckpointMagic = 0x4E45434B;   // "NECK"
+constexpr quint32 CheckpointVersion = 2;   // 2: 整数记录原始元类型
+const char* const CheckpointSuffix = ".ckpt";
+
+} // namespace
+
+CheckpointStore::CheckpointStore()
+{
+    // 单个写线程：检查点按完成顺序落盘，也不与执行线程争抢 CPU
+    m_writers.setMaxThreadCount(1);
+}
+
+CheckpointStore::~CheckpointStore()
+{
+    waitForWrites();
+}
+
+bool CheckpointStore::open(const QString& directory)
+{
+    waitForWrites();
+
+    QDir dir(directory);
+    if (!dir.exists() && !dir.mkpath(".")) {
+        qCWarning(lcExec) << "无法创建检查点目录:" << directory;
+        return false;
+    }
+
+    QSet<QByteArray> keys;
+    for (const QString& name : dir.entryList({QString("*") + CheckpointSuffix}, QDir::Files)) {
+        keys.insert(name.left(name.size() - static_cast<int>(qstrlen(CheckpointSuffix))).toLatin1());
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_directory = dir.absolutePath();
+    m_keys = keys;
+    qCDebug(lcExec) << "检查点目录:" << m_directory << "已有检查点:" << m_keys.size();
+    return true;
+}
+
+void CheckpointStore::close()
+{
+    waitForWrites();
+    QMutexLocker locker(&m_mutex);
+    m_directory.clear();
+    m_keys.clear();
+}
+
+bool CheckpointStore::contains(const QByteArray& key) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_keys.contains(key);
+}
+
+void CheckpointStore::storeAsync(const QByteArray& key, const NodeValue& value)
+{
+    if (!isOpen() || contains(key)) return;
+
+    ++m_pendingWrites;
+    QtConcurrent::run(&m_writers, [this, key, value]() {
+        write(key, value);
+        --m_pendingWrites;
+    });
+}
+
+void CheckpointStore::write(const QByteArray& key, const NodeValue& value)
+{
+    // QSaveFile 先写临时文件再改名，中断时不会留下不完整的检查点
+    QSaveFile file(filePath(key));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(lcExec) << "无法写入检查点:" << file.fileName();
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(WorkerProtocol::StreamVersion);
+    stream << CheckpointMagic << CheckpointVersion;
+    try {
+        WorkerProtocol::writeValue(stream, value, nullptr);
+    } catch (const std::exception& e) {
+        qCWarning(lcExec) << "检查点序列化失败:" << e.what();
+        file.cancelWriting();
+        return;
+    }
+
+    if (stream.status() != QDataStream::Ok || !file.commit()) {
+        qCWarning(lcExec) << "检查点写入失败:" << file.fileName();
+        return;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_keys.insert(key);
+}
+
+bool CheckpointStore::load(const QByteArray& key, NodeValue& value)
+{
+    QFile file(filePath(key));
+    if (file.open(QIODevice::ReadOnly)) {
+        QDataStream stream(&file);
+        stream.setVersion(WorkerProtocol::StreamVersion);
+        quint32 magic = 0;
+        quint32 version = 0;
+        stream >> magic >> version;
+        if (magic == CheckpointMagic && version == CheckpointVersion) {
+            try {
+                value = WorkerProtocol::readValue(stream);
+                if (stream.status() == QDataStream::Ok) {
+                    return true;
+                }
+            } catch (const std::exception& e) {
+                qCWarning(lcExec) << "检查点读取失败:" << e.what();
+            }
+        }
+    }
+
+    qCWarning(lcExec) << "检查点损坏，已忽略:" << file.fileName();
+    QMutexLocker locker(&m_mutex);
+    m_keys.remove(key);
+    return false;
+}
+
+void CheckpointStore::waitForWrites()
+{
+    m_writers.waitForDone();
+}
+
+void CheckpointStore::clear()
+{
+    waitForWrites();
+    QMutexLocker locker(&m_mutex);
+    for (const QByteArray& key : m_keys) {
+        QFile::remove(filePath(key));
+    }
+    m_keys.clear();
+}
+
+QString CheckpointStore::filePath(const QByteArray& key) const
+{
+    return m_directory + '/' + QString::fromLatin1(key) + CheckpointSuffix;
+}
+
+QByteArray CheckpointStore::nodeKey(const QJsonObject& nodeState, const std::vector<InputKey>& inputs)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    // 格式版本参与键计算，旧版本的检查点不会被命中
+    hash.addData(reinterpret_cast<const char*>(&CheckpointVersion), sizeof(CheckpointVersion));
+    hash.addData(QJsonDocument(nodeState).toJson(QJsonDocument::Compact));
+    for (const InputKey& input : inputs) {
+        hash.addData(reinterpret_cast<const char*>(&input.port), sizeof(input.port));
+        hash.addData(reinterpret_cast<const char*>(&input.upstreamPort), sizeof(input.upstreamPort));
+        hash.addData(input.upstreamKey);
+    }
+    return hash.result().toHex();
+}
\ No newline at end of file
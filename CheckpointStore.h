@@ -0,0 +1,66 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_CHECKPOINTSTORE_H
+#define NODEEDITORDEMO_CHECKPOINTSTORE_H
+
+#include "NodeValue.h"
+#include <QByteArray>
+#include <QJsonObject>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+#include <atomic>
+#include <vector>
+
+// 节点结果的磁盘检查点
+// 键由节点内容（类型和参数）与各输入上游的键逐级哈希得到，不读取输入数据本身：
+// 上游的键相同即意味着输入相同（假定执行器是确定性的）。
+// 每个检查点是目录下的一个 <键>.ckpt 文件，写入在后台线程进行，写完后才对 contains() 可见，
+// 因此执行失败或中断时目录中只有完整的检查点，下一次执行从这些检查点构成的前沿继续。
+class CheckpointStore
+{
+public:
+    struct InputKey
+    {
+        PortIndex port;
+        PortIndex upstreamPort;
+        QByteArray upstreamKey;
+    };
+
+    CheckpointStore();
+    ~CheckpointStore();
+
+    // 打开（必要时创建）目录并读取已有检查点的索引
+    bool open(const QString& directory);
+    void close();
+    bool isOpen() const { return !m_directory.isEmpty(); }
+    const QString& directory() const { return m_directory; }
+
+    bool contains(const QByteArray& key) const;
+    // 复制值（缓冲区只增加引用计数）后交给后台线程写入，立即返回
+    void storeAsync(const QByteArray& key, const NodeValue& value);
+    // 同步读取；文件损坏时从索引中移除并返回 false
+    bool load(const QByteArray& key, NodeValue& value);
+    void waitForWrites();
+    int pendingWrites() const { return m_pendingWrites.load(); }
+    // 删除目录中的所有检查点
+    void clear();
+
+    static QByteArray nodeKey(const QJsonObject& nodeState, const std::vector<InputKey>& inputs);
+
+private:
+    QString filePath(const QByteArray& key) const;
+    void write(const QByteArray& key, const NodeValue& value);
+
+private:
+    QString m_directory;
+    mutable QMutex m_mutex;
+    QSet<QByteArray> m_keys;
+    QThreadPool m_writers;
+    std::atomic<int> m_pendingWrites{0};
+};
+
+#endif // NODEEDITORDEMO_CHECKPOINTSTORE_H
\ No newline at end of file
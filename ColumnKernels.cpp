@@ -0,0 +1,592 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "ColumnKernels.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#if !defined(NODEEDITOR_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+#  define NODEEDITOR_COLUMN_AVX2 1
+#  include <immintrin.h>
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    include <intrin.h>
+#    define AVX2_TARGET
+#  else
+#    define AVX2_TARGET __attribute__((target("avx2")))
+#  endif
+#elif !defined(NODEEDITOR_NO_SIMD) && (defined(__aarch64__) || defined(_M_ARM64))
+#  define NODEEDITOR_COLUMN_NEON 1
+#  include <arm_neon.h>
+#endif
+
+namespace {
+
+const QString Float64Format = QStringLiteral("f64");
+const QString Int64Format = QStringLiteral("i64");
+
+std::atomic<bool> g_simdEnabled(true);
+
+bool isCompare(ColumnOp op)
+{
+    return op >= ColumnOp::Less;
+}
+
+// ---- 标量实现，同时负责向量循环剩余的尾部元素 ----
+// 浮点最小/最大值与 _mm256_min_pd/_mm256_max_pd 一致：比较不成立（含 NaN、±0）时取第二个操作数，
+// 向量主体、尾部和标量实现对同一元素给出相同结果
+
+void binaryF64Scalar(ColumnOp op, const double* a, const double* b, double* out, size_t n)
+{
+    switch (op) {
+    case ColumnOp::Add: for (size_t i = 0; i < n; ++i) out[i] = a[i] + b[i]; break;
+    case ColumnOp::Subtract: for (size_t i = 0; i < n; ++i) out[i] = a[i] - b[i]; break;
+    case ColumnOp::Multiply: for (size_t i = 0; i < n; ++i) out[i] = a[i] * b[i]; break;
+    case ColumnOp::Divide: for (size_t i = 0; i < n; ++i) out[i] = a[i] / b[i]; break;
+    case ColumnOp::Min: for (size_t i = 0; i < n; ++i) out[i] = a[i] < b[i] ? a[i] : b[i]; break;
+    case ColumnOp::Max: for (size_t i = 0; i < n; ++i) out[i] = a[i] > b[i] ? a[i] : b[i]; break;
+    default: break;
+    }
+}
+
+void compareF64Scalar(ColumnOp op, const double* a, const double* b, qint64* out, size_t n)
+{
+    switch (op) {
+    case ColumnOp::Less: for (size_t i = 0; i < n; ++i) out[i] = a[i] < b[i]; break;
+    case ColumnOp::LessEqual: for (size_t i = 0; i < n; ++i) out[i] = a[i] <= b[i]; break;
+    case ColumnOp::Greater: for (size_t i = 0; i < n; ++i) out[i] = a[i] > b[i]; break;
+    case ColumnOp::GreaterEqual: for (size_t i = 0; i < n; ++i) out[i] = a[i] >= b[i]; break;
+    case ColumnOp::Equal: for (size_t i = 0; i < n; ++i) out[i] = a[i] == b[i]; break;
+    case ColumnOp::NotEqual: for (size_t i = 0; i < n; ++i) out[i] = a[i] != b[i]; break;
+    default: break;
+    }
+}
+
+void binaryI64Scalar(ColumnOp op, const qint64* a, const qint64* b, qint64* out, size_t n)
+{
+    switch (op) {
+    case ColumnOp::Add: for (size_t i = 0; i < n; ++i) out[i] = a[i] + b[i]; break;
+    case ColumnOp::Subtract: for (size_t i = 0; i < n; ++i) out[i] = a[i] - b[i]; break;
+    case ColumnOp::Multiply: for (size_t i = 0; i < n; ++i) out[i] = a[i] * b[i]; break;
+    case ColumnOp::Min: for (size_t i = 0; i < n; ++i) out[i] = std::min(a[i], b[i]); break;
+    case ColumnOp::Max: for (size_t i = 0; i < n; ++i) out[i] = std::max(a[i], b[i]); break;
+    default: break;
+    }
+}
+
+void compareI64Scalar(ColumnOp op, const qint64* a, const qint64* b, qint64* out, size_t n)
+{
+    switch (op) {
+    case ColumnOp::Less: for (size_t i = 0; i < n; ++i) out[i] = a[i] < b[i]; break;
+    case ColumnOp::LessEqual: for (size_t i = 0; i < n; ++i) out[i] = a[i] <= b[i]; break;
+    case ColumnOp::Greater: for (size_t i = 0; i < n; ++i) out[i] = a[i] > b[i]; break;
+    case ColumnOp::GreaterEqual: for (size_t i = 0; i < n; ++i) out[i] = a[i] >= b[i]; break;
+    case ColumnOp::Equal: for (size_t i = 0; i < n; ++i) out[i] = a[i] == b[i]; break;
+    case ColumnOp::NotEqual: for (size_t i = 0; i < n; ++i) out[i] = a[i] != b[i]; break;
+    default: break;
+    }
+}
+
+#if defined(NODEEDITOR_COLUMN_AVX2)
+
+// ---- AVX2：每次处理 4 个元素；比较结果的全 1 掩码右移 63 位得到 0/1 ----
+
+bool detectAvx2()
+{
+#  if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#  else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#  endif
+}
+
+bool hasAvx2()
+{
+    static const bool available = detectAvx2();
+    return available;
+}
+
+#  define F64_LOOP(expr) \
+    for (; i + 4 <= n; i += 4) { \
+        __m256d va = _mm256_loadu_pd(a + i); \
+        __m256d vb = _mm256_loadu_pd(b + i); \
+        _mm256_storeu_pd(out + i, (expr)); \
+    }
+
+#  define F64_COMPARE_LOOP(predicate) \
+    for (; i + 4 <= n; i += 4) { \
+        __m256d mask = _mm256_cmp_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), predicate); \
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), \
+                            _mm256_srli_epi64(_mm256_castpd_si256(mask), 63)); \
+    }
+
+#  define I64_LOOP(expr) \
+    for (; i + 4 <= n; i += 4) { \
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)); \
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)); \
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), (expr)); \
+    }
+
+AVX2_TARGET void binaryF64Avx2(ColumnOp op, const double* a, const double* b, double* out, size_t n)
+{
+    size_t i = 0;
+    switch (op) {
+    case ColumnOp::Add: F64_LOOP(_mm256_add_pd(va, vb)); break;
+    case ColumnOp::Subtract: F64_LOOP(_mm256_sub_pd(va, vb)); break;
+    case ColumnOp::Multiply: F64_LOOP(_mm256_mul_pd(va, vb)); break;
+    case ColumnOp::Divide: F64_LOOP(_mm256_div_pd(va, vb)); break;
+    case ColumnOp::Min: F64_LOOP(_mm256_min_pd(va, vb)); break;
+    case ColumnOp::Max: F64_LOOP(_mm256_max_pd(va, vb)); break;
+    default: break;
+    }
+    binaryF64Scalar(op, a + i, b + i, out + i, n - i);
+}
+
+AVX2_TARGET void compareF64Avx2(ColumnOp op, const double* a, const double* b, qint64* out, size_t n)
+{
+    size_t i = 0;
+    switch (op) {
+    case ColumnOp::Less: F64_COMPARE_LOOP(_CMP_LT_OQ); break;
+    case ColumnOp::LessEqual: F64_COMPARE_LOOP(_CMP_LE_OQ); break;
+    case ColumnOp::Greater: F64_COMPARE_LOOP(_CMP_GT_OQ); break;
+    case ColumnOp::GreaterEqual: F64_COMPARE_LOOP(_CMP_GE_OQ); break;
+    case ColumnOp::Equal: F64_COMPARE_LOOP(_CMP_EQ_OQ); break;
+    case ColumnOp::NotEqual: F64_COMPARE_LOOP(_CMP_NEQ_UQ); break;
+    default: break;
+    }
+    compareF64Scalar(op, a + i, b + i, out + i, n - i);
+}
+
+AVX2_TARGET void binaryI64Avx2(ColumnOp op, const qint64* a, const qint64* b, qint64* out, size_t n)
+{
+    // AVX2 没有 64 位整数乘法，乘法走标量循环
+    size_t i = 0;
+    switch (op) {
+    case ColumnOp::Add: I64_LOOP(_mm256_add_epi64(va, vb)); break;
+    case ColumnOp::Subtract: I64_LOOP(_mm256_sub_epi64(va, vb)); break;
+    case ColumnOp::Min: I64_LOOP(_mm256_blendv_epi8(va, vb, _mm256_cmpgt_epi64(va, vb))); break;
+    case ColumnOp::Max: I64_LOOP(_mm256_blendv_epi8(vb, va, _mm256_cmpgt_epi64(va, vb))); break;
+    default: break;
+    }
+    binaryI64Scalar(op, a + i, b + i, out + i, n - i);
+}
+
+AVX2_TARGET void compareI64Avx2(ColumnOp op, const qint64* a, const qint64* b, qint64* out, size_t n)
+{
+    size_t i = 0;
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    switch (op) {
+    case ColumnOp::Less: I64_LOOP(_mm256_srli_epi64(_mm256_cmpgt_epi64(vb, va), 63)); break;
+    case ColumnOp::LessEqual: I64_LOOP(_mm256_srli_epi64(_mm256_xor_si256(_mm256_cmpgt_epi64(va, vb), ones), 63)); break;
+    case ColumnOp::Greater: I64_LOOP(_mm256_srli_epi64(_mm256_cmpgt_epi64(va, vb), 63)); break;
+    case ColumnOp::GreaterEqual: I64_LOOP(_mm256_srli_epi64(_mm256_xor_si256(_mm256_cmpgt_epi64(vb, va), ones), 63)); break;
+    case ColumnOp::Equal: I64_LOOP(_mm256_srli_epi64(_mm256_cmpeq_epi64(va, vb), 63)); break;
+    case ColumnOp::NotEqual: I64_LOOP(_mm256_srli_epi64(_mm256_xor_si256(_mm256_cmpeq_epi64(va, vb), ones), 63)); break;
+    default: break;
+    }
+    compareI64Scalar(op, a + i, b + i, out + i, n - i);
+}
+
+#  undef F64_LOOP
+#  undef F64_COMPARE_LOOP
+#  undef I64_LOOP
+
+#elif defined(NODEEDITOR_COLUMN_NEON)
+
+// ---- NEON（AArch64）：每次处理 2 个元素 ----
+
+#  define F64_LOOP(expr) \
+    for (; i + 2 <= n; i += 2) { \
+        float64x2_t va = vld1q_f64(a + i); \
+        float64x2_t vb = vld1q_f64(b + i); \
+        vst1q_f64(out + i, (expr)); \
+    }
+
+#  define MASK_LOOP(load, type, expr) \
+    for (; i + 2 <= n; i += 2) { \
+        type va = load(a + i); \
+        type vb = load(b + i); \
+        vst1q_s64(reinterpret_cast<int64_t*>(out + i), vreinterpretq_s64_u64(vshrq_n_u64((expr), 63))); \
+    }
+
+#  define I64_LOOP(expr) \
+    for (; i + 2 <= n; i += 2) { \
+        int64x2_t va = vld1q_s64(reinterpret_cast<const int64_t*>(a + i)); \
+        int64x2_t vb = vld1q_s64(reinterpret_cast<const int64_t*>(b + i)); \
+        vst1q_s64(reinterpret_cast<int64_t*>(out + i), (expr)); \
+    }
+
+#  define LOAD_I64(p) vld1q_s64(reinterpret_cast<const int64_t*>(p))
+
+void binaryF64Neon(ColumnOp op, const double* a, const double* b, double* out, size_t n)
+{
+    size_t i = 0;
+    switch (op) {
+    case ColumnOp::Add: F64_LOOP(vaddq_f64(va, vb)); break;
+    case ColumnOp::Subtract: F64_LOOP(vsubq_f64(va, vb)); break;
+    case ColumnOp::Multiply: F64_LOOP(vmulq_f64(va, vb)); break;
+    case ColumnOp::Divide: F64_LOOP(vdivq_f64(va, vb)); break;
+    // vminq_f64/vmaxq_f64 遇到 NaN 返回 NaN，改用比较加选择，与标量和 AVX2 的语义一致
+    case ColumnOp::Min: F64_LOOP(vbslq_f64(vcltq_f64(va, vb), va, vb)); break;
+    case ColumnOp::Max: F64_LOOP(vbslq_f64(vcgtq_f64(va, vb), va, vb)); break;
+    default: break;
+    }
+    binaryF64Scalar(op, a + i, b + i, out + i, n - i);
+}
+
+void compareF64Neon(ColumnOp op, const double* a, const double* b, qint64* out, size_t n)
+{
+    size_t i = 0;
+    const uint64x2_t ones = vdupq_n_u64(~0ULL);
+    switch (op) {
+    case ColumnOp::Less: MASK_LOOP(vld1q_f64, float64x2_t, vcltq_f64(va, vb)); break;
+    case ColumnOp::LessEqual: MASK_LOOP(vld1q_f64, float64x2_t, vcleq_f64(va, vb)); break;
+    case ColumnOp::Greater: MASK_LOOP(vld1q_f64, float64x2_t, vcgtq_f64(va, vb)); break;
+    case ColumnOp::GreaterEqual: MASK_LOOP(vld1q_f64, float64x2_t, vcgeq_f64(va, vb)); break;
+    case ColumnOp::Equal: MASK_LOOP(vld1q_f64, float64x2_t, vceqq_f64(va, vb)); break;
+    case ColumnOp::NotEqual: MASK_LOOP(vld1q_f64, float64x2_t, veorq_u64(vceqq_f64(va, vb), ones)); break;
+    default: break;
+    }
+    compareF64Scalar(op, a + i, b + i, out + i, n - i);
+}
+
+void binaryI64Neon(ColumnOp op, const qint64* a, const qint64* b, qint64* out, size_t n)
+{
+    size_t i = 0;
+    switch (op) {
+    case ColumnOp::Add: I64_LOOP(vaddq_s64(va, vb)); break;
+    case ColumnOp::Subtract: I64_LOOP(vsubq_s64(va, vb)); break;
+    case ColumnOp::Min: I64_LOOP(vbslq_s64(vcgtq_s64(va, vb), vb, va)); break;
+    case ColumnOp::Max: I64_LOOP(vbslq_s64(vcgtq_s64(va, vb), va, vb)); break;
+    default: break;
+    }
+    binaryI64Scalar(op, a + i, b + i, out + i, n - i);
+}
+
+void compareI64Neon(ColumnOp op, const qint64* a, const qint64* b, qint64* out, size_t n)
+{
+    size_t i = 0;
+    const uint64x2_t ones = vdupq_n_u64(~0ULL);
+    switch (op) {
+    case ColumnOp::Less: MASK_LOOP(LOAD_I64, int64x2_t, vcltq_s64(va, vb)); break;
+    case ColumnOp::LessEqual: MASK_LOOP(LOAD_I64, int64x2_t, vcleq_s64(va, vb)); break;
+    case ColumnOp::Greater: MASK_LOOP(LOAD_I64, int64x2_t, vcgtq_s64(va, vb)); break;
+    case ColumnOp::GreaterEqual: MASK_LOOP(LOAD_I64, int64x2_t, vcgeq_s64(va, vb)); break;
+    case ColumnOp::Equal: MASK_LOOP(LOAD_I64, int64x2_t, vceqq_s64(va, vb)); break;
+    case ColumnOp::NotEqual: MASK_LOOP(LOAD_I64, int64x2_t, veorq_u64(vceqq_s64(va, vb), ones)); break;
+    default: break;
+    }
+    compareI64Scalar(op, a + i, b + i, out + i, n - i);
+}
+
+#  undef F64_LOOP
+#  undef MASK_LOOP
+#  undef I64_LOOP
+#  undef LOAD_I64
+
+#endif
+
+// ---- 按运行时可用的指令集分派 ----
+
+void binaryF64(ColumnOp op, const double* a, const double* b, double* out, size_t n)
+{
+#if defined(NODEEDITOR_COLUMN_AVX2)
+    if (g_simdEnabled && hasAvx2()) return binaryF64Avx2(op, a, b, out, n);
+#elif defined(NODEEDITOR_COLUMN_NEON)
+    if (g_simdEnabled) return binaryF64Neon(op, a, b, out, n);
+#endif
+    binaryF64Scalar(op, a, b, out, n);
+}
+
+void compareF64(ColumnOp op, const double* a, const double* b, qint64* out, size_t n)
+{
+#if defined(NODEEDITOR_COLUMN_AVX2)
+    if (g_simdEnabled && hasAvx2()) return compareF64Avx2(op, a, b, out, n);
+#elif defined(NODEEDITOR_COLUMN_NEON)
+    if (g_simdEnabled) return compareF64Neon(op, a, b, out, n);
+#endif
+    compareF64Scalar(op, a, b, out, n);
+}
+
+void binaryI64(ColumnOp op, const qint64* a, const qint64* b, qint64* out, size_t n)
+{
+#if defined(NODEEDITOR_COLUMN_AVX2)
+    if (g_simdEnabled && hasAvx2()) return binaryI64Avx2(op, a, b, out, n);
+#elif defined(NODEEDITOR_COLUMN_NEON)
+    if (g_simdEnabled) return binaryI64Neon(op, a, b, out, n);
+#endif
+    binaryI64Scalar(op, a, b, out, n);
+}
+
+void compareI64(ColumnOp op, const qint64* a, const qint64* b, qint64* out, size_t n)
+{
+#if defined(NODEEDITOR_COLUMN_AVX2)
+    if (g_simdEnabled && hasAvx2()) return compareI64Avx2(op, a, b, out, n);
+#elif defined(NODEEDITOR_COLUMN_NEON)
+    if (g_simdEnabled) return compareI64Neon(op, a, b, out, n);
+#endif
+    compareI64Scalar(op, a, b, out, n);
+}
+
+// ---- 操作数：列或广播的标量 ----
+
+struct Operand
+{
+    const SharedBuffer* column = nullptr;
+    const NodeValue* scalar = nullptr;
+
+    bool isInt() const
+    {
+        if (column) return ColumnKernels::columnType(*column) == ColumnType::Int64;
+        NodeValue::Kind kind = scalar->kind();
+        return kind == NodeValue::Kind::Int || kind == NodeValue::Kind::Bool || kind == NodeValue::Kind::Empty;
+    }
+};
+
+Operand makeOperand(const NodeValue& value)
+{
+    Operand operand;
+    if (ColumnKernels::isColumn(value)) {
+        operand.column = value.bufferIf();
+    } else {
+        operand.scalar = &value;
+    }
+    return operand;
+}
+
+// 返回 f64 数据：f64 列直接引用，i64 列转换，标量广播；转换结果存入 storage
+const double* asFloat64(const Operand& operand, size_t rows, SharedBuffer& storage)
+{
+    if (operand.column && ColumnKernels::columnType(*operand.column) == ColumnType::Float64) {
+        return reinterpret_cast<const double*>(operand.column->data());
+    }
+
+    storage = ColumnKernels::makeColumn(ColumnType::Float64, rows);
+    double* data = reinterpret_cast<double*>(storage.mutableData());
+    if (operand.column) {
+        const qint64* source = reinterpret_cast<const qint64*>(operand.column->data());
+        for (size_t i = 0; i < rows; ++i) data[i] = static_cast<double>(source[i]);
+    } else {
+        std::fill(data, data + rows, operand.scalar->toDouble());
+    }
+    return data;
+}
+
+const qint64* asInt64(const Operand& operand, size_t rows, SharedBuffer& storage)
+{
+    if (operand.column) {
+        return reinterpret_cast<const qint64*>(operand.column->data());
+    }
+
+    storage = ColumnKernels::makeColumn(ColumnType::Int64, rows);
+    qint64* data = reinterpret_cast<qint64*>(storage.mutableData());
+    std::fill(data, data + rows, operand.scalar->toInt());
+    return data;
+}
+
+// 把一段记录打包成列：全部为整数时为 i64，否则为 f64
+SharedBuffer packColumn(const RecordBatch& records, size_t begin, size_t count)
+{
+    bool allInt = true;
+    for (size_t i = 0; i < count && allInt; ++i) {
+        NodeValue::Kind kind = records[begin + i].kind();
+        allInt = kind == NodeValue::Kind::Int || kind == NodeValue::Kind::Bool;
+    }
+
+    if (allInt) {
+        SharedBuffer column = ColumnKernels::makeColumn(ColumnType::Int64, count);
+        qint64* data = reinterpret_cast<qint64*>(column.mutableData());
+        for (size_t i = 0; i < count; ++i) data[i] = records[begin + i].toInt();
+        return column;
+    }
+
+    SharedBuffer column = ColumnKernels::makeColumn(ColumnType::Float64, count);
+    double* data = reinterpret_cast<double*>(column.mutableData());
+    for (size_t i = 0; i < count; ++i) data[i] = records[begin + i].toDouble();
+    return column;
+}
+
+void unpackColumn(const SharedBuffer& column, RecordBatch& records, size_t begin, size_t count)
+{
+    if (!ColumnKernels::isColumn(column) || ColumnKernels::columnRows(column) != count) {
+        throw std::runtime_error("列内核返回的结果列长度不正确");
+    }
+
+    if (ColumnKernels::columnType(column) == ColumnType::Int64) {
+        const qint64* data = reinterpret_cast<const qint64*>(column.data());
+        for (size_t i = 0; i < count; ++i) records[begin + i] = NodeValue(data[i]);
+    } else {
+        const double* data = reinterpret_cast<const double*>(column.data());
+        for (size_t i = 0; i < count; ++i) records[begin + i] = NodeValue(data[i]);
+    }
+}
+
+} // namespace
+
+namespace ColumnKernels {
+
+SharedBuffer makeColumn(ColumnType type, size_t rows)
+{
+    return SharedBuffer::allocate(rows * 8, type == ColumnType::Int64 ? Int64Format : Float64Format,
+                                  {static_cast<qint64>(rows)});
+}
+
+bool isColumn(const SharedBuffer& buffer)
+{
+    return !buffer.isNull() && (buffer.format() == Float64Format || buffer.format() == Int64Format);
+}
+
+bool isColumn(const NodeValue& value)
+{
+    const SharedBuffer* buffer = value.bufferIf();
+    return buffer && isColumn(*buffer);
+}
+
+ColumnType columnType(const SharedBuffer& buffer)
+{
+    return buffer.format() == Int64Format ? ColumnType::Int64 : ColumnType::Float64;
+}
+
+size_t columnRows(const SharedBuffer& buffer)
+{
+    return buffer.size() / 8;
+}
+
+void setSimdEnabled(bool enabled)
+{
+    g_simdEnabled = enabled;
+}
+
+QString simdBackend()
+{
+#if defined(NODEEDITOR_COLUMN_AVX2)
+    if (g_simdEnabled && hasAvx2()) return QStringLiteral("avx2");
+#elif defined(NODEEDITOR_COLUMN_NEON)
+    if (g_simdEnabled) return QStringLiteral("neon");
+#endif
+    return QStringLiteral("scalar");
+}
+
+ColumnKernel binary(ColumnOp op)
+{
+    return [op](NodeId, const NodeInputs& inputs) -> SharedBuffer {
+        const Operand lhs = makeOperand(inputs[0]);
+        const Operand rhs = makeOperand(inputs[1]);
+
+        size_t rows = 1;
+        if (lhs.column && rhs.column && columnRows(*lhs.column) != columnRows(*rhs.column)) {
+            throw std::runtime_error("列长度不一致");
+        }
+        if (lhs.column) rows = columnRows(*lhs.column);
+        else if (rhs.column) rows = columnRows(*rhs.column);
+
+        SharedBuffer lhsStorage;
+        SharedBuffer rhsStorage;
+
+        // 两侧都是整数且不是除法时按 i64 计算，否则按 f64 计算
+        if (lhs.isInt() && rhs.isInt() && op != ColumnOp::Divide) {
+            const qint64* a = asInt64(lhs, rows, lhsStorage);
+            const qint64* b = asInt64(rhs, rows, rhsStorage);
+            SharedBuffer result = makeColumn(ColumnType::Int64, rows);
+            qint64* out = reinterpret_cast<qint64*>(result.mutableData());
+            if (isCompare(op)) compareI64(op, a, b, out, rows);
+            else binaryI64(op, a, b, out, rows);
+            return result;
+        }
+
+        const double* a = asFloat64(lhs, rows, lhsStorage);
+        const double* b = asFloat64(rhs, rows, rhsStorage);
+        if (isCompare(op)) {
+            SharedBuffer result = makeColumn(ColumnType::Int64, rows);
+            compareF64(op, a, b, reinterpret_cast<qint64*>(result.mutableData()), rows);
+            return result;
+        }
+        SharedBuffer result = makeColumn(ColumnType::Float64, rows);
+        binaryF64(op, a, b, reinterpret_cast<double*>(result.mutableData()), rows);
+        return result;
+    };
+}
+
+TypedNodeExecutor toNodeExecutor(ColumnKernel kernel, TypedNodeExecutor fallback)
+{
+    return [kernel, fallback](NodeId nodeId, const NodeInputs& inputs) -> NodeValue {
+        size_t rows = 0;
+        bool allColumns = true;
+        for (PortIndex port = 0; port < inputs.size(); ++port) {
+            if (!inputs.has(port)) continue;
+            if (isColumn(inputs[port])) {
+                if (rows == 0) rows = columnRows(*inputs[port].bufferIf());
+            } else {
+                allColumns = false;
+            }
+        }
+
+        if (rows > 0 && allColumns) {
+            return NodeValue(kernel(nodeId, inputs));
+        }
+        if (fallback) {
+            return fallback(nodeId, inputs);
+        }
+
+        // 标量（或列与标量混合）：把标量扩展为列后调用内核，全为标量时结果取第一行
+        const bool scalarResult = (rows == 0);
+        if (scalarResult) rows = 1;
+
+        std::vector<NodeValue> columns(inputs.size());
+        std::vector<const NodeValue*> pointers(inputs.size(), nullptr);
+        for (PortIndex port = 0; port < inputs.size(); ++port) {
+            if (!inputs.has(port)) continue;
+            if (isColumn(inputs[port])) {
+                pointers[port] = &inputs[port];
+                continue;
+            }
+            RecordBatch broadcast(rows, inputs[port]);
+            columns[port] = NodeValue(packColumn(broadcast, 0, rows));
+            pointers[port] = &columns[port];
+        }
+
+        SharedBuffer result = kernel(nodeId, NodeInputs(pointers.data(), pointers.size()));
+        if (!scalarResult) {
+            return NodeValue(result);
+        }
+
+        RecordBatch single(1);
+        unpackColumn(result, single, 0, 1);
+        return single[0];
+    };
+}
+
+BatchNodeExecutor toBatchExecutor(ColumnKernel kernel)
+{
+    return [kernel](NodeId nodeId, const BatchInputs& inputs, RecordBatch& outputs) {
+        const size_t rows = inputs.rowCount();
+        outputs.resize(rows);
+
+        std::vector<NodeValue> columns(inputs.size());
+        std::vector<const NodeValue*> pointers(inputs.size(), nullptr);
+        for (size_t begin = 0; begin < rows; begin += ChunkRows) {
+            const size_t count = std::min(ChunkRows, rows - begin);
+            for (PortIndex port = 0; port < inputs.size(); ++port) {
+                const RecordBatch* column = inputs.column(port);
+                if (!column) continue;
+                columns[port] = NodeValue(packColumn(*column, begin, count));
+                pointers[port] = &columns[port];
+            }
+            unpackColumn(kernel(nodeId, NodeInputs(pointers.data(), pointers.size())), outputs, begin, count);
+        }
+    };
+}
+
+} // namespace ColumnKernels
\ No newline at end of file
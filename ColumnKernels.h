@@ -0,0 +1,68 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_COLUMNKERNELS_H
+#define NODEEDITORDEMO_COLUMNKERNELS_H
+
+#include "NodeValue.h"
+#include "SharedBuffer.h"
+#include "StreamExecutor.h"
+#include <QString>
+#include <functional>
+
+// 列式数据块：格式为 "f64"/"i64" 的 SharedBuffer，连续存放 double 或 qint64，64 字节对齐
+enum class ColumnType
+{
+    Float64,
+    Int64
+};
+
+// 列内核：所有已连接的输入都是等长的列，返回结果列
+// 引擎对每个数据块调用一次，而不是对每个值调用一次
+using ColumnKernel = std::function<SharedBuffer(NodeId, const NodeInputs& columns)>;
+
+// 内置的逐元素运算
+enum class ColumnOp
+{
+    Add,
+    Subtract,
+    Multiply,
+    Divide,     // 结果总是 f64
+    Min,
+    Max,
+    Less,       // 比较运算的结果为 i64 列，取值 0/1
+    LessEqual,
+    Greater,
+    GreaterEqual,
+    Equal,
+    NotEqual
+};
+
+namespace ColumnKernels {
+
+// 流式执行时把记录打包成列的块大小
+constexpr size_t ChunkRows = DefaultBatchRows;
+
+SharedBuffer makeColumn(ColumnType type, size_t rows);
+bool isColumn(const SharedBuffer& buffer);
+bool isColumn(const NodeValue& value);
+ColumnType columnType(const SharedBuffer& buffer);
+size_t columnRows(const SharedBuffer& buffer);
+
+// 内置二元运算内核：AVX2（x86-64，运行时检测）/ NEON（AArch64），否则为标量实现；
+// 某个输入为数值标量时按广播处理
+ColumnKernel binary(ColumnOp op);
+// 当前使用的向量指令集："avx2"、"neon" 或 "scalar"
+QString simdBackend();
+// 关闭后强制使用标量实现（用于基准对比）
+void setSimdEnabled(bool enabled);
+
+// 适配为普通执行器：输入全部为列时调用内核；否则调用 fallback，没有 fallback 时按单行列计算
+TypedNodeExecutor toNodeExecutor(ColumnKernel kernel, TypedNodeExecutor fallback = TypedNodeExecutor());
+// 适配为流式批量执行器：每 ChunkRows 条记录打包成一列调用一次内核，再拆回记录
+BatchNodeExecutor toBatchExecutor(ColumnKernel kernel);
+
+} // namespace ColumnKernels
+
+#endif // NODEEDITORDEMO_COLUMNKERNELS_H
\ No newline at end of file
@@ -0,0 +1,215 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "DistributedExecutor.h"
+#include "Logging.h"
+#include "WorkerProtocol.h"
+#include <QDateTime>
+#include <QEventLoop>
+#include <QJsonDocument>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QVector>
+#include <algorithm>
+
+namespace {
+
+constexpr int ConnectTimeoutMs = 3000;
+
+} // namespace
+
+DistributedExecutor::DistributedExecutor(const QStringList& daemons, QObject* parent)
+    : QObject(parent)
+    , m_daemons(daemons)
+    , m_token(WorkerProtocol::daemonToken())
+    , m_sockets(daemons.size(), nullptr)
+    , m_buffers(daemons.size())
+{
+}
+
+DistributedExecutor::~DistributedExecutor() = default;
+
+bool DistributedExecutor::connectDaemons(QString* error)
+{
+    for (int index = 0; index < m_daemons.size(); ++index) {
+        QTcpSocket*& socket = m_sockets[index];
+        if (socket && socket->state() == QAbstractSocket::ConnectedState) continue;
+        if (socket) socket->deleteLater();
+
+        const QString& address = m_daemons[index];
+        const int colon = address.lastIndexOf(':');
+        socket = new QTcpSocket(this);
+        socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        socket->connectToHost(address.left(colon), address.mid(colon + 1).toUShort());
+        if (!socket->waitForConnected(ConnectTimeoutMs)) {
+            if (error) *error = QString("无法连接守护进程 %1: %2").arg(address).arg(socket->errorString());
+            socket->deleteLater();
+            socket = nullptr;
+            return false;
+        }
+
+        WorkerProtocol::writeAuthenticate(socket, m_token);
+        m_buffers[index].clear();
+        connect(socket, &QTcpSocket::readyRead, this, [this, index]() { onReadyRead(index); });
+        connect(socket, &QTcpSocket::disconnected, this, [this, index]() {
+            fail(QString("守护进程 %1 断开连接").arg(m_daemons[index]));
+        });
+    }
+    return true;
+}
+
+bool DistributedExecutor::run(ExecutionContext& context, const QJsonObject& scene,
+                              const GraphPartitioner::OutputWeight& outputWeight, QString* error)
+{
+    if (m_daemons.isEmpty()) {
+        if (error) *error = "没有配置守护进程";
+        return false;
+    }
+    if (!connectDaemons(error)) {
+        return false;
+    }
+
+    const GraphSnapshot& graph = context.graph();
+    const int nodeCount = context.nodeCount();
+    m_partition = GraphPartitioner::partition(graph, context.order, m_daemons.size(), outputWeight);
+    qCDebug(lcExec) << "分布式执行: 划分为" << m_partition.partCount << "个子图，割边数据量估计" << m_partition.cutWeight;
+
+    // 轮次单调递增，守护进程据此识别先于分配到达的远程结果
+    m_runId = std::max(m_lastRunId + 1, static_cast<quint64>(QDateTime::currentMSecsSinceEpoch()) << 10);
+    m_lastRunId = m_runId;
+    m_context = &context;
+    m_remaining = nodeCount;
+    m_failed = false;
+    m_error.clear();
+
+    std::vector<char> releasable(nodeCount, 0);
+    for (int slot : context.releaseSlots) {
+        releasable[slot] = 1;
+    }
+
+    const QByteArray sceneJson = QJsonDocument(scene).toJson(QJsonDocument::Compact);
+    for (int part = 0; part < m_partition.partCount; ++part) {
+        QVector<qint64> localNodes;
+        QVector<qint64> reportNodes;
+        std::vector<std::pair<qint64, QStringList>> routes;
+        for (int slot : m_partition.slotsOf(part)) {
+            const NodeId nodeId = context.nodeId(slot);
+            localNodes.append(nodeId);
+            if (!releasable[slot]) {
+                reportNodes.append(nodeId);
+            }
+
+            QStringList peers;
+            for (const GraphEdge* edge = graph.outBegin(slot); edge != graph.outEnd(slot); ++edge) {
+                const int consumerPart = m_partition.partOf[edge->node];
+                if (consumerPart != part && !peers.contains(m_daemons[consumerPart])) {
+                    peers.append(m_daemons[consumerPart]);
+                }
+            }
+            if (!peers.isEmpty()) {
+                routes.emplace_back(nodeId, peers);
+            }
+        }
+
+        QByteArray payload;
+        QDataStream stream(&payload, QIODevice::WriteOnly);
+        stream.setVersion(WorkerProtocol::StreamVersion);
+        stream << quint8(WorkerProtocol::AssignPartition) << m_runId << sceneJson << localNodes
+               << quint32(routes.size());
+        for (const auto& route : routes) {
+            stream << route.first << route.second;
+        }
+        stream << reportNodes;
+        WorkerProtocol::writeFrame(m_sockets[part], payload);
+    }
+
+    if (m_remaining > 0 && !m_failed) {
+        QEventLoop loop;
+        QTimer timeout;
+        if (m_runTimeoutMs > 0) {
+            timeout.setSingleShot(true);
+            connect(&timeout, &QTimer::timeout, this, [this]() { fail("分布式执行超时"); });
+            timeout.start(m_runTimeoutMs);
+        }
+        m_loop = &loop;
+        loop.exec(QEventLoop::ExcludeUserInputEvents);
+        m_loop = nullptr;
+    }
+
+    const bool success = !m_failed && m_remaining == 0;
+    if (!success && error) {
+        *error = m_error;
+    }
+    m_context = nullptr;
+    return success;
+}
+
+void DistributedExecutor::onReadyRead(int index)
+{
+    m_buffers[index].append(m_sockets[index]->readAll());
+
+    QByteArray frame;
+    while (WorkerProtocol::takeFrame(m_buffers[index], frame)) {
+        handleFrame(frame);
+    }
+}
+
+void DistributedExecutor::handleFrame(const QByteArray& frame)
+{
+    QDataStream stream(frame);
+    stream.setVersion(WorkerProtocol::StreamVersion);
+    quint8 type = 0;
+    quint64 runId = 0;
+    qint64 nodeId = 0;
+    bool ok = false;
+    stream >> type;
+    if (type == WorkerProtocol::SceneError) {
+        // 守护进程无法加载场景，它负责的分区不会执行
+        QString error;
+        stream >> runId >> error;
+        if (m_context && runId == m_runId) {
+            fail(QString("守护进程加载场景失败: %1").arg(error));
+        }
+        return;
+    }
+    if (type != WorkerProtocol::NodeFinished) {
+        qCWarning(lcExec) << "编辑器收到未知消息:" << type;
+        return;
+    }
+    stream >> runId >> nodeId >> ok;
+    // 失败或超时后，上一轮仍在执行的节点陆续报告，直接忽略
+    if (!m_context || runId != m_runId || m_failed) return;
+
+    const int slot = m_context->slotOf(static_cast<NodeId>(nodeId));
+    if (slot == ExecutionContext::InvalidSlot) return;
+
+    if (!ok) {
+        QString error;
+        stream >> error;
+        fail(QString("节点 %1 执行失败: %2").arg(nodeId).arg(error));
+        return;
+    }
+
+    try {
+        m_context->results[slot] = WorkerProtocol::readValue(stream);
+    } catch (const std::exception& e) {
+        fail(QString("节点 %1 的结果无法读取: %2").arg(nodeId).arg(e.what()));
+        return;
+    }
+
+    emit nodeFinished(static_cast<NodeId>(nodeId));
+    if (--m_remaining == 0 && m_loop) {
+        m_loop->quit();
+    }
+}
+
+void DistributedExecutor::fail(const QString& error)
+{
+    if (m_failed || !m_context) return;
+    m_failed = true;
+    m_error = error;
+    if (m_loop) {
+        m_loop->quit();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_DISTRIBUTEDEXECUTOR_H
+#define NODEEDITORDEMO_DISTRIBUTEDEXECUTOR_H
+
+#include "ExecutionContext.h"
+#include "GraphPartitioner.h"
+#include <QByteArray>
+#include <QJsonObject>
+#include <QObject>
+#include <QStringList>
+#include <vector>
+
+class QEventLoop;
+class QTcpSocket;
+
+// 分布式执行：把执行图划分为与守护进程数量相同的子图（GraphPartitioner，割边数据量最小），
+// 通过 TCP 发给各 ExecutorDaemon。中间结果在守护进程之间直接流动，
+// 编辑器只收到完成通知以及汇点和被固定节点的结果。
+class DistributedExecutor : public QObject
+{
+    Q_OBJECT
+
+public:
+    // daemons 为 "主机:端口" 列表，例如 {"127.0.0.1:7301", "127.0.0.1:7302"}
+    explicit DistributedExecutor(const QStringList& daemons, QObject* parent = nullptr);
+    ~DistributedExecutor();
+
+    const QStringList& daemons() const { return m_daemons; }
+    // 整轮执行的最长时间；<= 0 表示不限制
+    void setRunTimeout(int milliseconds) { m_runTimeoutMs = milliseconds; }
+    // 连接守护进程时发送的共享令牌，默认取环境变量 NODEEDITOR_DAEMON_TOKEN
+    void setToken(const QByteArray& token) { m_token = token; }
+    const GraphPartition& lastPartition() const { return m_partition; }
+
+    // 阻塞执行一轮（局部事件循环，排除用户输入）。结果写入 context.results，
+    // 只有汇点和被固定的节点有值，其余中间结果留在守护进程中并在用完后释放
+    bool run(ExecutionContext& context, const QJsonObject& scene,
+             const GraphPartitioner::OutputWeight& outputWeight, QString* error = nullptr);
+
+signals:
+    void nodeFinished(NodeId nodeId);
+
+private:
+    bool connectDaemons(QString* error);
+    void onReadyRead(int index);
+    void handleFrame(const QByteArray& frame);
+    void fail(const QString& error);
+
+private:
+    QStringList m_daemons;
+    QByteArray m_token;
+    std::vector<QTcpSocket*> m_sockets;
+    std::vector<QByteArray> m_buffers;
+    int m_runTimeoutMs = 300000;
+    quint64 m_lastRunId = 0;
+    GraphPartition m_partition;
+
+    // 单轮执行状态
+    ExecutionContext* m_context = nullptr;
+    quint64 m_runId = 0;
+    int m_remaining = 0;
+    bool m_failed = false;
+    QString m_error;
+    QEventLoop* m_loop = nullptr;
+};
+
+#endif // NODEEDITORDEMO_DISTRIBUTEDEXECUTOR_H
\ No newline at end of file
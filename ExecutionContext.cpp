@@ -0,0 +1,153 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "ExecutionContext.h"
+#include <algorithm>
+
+bool ExecutionContext::build(std::shared_ptr<const GraphSnapshot> snapshot,
+                             const NodeExecutorTable& executors,
+                             const QSet<NodeId>& pinnedResults,
+                             bool releaseIntermediateResults,
+                             const FusableResolverTable& fusableNodes,
+                             const NodeExecutorBinderTable& binders,
+                             const NodeStateLookup& stateOf)
+{
+    // 保留上一次执行的结果，重建后按 NodeId 迁移
+    m_previousSnapshot = std::move(m_snapshot);
+    m_previousResults.swap(results);
+    m_snapshot = std::move(snapshot);
+
+    const GraphSnapshot& graph = *m_snapshot;
+    const int n = graph.nodeCount();
+
+    // 1. 执行器与输入表分段；需要绑定或解析运算的节点读取一次状态
+    const bool fuse = releaseIntermediateResults && !fusableNodes.isEmpty();
+    const bool bind = stateOf && (!binders.isEmpty() || fuse);
+    std::vector<FusableOp> slotOps;
+    if (fuse) {
+        slotOps.assign(n, FusableOp::None);
+    }
+    slotExecutor.assign(n, nullptr);
+    inputBase.assign(n + 1, 0);
+    boundExecutors.clear();
+    if (bind) {
+        // 按绑定数量预留容量，push_back 不会重新分配，slotExecutor 中的指针保持有效
+        int boundCount = 0;
+        for (int slot = 0; slot < n; ++slot) {
+            if (binders.find(graph.nodeTypeId(slot))) {
+                ++boundCount;
+            }
+        }
+        boundExecutors.reserve(boundCount);
+    }
+    for (int slot = 0; slot < n; ++slot) {
+        inputBase[slot + 1] = inputBase[slot] + static_cast<int>(graph.inPortCount(slot));
+        const NodeTypeId typeId = graph.nodeTypeId(slot);
+        slotExecutor[slot] = executors.find(typeId);
+        if (!bind) continue;
+
+        const NodeExecutorBinder* binder = binders.find(typeId);
+        const FusableResolver* resolver = fuse ? fusableNodes.find(typeId) : nullptr;
+        if (!binder && !resolver) continue;
+
+        const QJsonObject state = stateOf(graph.nodeId(slot));
+        if (binder) {
+            boundExecutors.push_back((*binder)(state));
+            slotExecutor[slot] = &boundExecutors.back();
+        }
+        if (resolver) {
+            slotOps[slot] = (*resolver)(state);
+        }
+    }
+
+    // 2. 拓扑排序
+    bool acyclic = graph.topologicalOrder(order, m_scratch);
+
+    // 3. 结果与输入指针表：results 在两次 build 之间不再改变大小，指针保持有效
+    results.clear();
+    results.resize(n);
+    if (acyclic && m_previousSnapshot) {
+        for (size_t i = 0; i < m_previousResults.size(); ++i) {
+            int slot = graph.slotOf(m_previousSnapshot->nodeId(static_cast<int>(i)));
+            if (slot != InvalidSlot) {
+                results[slot] = std::move(m_previousResults[i]);
+            }
+        }
+    }
+    m_previousSnapshot.reset();
+    m_previousResults.clear();
+
+    finishNs.assign(n, 0);
+    inputPointers.assign(inputBase[n], nullptr);
+    for (int slot = 0; slot < n; ++slot) {
+        for (const GraphEdge* edge = graph.inBegin(slot); edge != graph.inEnd(slot); ++edge) {
+            if (edge->port < graph.inPortCount(slot)) {
+                inputPointers[inputBase[slot] + edge->port] = &results[edge->node];
+            }
+        }
+    }
+
+    releaseOffset.assign(n + 1, 0);
+    releaseSlots.clear();
+
+    fusion.clear();
+    if (!acyclic) {
+        order.clear();
+        return false;
+    }
+
+    // 4. 表达式融合：需要释放中间结果，否则所有结果都视为被观察
+    if (fuse && bind) {
+        fusion.build(graph, order, slotOps, pinnedResults, results);
+    }
+
+    // 5. 结果生命周期：最后一个消费者执行完即可释放；汇点和固定节点保留
+    // 融合组的成员按根节点的位置计算，它们的输入要保留到融合内核执行时
+    if (releaseIntermediateResults) {
+        m_position.assign(n, 0);
+        for (int position = 0; position < n; ++position) {
+            m_position[order[position]] = position;
+        }
+        if (!fusion.isEmpty()) {
+            for (int slot = 0; slot < n; ++slot) {
+                const int root = fusion.rootOf(slot);
+                if (root != InvalidSlot) {
+                    m_position[slot] = m_position[root];
+                }
+            }
+        }
+
+        m_lastUse.assign(n, -1);
+        for (int slot = 0; slot < n; ++slot) {
+            if (pinnedResults.contains(graph.nodeId(slot))) continue;
+            for (const GraphEdge* edge = graph.outBegin(slot); edge != graph.outEnd(slot); ++edge) {
+                m_lastUse[slot] = std::max(m_lastUse[slot], m_position[edge->node]);
+            }
+            if (m_lastUse[slot] >= 0) {
+                ++releaseOffset[m_lastUse[slot] + 1];
+            }
+        }
+        for (int position = 0; position < n; ++position) {
+            releaseOffset[position + 1] += releaseOffset[position];
+        }
+
+        releaseSlots.assign(releaseOffset[n], 0);
+        m_scratch.assign(releaseOffset.begin(), releaseOffset.end() - 1);
+        for (int slot = 0; slot < n; ++slot) {
+            if (m_lastUse[slot] >= 0) {
+                releaseSlots[m_scratch[m_lastUse[slot]]++] = slot;
+            }
+        }
+    }
+
+    return true;
+}
+
+void ExecutionContext::resetRun()
+{
+    for (NodeValue& value : results) {
+        value.reset();
+    }
+    std::fill(finishNs.begin(), finishNs.end(), 0);
+}
\ No newline at end of file
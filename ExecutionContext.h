@@ -0,0 +1,83 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_EXECUTIONCONTEXT_H
+#define NODEEDITORDEMO_EXECUTIONCONTEXT_H
+
+#include "ExpressionFusion.h"
+#include "GraphSnapshot.h"
+#include "NodeValue.h"
+#include <QSet>
+#include <QString>
+#include <memory>
+#include <vector>
+
+// 编译后的执行计划及执行期数据
+// 槽位与 GraphSnapshot 一致，执行顺序、输入表、结果都放在连续数组中。
+// 所有数组在多次执行之间复用容量（build 只在图结构变化后调用），
+// 图不变时重复执行不再产生引擎自身的堆分配。
+class ExecutionContext
+{
+public:
+    static constexpr int InvalidSlot = GraphSnapshot::InvalidSlot;
+
+    // 根据快照重建计划；返回 false 表示存在循环依赖
+    // fusableNodes 非空且释放中间结果时进行表达式融合（中间结果不保留，融合不改变可观察的结果）
+    // 有绑定器的类型按 stateOf 读取的节点状态生成执行器，结果保存在 boundExecutors 中；
+    // 融合的运算同样按节点状态解析
+    bool build(std::shared_ptr<const GraphSnapshot> snapshot,
+               const NodeExecutorTable& executors,
+               const QSet<NodeId>& pinnedResults,
+               bool releaseIntermediateResults,
+               const FusableResolverTable& fusableNodes = FusableResolverTable(),
+               const NodeExecutorBinderTable& binders = NodeExecutorBinderTable(),
+               const NodeStateLookup& stateOf = NodeStateLookup());
+
+    // 开始新一轮执行：清空结果，不释放容量
+    void resetRun();
+
+    const GraphSnapshot& graph() const { return *m_snapshot; }
+    int nodeCount() const { return m_snapshot ? m_snapshot->nodeCount() : 0; }
+    int slotOf(NodeId nodeId) const { return m_snapshot ? m_snapshot->slotOf(nodeId) : InvalidSlot; }
+    NodeId nodeId(int slot) const { return m_snapshot->nodeId(slot); }
+
+    NodeInputs inputsOf(int slot) const
+    {
+        return NodeInputs(inputPointers.data() + inputBase[slot], m_snapshot->inPortCount(slot));
+    }
+
+    // 按位置 position 执行完后可以释放的结果槽位
+    const int* releaseBegin(int position) const { return releaseSlots.data() + releaseOffset[position]; }
+    const int* releaseEnd(int position) const { return releaseSlots.data() + releaseOffset[position + 1]; }
+
+    std::vector<const TypedNodeExecutor*> slotExecutor; // 未注册时为 nullptr
+    std::vector<TypedNodeExecutor> boundExecutors;      // 按节点状态绑定的执行器，slotExecutor 指向其中的元素
+
+    // 执行顺序（槽位）以及每个位置执行后可释放的结果
+    std::vector<int> order;
+    std::vector<int> releaseOffset;
+    std::vector<int> releaseSlots;
+
+    // 执行期数据
+    std::vector<NodeValue> results;
+    std::vector<const NodeValue*> inputPointers;        // 指向 results 中上游结果，按 inputBase 分段
+    std::vector<int> inputBase;
+    std::vector<qint64> finishNs;
+
+    ExpressionFusion fusion;
+
+private:
+    std::shared_ptr<const GraphSnapshot> m_snapshot;
+
+    // 重建前的结果，按 NodeId 迁移到新的槽位
+    std::shared_ptr<const GraphSnapshot> m_previousSnapshot;
+    std::vector<NodeValue> m_previousResults;
+
+    // 构建期临时数组，同样复用容量
+    std::vector<int> m_scratch;
+    std::vector<int> m_lastUse;
+    std::vector<int> m_position;
+};
+
+#endif // NODEEDITORDEMO_EXECUTIONCONTEXT_H
\ No newline at end of file
@@ -0,0 +1,117 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "ExecutionOverlay.h"
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <algorithm>
+
+namespace {
+const qreal HaloMargin = 6.0;
+const qreal LabelHeight = 18.0;
+}
+
+ExecutionOverlay::ExecutionOverlay(DataFlowGraphModel& graphModel, QGraphicsItem* parent)
+    : QGraphicsObject(parent)
+    , m_graphModel(graphModel)
+{
+    setAcceptedMouseButtons(Qt::NoButton);
+    setAcceptHoverEvents(false);
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+    setZValue(1000);
+
+    // 批量移动、删除时每个节点都会通知一次，合并为一次重算
+    connect(&m_graphModel, &DataFlowGraphModel::nodePositionUpdated, this, [this](NodeId nodeId) {
+        if (isVisible() && m_wallNs.contains(nodeId)) {
+            scheduleRefresh();
+        }
+    });
+    connect(&m_graphModel, &DataFlowGraphModel::nodeDeleted, this, [this](NodeId nodeId) {
+        if (m_wallNs.remove(nodeId) > 0) {
+            scheduleRefresh();
+        }
+    });
+}
+
+void ExecutionOverlay::scheduleRefresh()
+{
+    if (m_refreshPending) return;
+    m_refreshPending = true;
+    QMetaObject::invokeMethod(this, &ExecutionOverlay::refreshGeometry, Qt::QueuedConnection);
+}
+
+void ExecutionOverlay::setNodeTimes(const QHash<NodeId, qint64>& wallNs)
+{
+    m_wallNs = wallNs;
+    m_maxWallNs = 0;
+    for (qint64 value : m_wallNs) {
+        m_maxWallNs = std::max(m_maxWallNs, value);
+    }
+    refreshGeometry();
+}
+
+void ExecutionOverlay::clear()
+{
+    setNodeTimes({});
+}
+
+QRectF ExecutionOverlay::nodeRect(NodeId nodeId) const
+{
+    QPointF pos = m_graphModel.nodeData(nodeId, NodeRole::Position).toPointF();
+    QSizeF size = m_graphModel.nodeData(nodeId, NodeRole::Size).toSize();
+    return QRectF(pos, size);
+}
+
+void ExecutionOverlay::refreshGeometry()
+{
+    m_refreshPending = false;
+    QRectF bounds;
+    for (auto it = m_wallNs.begin(); it != m_wallNs.end(); ++it) {
+        if (!m_graphModel.nodeExists(it.key())) continue;
+        bounds |= nodeRect(it.key()).adjusted(-HaloMargin, -HaloMargin - LabelHeight, HaloMargin, HaloMargin);
+    }
+
+    prepareGeometryChange();
+    m_bounds = bounds;
+    update();
+}
+
+QRectF ExecutionOverlay::boundingRect() const
+{
+    return m_bounds;
+}
+
+void ExecutionOverlay::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    Q_UNUSED(widget);
+
+    if (m_wallNs.isEmpty() || m_maxWallNs <= 0) return;
+
+    const QRectF exposed = option->exposedRect;
+    QFont font = painter->font();
+    font.setPointSizeF(8.0);
+    painter->setFont(font);
+
+    for (auto it = m_wallNs.begin(); it != m_wallNs.end(); ++it) {
+        if (!m_graphModel.nodeExists(it.key())) continue;
+
+        QRectF rect = nodeRect(it.key()).adjusted(-HaloMargin, -HaloMargin, HaloMargin, HaloMargin);
+        QRectF labelRect(rect.left(), rect.top() - LabelHeight, rect.width(), LabelHeight);
+        if (!exposed.intersects(rect) && !exposed.intersects(labelRect)) continue;
+
+        // 绿色（快）到红色（慢）
+        qreal heat = static_cast<qreal>(it.value()) / m_maxWallNs;
+        QColor color = QColor::fromHsvF((1.0 - heat) * 0.33, 0.85, 0.95);
+
+        QColor fill = color;
+        fill.setAlphaF(0.25);
+        painter->setPen(QPen(color, 3.0));
+        painter->setBrush(fill);
+        painter->drawRoundedRect(rect, 8.0, 8.0);
+
+        painter->setPen(color.darker(150));
+        painter->drawText(labelRect, Qt::AlignLeft | Qt::AlignBottom,
+                          QString("%1 ms").arg(it.value() / 1e6, 0, 'f', 3));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_EXECUTIONOVERLAY_H
+#define NODEEDITORDEMO_EXECUTIONOVERLAY_H
+
+#include <QtNodes/DataFlowGraphModel>
+#include <QGraphicsObject>
+#include <QHash>
+
+using namespace QtNodes;
+
+// 覆盖在所有节点之上的单个图元，用于显示每个节点的执行耗时热力图
+// 整个场景只有这一个图元，不为每个节点创建额外的 QGraphicsItem 或控件
+class ExecutionOverlay : public QGraphicsObject
+{
+    Q_OBJECT
+
+public:
+    explicit ExecutionOverlay(DataFlowGraphModel& graphModel, QGraphicsItem* parent = nullptr);
+
+    void setNodeTimes(const QHash<NodeId, qint64>& wallNs);
+    void clear();
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+
+public slots:
+    void refreshGeometry();
+
+private:
+    QRectF nodeRect(NodeId nodeId) const;
+    void scheduleRefresh();
+
+private:
+    DataFlowGraphModel& m_graphModel;
+    QHash<NodeId, qint64> m_wallNs;
+    qint64 m_maxWallNs = 0;
+    QRectF m_bounds;
+    bool m_refreshPending = false;
+};
+
+#endif // NODEEDITORDEMO_EXECUTIONOVERLAY_H
\ No newline at end of file
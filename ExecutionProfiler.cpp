@@ -0,0 +1,211 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "ExecutionProfiler.h"
+#include <QByteArray>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QSet>
+#include <QVariantList>
+#include <QVariantMap>
+#include <algorithm>
+#include <chrono>
+
+#ifdef Q_OS_WIN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+ExecutionProfiler::ExecutionProfiler(size_t capacity)
+    : m_buffer(std::max<size_t>(capacity, 1))
+{
+}
+
+void ExecutionProfiler::beginRun()
+{
+    m_writeIndex.store(0, std::memory_order_relaxed);
+    m_runWallNs = 0;
+    m_epochNs = clockNs();
+}
+
+void ExecutionProfiler::endRun()
+{
+    m_runWallNs = nowNs();
+}
+
+qint64 ExecutionProfiler::nowNs() const
+{
+    return toRunNs(clockNs());
+}
+
+qint64 ExecutionProfiler::clockNs()
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+qint64 ExecutionProfiler::threadCpuTimeNs()
+{
+#ifdef Q_OS_WIN
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+        return 0;
+    }
+    auto toTicks = [](const FILETIME& ft) {
+        return (static_cast<qint64>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+    };
+    // FILETIME 单位为 100ns
+    return (toTicks(kernelTime) + toTicks(userTime)) * 100;
+#else
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0;
+    }
+    return static_cast<qint64>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+#endif
+}
+
+quint32 ExecutionProfiler::currentThreadIndex()
+{
+    static std::atomic<quint32> nextIndex{0};
+    thread_local quint32 index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+qint64 ExecutionProfiler::estimateSize(const QVariant& value)
+{
+    switch (value.type()) {
+    case QVariant::Invalid:
+        return 0;
+    case QVariant::ByteArray:
+        return value.toByteArray().size();
+    case QVariant::String:
+        return value.toString().size() * static_cast<qint64>(sizeof(QChar));
+    case QVariant::List: {
+        qint64 total = 0;
+        const QVariantList list = value.toList();
+        for (const QVariant& item : list) {
+            total += estimateSize(item);
+        }
+        return total;
+    }
+    case QVariant::Map: {
+        qint64 total = 0;
+        const QVariantMap map = value.toMap();
+        for (auto it = map.begin(); it != map.end(); ++it) {
+            total += it.key().size() * static_cast<qint64>(sizeof(QChar)) + estimateSize(it.value());
+        }
+        return total;
+    }
+    default:
+        if (value.userType() == qMetaTypeId<SharedBuffer>()) {
+            return static_cast<qint64>(value.value<SharedBuffer>().size());
+        }
+        return static_cast<qint64>(sizeof(QVariant));
+    }
+}
+
+qint64 ExecutionProfiler::estimateSize(const NodeValue& value)
+{
+    switch (value.kind()) {
+    case NodeValue::Kind::Empty:
+        return 0;
+    case NodeValue::Kind::Buffer:
+        return static_cast<qint64>(value.bufferIf()->size());
+    case NodeValue::Kind::Variant:
+        return estimateSize(*value.variantIf());
+    default:
+        return static_cast<qint64>(sizeof(NodeValue));
+    }
+}
+
+void ExecutionProfiler::record(const NodeProfileSample& sample)
+{
+    quint64 index = m_writeIndex.fetch_add(1, std::memory_order_relaxed);
+    m_buffer[index % m_buffer.size()] = sample;
+}
+
+std::vector<NodeProfileSample> ExecutionProfiler::samples() const
+{
+    quint64 written = m_writeIndex.load(std::memory_order_acquire);
+    quint64 capacity = m_buffer.size();
+    quint64 count = std::min(written, capacity);
+
+    std::vector<NodeProfileSample> result;
+    result.reserve(static_cast<size_t>(count));
+    for (quint64 i = written - count; i < written; ++i) {
+        result.push_back(m_buffer[i % capacity]);
+    }
+    return result;
+}
+
+QHash<NodeId, qint64> ExecutionProfiler::wallTimeByNode() const
+{
+    QHash<NodeId, qint64> result;
+    for (const NodeProfileSample& sample : samples()) {
+        result[sample.nodeId] += sample.wallNs;
+    }
+    return result;
+}
+
+QHash<NodeId, qint64> ExecutionProfiler::outputBytesByNode() const
+{
+    QHash<NodeId, qint64> result;
+    for (const NodeProfileSample& sample : samples()) {
+        result[sample.nodeId] = sample.outputBytes;
+    }
+    return result;
+}
+
+QJsonDocument ExecutionProfiler::toChromeTrace() const
+{
+    QJsonArray events;
+    QSet<quint32> threads;
+
+    for (const NodeProfileSample& sample : samples()) {
+        QString name = m_nodeNames.value(sample.nodeId, "Node");
+
+        QJsonObject args;
+        args["nodeId"] = static_cast<qint64>(sample.nodeId);
+        args["cpu_ms"] = sample.cpuNs / 1e6;
+        args["queue_wait_ms"] = sample.queueWaitNs / 1e6;
+        args["input_bytes"] = sample.inputBytes;
+        args["output_bytes"] = sample.outputBytes;
+
+        QJsonObject event;
+        event["name"] = QString("%1 #%2").arg(name).arg(sample.nodeId);
+        event["cat"] = "node";
+        event["ph"] = "X";
+        event["ts"] = sample.startNs / 1e3;
+        event["dur"] = sample.wallNs / 1e3;
+        event["pid"] = 1;
+        event["tid"] = static_cast<qint64>(sample.threadIndex);
+        event["args"] = args;
+        events.append(event);
+
+        threads.insert(sample.threadIndex);
+    }
+
+    for (quint32 thread : threads) {
+        QJsonObject args;
+        args["name"] = QString("执行线程 %1").arg(thread);
+
+        QJsonObject meta;
+        meta["name"] = "thread_name";
+        meta["ph"] = "M";
+        meta["pid"] = 1;
+        meta["tid"] = static_cast<qint64>(thread);
+        meta["args"] = args;
+        events.append(meta);
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = events;
+    root["displayTimeUnit"] = "ms";
+    return QJsonDocument(root);
+}
\ No newline at end of file
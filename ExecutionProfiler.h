@@ -0,0 +1,80 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_EXECUTIONPROFILER_H
+#define NODEEDITORDEMO_EXECUTIONPROFILER_H
+
+#include <QtNodes/Definitions>
+#include "NodeValue.h"
+#include <QHash>
+#include <QJsonDocument>
+#include <QString>
+#include <QVariant>
+#include <atomic>
+#include <vector>
+
+using namespace QtNodes;
+
+// 单个节点一次执行的性能采样，时间均为相对本次运行开始的纳秒数
+struct NodeProfileSample
+{
+    NodeId nodeId = InvalidNodeId;
+    quint32 threadIndex = 0;
+    qint64 startNs = 0;
+    qint64 wallNs = 0;
+    qint64 cpuNs = 0;
+    qint64 queueWaitNs = 0;     // 节点就绪（所有上游完成）到开始执行的等待时间
+    qint64 inputBytes = 0;
+    qint64 outputBytes = 0;
+};
+
+// 节点执行性能分析器，默认关闭（每个节点的采样需要读取线程 CPU 时钟并估计输出大小）
+// 采样写入固定容量的环形缓冲区，记录时只有一次原子自增和一次拷贝，
+// 可在多个执行线程中同时调用 record()
+class ExecutionProfiler
+{
+public:
+    explicit ExecutionProfiler(size_t capacity = 1 << 16);
+
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    bool isEnabled() const { return m_enabled; }
+
+    // 导出时显示的节点名称，只在执行计划重建后更新
+    void setNodeNames(const QHash<NodeId, QString>& nodeNames) { m_nodeNames = nodeNames; }
+    // 开始新一轮运行：清空缓冲区并重置时间基准
+    void beginRun();
+    void endRun();
+
+    qint64 nowNs() const;
+    // 单调时钟的绝对读数，不依赖分析器实例，执行线程可以先读取、之后再换算成运行内时间
+    static qint64 clockNs();
+    qint64 toRunNs(qint64 clockNs) const { return clockNs - m_epochNs; }
+    static qint64 threadCpuTimeNs();
+    static quint32 currentThreadIndex();
+    static qint64 estimateSize(const QVariant& value);
+    static qint64 estimateSize(const NodeValue& value);
+
+    void record(const NodeProfileSample& sample);
+
+    // 按写入顺序返回缓冲区中仍保留的采样
+    std::vector<NodeProfileSample> samples() const;
+    // 最近一次运行中每个节点的累计墙钟时间
+    QHash<NodeId, qint64> wallTimeByNode() const;
+    // 最近一次运行中每个节点输出的数据量估计
+    QHash<NodeId, qint64> outputBytesByNode() const;
+    qint64 runWallNs() const { return m_runWallNs; }
+
+    // 导出为 Chrome trace-event 格式（chrome://tracing、Perfetto 可直接打开）
+    QJsonDocument toChromeTrace() const;
+
+private:
+    std::vector<NodeProfileSample> m_buffer;
+    std::atomic<quint64> m_writeIndex{0};
+    QHash<NodeId, QString> m_nodeNames;
+    qint64 m_epochNs = 0;
+    qint64 m_runWallNs = 0;
+    bool m_enabled = false;
+};
+
+#endif // NODEEDITORDEMO_EXECUTIONPROFILER_H
\ No newline at end of file
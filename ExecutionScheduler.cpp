@@ -0,0 +1,452 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "ExecutionScheduler.h"
+#include "ExecutionProfiler.h"
+#include "Logging.h"
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QThreadPool>
+#include <QWaitCondition>
+#include <QtConcurrent/QtConcurrentRun>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <deque>
+#include <memory>
+#include <queue>
+
+namespace {
+
+enum class SlotState : quint8
+{
+    Waiting,
+    Ready,
+    Running,
+    Done,
+    Failed,
+    Skipped
+};
+
+enum TaskState : int
+{
+    TaskRunning = 0,
+    TaskFinished,
+    TaskAbandoned
+};
+
+// 调度线程与执行线程之间的完成队列；被放弃的任务可能在调度结束后才返回，所以由任务共同持有
+struct CompletionQueue
+{
+    QMutex mutex;
+    QWaitCondition condition;
+    std::vector<int> finished;      // 任务下标
+};
+
+struct Task
+{
+    int slot = -1;
+    NodeId nodeId = InvalidNodeId;
+    TypedNodeExecutor executor;
+    std::vector<NodeValue> inputValues;
+    std::vector<const NodeValue*> inputPointers;
+    NodeValue result;
+    QString error;
+    bool ok = false;
+    qint64 wallNs = 0;
+    // 性能采样的原始读数，由调度线程换算并记录
+    quint32 threadIndex = 0;
+    qint64 startClockNs = 0;
+    qint64 cpuNs = 0;
+    qint64 deadlineMs = 0;          // 0 表示不限制
+    std::atomic<int> state{TaskRunning};
+};
+
+} // namespace
+
+ExecutionScheduler::ExecutionScheduler(ExecutionContext& context, const NodePolicyTable& policies,
+                                       QThreadPool& pool, std::shared_ptr<std::atomic<int>> abandonedTasks,
+                                       int maxParallel)
+    : m_context(context)
+    , m_policies(policies)
+    , m_pool(pool)
+    , m_abandonedTasks(std::move(abandonedTasks))
+    , m_maxParallel(std::max(1, maxParallel))
+{
+}
+
+const NodeExecutionPolicy& ExecutionScheduler::policyOf(int slot) const
+{
+    static const NodeExecutionPolicy defaultPolicy;
+    const NodeExecutionPolicy* policy = m_policies.find(m_context.graph().nodeTypeId(slot));
+    return policy ? *policy : defaultPolicy;
+}
+
+ExecutionReport ExecutionScheduler::run()
+{
+    ExecutionContext& context = m_context;
+    const GraphSnapshot& graph = context.graph();
+    const int n = context.nodeCount();
+
+    ExecutionReport report;
+    std::vector<SlotState> state(n, SlotState::Waiting);
+    std::vector<int> pendingInputs(n);
+    std::vector<int> pendingConsumers(n);
+    std::vector<char> releasable(n, 0);
+    std::vector<int> attempts(n, 0);
+    std::vector<qint64> notBefore(n, 0);
+    std::vector<int> position(n, 0);
+    std::vector<int> runningByType(NodeTypeIds::count() + 1, 0);
+    for (int slot = 0; slot < n; ++slot) {
+        pendingInputs[slot] = graph.inDegree(slot);
+        pendingConsumers[slot] = graph.outDegree(slot);
+    }
+    for (int slot : context.releaseSlots) {
+        releasable[slot] = 1;
+    }
+    for (int i = 0; i < n; ++i) {
+        position[context.order[i]] = i;
+    }
+
+    // 向上秩：节点自身的估计耗时加上到汇点的最长路径，沿逆拓扑顺序计算
+    std::vector<qint64> rank(n, 0);
+    std::vector<int> priority(n, 0);
+    if (m_order == SchedulingOrder::CriticalPath) {
+        for (auto it = context.order.rbegin(); it != context.order.rend(); ++it) {
+            const int slot = *it;
+            qint64 longest = 0;
+            for (const GraphEdge* edge = graph.outBegin(slot); edge != graph.outEnd(slot); ++edge) {
+                longest = std::max(longest, rank[edge->node]);
+            }
+            const qint64 cost = m_costModel ? m_costModel->estimate(graph.nodeTypeId(slot)) : NodeCostModel::DefaultCostNs;
+            rank[slot] = cost + longest;
+            report.criticalPathNs = std::max(report.criticalPathNs, rank[slot]);
+        }
+    }
+    if (m_priorities && !m_priorities->isEmpty()) {
+        for (int slot = 0; slot < n; ++slot) {
+            priority[slot] = m_priorities->value(context.nodeId(slot), 0);
+        }
+    }
+
+    // 就绪队列是按（用户优先级，向上秩，计划顺序）排列的二叉堆，堆顶最先分派；
+    // 没有优先级和耗时差异时与顺序执行的次序一致。
+    // 等待重试的节点放在按时刻排列的堆中，到期后进入就绪队列；
+    // 因类型并发上限不能分派的节点按类型暂存，该类型的任务结束时取回一个
+    auto after = [&](int a, int b) {
+        if (priority[a] != priority[b]) return priority[a] < priority[b];
+        if (rank[a] != rank[b]) return rank[a] < rank[b];
+        return position[a] > position[b];
+    };
+    std::priority_queue<int, std::vector<int>, decltype(after)> ready(after);
+    using Delayed = std::pair<qint64, int>;
+    std::priority_queue<Delayed, std::vector<Delayed>, std::greater<Delayed>> delayed;
+    std::vector<std::vector<int>> parked(runningByType.size());
+
+    QElapsedTimer clock;
+    clock.start();
+
+    auto pushReady = [&](int slot) {
+        state[slot] = SlotState::Ready;
+        if (notBefore[slot] > clock.elapsed()) {
+            delayed.emplace(notBefore[slot], slot);
+        } else {
+            ready.push(slot);
+        }
+    };
+    auto park = [&](int slot) {
+        std::vector<int>& heap = parked[graph.nodeTypeId(slot)];
+        heap.push_back(slot);
+        std::push_heap(heap.begin(), heap.end(), after);
+    };
+    // 该类型的一个任务结束（完成或被放弃），空出的并发名额交给暂存的最优节点
+    auto releaseType = [&](NodeTypeId type) {
+        --runningByType[type];
+        std::vector<int>& heap = parked[type];
+        if (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), after);
+            ready.push(heap.back());
+            heap.pop_back();
+        }
+    };
+
+    auto queue = std::make_shared<CompletionQueue>();
+    std::vector<std::shared_ptr<Task>> tasks;
+    std::vector<int> running;           // 未被放弃的任务下标
+    int remaining = n;
+
+    // 节点完成（执行成功或被跳过）：通知下游，释放不再需要的上游结果。
+    // 被跳过的下游随之完成；用工作表代替递归，很长的跳过链（例如从检查点恢复）也不会耗尽栈
+    std::vector<int> completing;
+    auto complete = [&](int first) {
+        completing.push_back(first);
+        while (!completing.empty()) {
+            const int slot = completing.back();
+            completing.pop_back();
+            state[slot] = SlotState::Done;
+            --remaining;
+            for (const GraphEdge* edge = graph.inBegin(slot); edge != graph.inEnd(slot); ++edge) {
+                if (--pendingConsumers[edge->node] == 0 && releasable[edge->node]) {
+                    context.results[edge->node].reset();
+                }
+            }
+            for (const GraphEdge* edge = graph.outBegin(slot); edge != graph.outEnd(slot); ++edge) {
+                const int consumer = edge->node;
+                if (--pendingInputs[consumer] == 0 && state[consumer] == SlotState::Waiting) {
+                    if (m_skip && m_skip(consumer)) {
+                        completing.push_back(consumer);
+                    } else {
+                        pushReady(consumer);
+                    }
+                }
+            }
+        }
+    };
+
+    // 失败的节点：按策略重试；用尽次数后跳过下游或中止整轮
+    auto fail = [&](int slot, const QString& error) {
+        const NodeExecutionPolicy& policy = policyOf(slot);
+        const NodeId nodeId = context.nodeId(slot);
+        if (attempts[slot] < policy.maxAttempts) {
+            const qint64 delay = static_cast<qint64>(policy.retryDelayMs * std::pow(policy.retryBackoff, attempts[slot] - 1));
+            qCWarning(lcExec) << "节点" << nodeId << "第" << attempts[slot] << "次执行失败:" << error
+                              << "，" << delay << "ms 后重试";
+            ++report.retryCount;
+            notBefore[slot] = clock.elapsed() + delay;
+            pushReady(slot);
+            return;
+        }
+
+        qCCritical(lcExec) << "执行节点" << nodeId << "失败:" << error;
+        state[slot] = SlotState::Failed;
+        --remaining;
+        report.failedNodes.append(nodeId);
+        report.errors.insert(nodeId, error);
+        if (!policy.continueOnError) {
+            report.aborted = true;
+            return;
+        }
+
+        // 下游节点缺少输入，全部跳过
+        std::vector<int> stack{slot};
+        while (!stack.empty()) {
+            const int current = stack.back();
+            stack.pop_back();
+            for (const GraphEdge* edge = graph.outBegin(current); edge != graph.outEnd(current); ++edge) {
+                const int consumer = edge->node;
+                if (state[consumer] == SlotState::Waiting) {
+                    state[consumer] = SlotState::Skipped;
+                    --remaining;
+                    report.skippedNodes.append(context.nodeId(consumer));
+                    stack.push_back(consumer);
+                }
+            }
+        }
+    };
+
+    auto start = [&](int slot) {
+        ++attempts[slot];
+        try {
+            if (m_beforeExecute) {
+                m_beforeExecute(slot);
+            }
+        } catch (const std::exception& e) {
+            fail(slot, QString::fromUtf8(e.what()));
+            return;
+        }
+
+        const TypedNodeExecutor* executor = context.slotExecutor[slot];
+        if (!executor) {
+            // 未注册执行器不是偶发错误，不重试
+            attempts[slot] = policyOf(slot).maxAttempts;
+            fail(slot, QString("未注册的执行器: %1").arg(graph.nodeType(slot)));
+            return;
+        }
+
+        auto task = std::make_shared<Task>();
+        task->slot = slot;
+        task->nodeId = context.nodeId(slot);
+        task->executor = *executor;
+        const NodeInputs inputs = context.inputsOf(slot);
+        task->inputValues.resize(inputs.size());
+        task->inputPointers.resize(inputs.size());
+        for (PortIndex port = 0; port < inputs.size(); ++port) {
+            task->inputValues[port] = inputs[port];
+            task->inputPointers[port] = &task->inputValues[port];
+        }
+        const int timeoutMs = policyOf(slot).timeoutMs;
+        task->deadlineMs = timeoutMs > 0 ? clock.elapsed() + timeoutMs : 0;
+
+        const int taskIndex = static_cast<int>(tasks.size());
+        tasks.push_back(task);
+        running.push_back(taskIndex);
+        state[slot] = SlotState::Running;
+        ++runningByType[graph.nodeTypeId(slot)];
+
+        const bool profiling = m_profiler != nullptr;
+        std::shared_ptr<std::atomic<int>> abandoned = m_abandonedTasks;
+        m_pool.setMaxThreadCount(m_maxParallel + abandoned->load());
+        QtConcurrent::run(&m_pool, [task, taskIndex, queue, abandoned, profiling]() {
+            qint64 cpuStartNs = 0;
+            if (profiling) {
+                task->threadIndex = ExecutionProfiler::currentThreadIndex();
+                task->startClockNs = ExecutionProfiler::clockNs();
+                cpuStartNs = ExecutionProfiler::threadCpuTimeNs();
+            }
+
+            QElapsedTimer timer;
+            timer.start();
+            try {
+                task->result = task->executor(task->nodeId, NodeInputs(task->inputPointers.data(),
+                                                                       task->inputPointers.size()));
+                task->ok = true;
+            } catch (const std::exception& e) {
+                task->error = QString::fromUtf8(e.what());
+            } catch (...) {
+                task->error = "未知异常";
+            }
+            task->wallNs = timer.nsecsElapsed();
+            if (profiling) {
+                task->cpuNs = ExecutionProfiler::threadCpuTimeNs() - cpuStartNs;
+            }
+
+            int expected = TaskRunning;
+            if (!task->state.compare_exchange_strong(expected, TaskFinished)) {
+                // 调度线程已因超时放弃该任务，结果丢弃
+                --*abandoned;
+                return;
+            }
+            QMutexLocker locker(&queue->mutex);
+            queue->finished.push_back(taskIndex);
+            queue->condition.wakeAll();
+        });
+    };
+
+    // 入度为 0 的节点就绪
+    for (int slot : context.order) {
+        if (pendingInputs[slot] == 0 && state[slot] == SlotState::Waiting) {
+            if (m_skip && m_skip(slot)) {
+                complete(slot);
+            } else {
+                pushReady(slot);
+            }
+        }
+    }
+
+    std::vector<int> finished;
+    while (remaining > 0 && !report.aborted) {
+        // 分派：重试等待到期的节点先回到就绪队列，再按堆顶依次分派，达到类型并发上限的暂存
+        const qint64 now = clock.elapsed();
+        while (!delayed.empty() && delayed.top().first <= now) {
+            ready.push(delayed.top().second);
+            delayed.pop();
+        }
+        while (!ready.empty() && static_cast<int>(running.size()) < m_maxParallel && !report.aborted) {
+            const int slot = ready.top();
+            ready.pop();
+            const NodeExecutionPolicy& policy = policyOf(slot);
+            if (policy.maxConcurrency > 0 && runningByType[graph.nodeTypeId(slot)] >= policy.maxConcurrency) {
+                park(slot);
+                continue;
+            }
+            start(slot);
+        }
+        if (remaining == 0 || report.aborted) break;
+
+        qint64 wakeAt = delayed.empty() ? -1 : delayed.top().first;
+        for (int taskIndex : running) {
+            const qint64 deadline = tasks[taskIndex]->deadlineMs;
+            if (deadline > 0) {
+                wakeAt = (wakeAt < 0) ? deadline : std::min(wakeAt, deadline);
+            }
+        }
+        if (running.empty() && wakeAt < 0) {
+            // 没有运行中的任务也没有可等待的时刻，剩余节点无法就绪（不应发生）
+            qCCritical(lcExec) << "调度停滞，剩余节点:" << remaining;
+            report.aborted = true;
+            break;
+        }
+
+        {
+            QMutexLocker locker(&queue->mutex);
+            if (queue->finished.empty()) {
+                if (m_idle && m_idleIntervalMs > 0) {
+                    const qint64 idleAt = clock.elapsed() + m_idleIntervalMs;
+                    wakeAt = (wakeAt < 0) ? idleAt : std::min(wakeAt, idleAt);
+                }
+                const qint64 waitMs = (wakeAt < 0) ? -1 : std::max<qint64>(0, wakeAt - clock.elapsed());
+                if (waitMs < 0) {
+                    queue->condition.wait(&queue->mutex);
+                } else if (waitMs > 0) {
+                    queue->condition.wait(&queue->mutex, static_cast<unsigned long>(waitMs));
+                }
+            }
+            finished.swap(queue->finished);
+        }
+        if (m_idle) {
+            m_idle();
+        }
+
+        for (int taskIndex : finished) {
+            Task& task = *tasks[taskIndex];
+            running.erase(std::find(running.begin(), running.end(), taskIndex));
+            releaseType(graph.nodeTypeId(task.slot));
+            if (report.aborted) continue;
+
+            if (task.ok) {
+                if (m_profiler) {
+                    NodeProfileSample sample;
+                    sample.nodeId = task.nodeId;
+                    sample.threadIndex = task.threadIndex;
+                    sample.startNs = m_profiler->toRunNs(task.startClockNs);
+                    sample.wallNs = task.wallNs;
+                    sample.cpuNs = task.cpuNs;
+                    sample.outputBytes = ExecutionProfiler::estimateSize(task.result);
+                    m_profiler->record(sample);
+                }
+                context.results[task.slot] = std::move(task.result);
+                ++report.executedCount;
+                if (m_costModel) {
+                    m_costModel->record(graph.nodeTypeId(task.slot), task.wallNs);
+                }
+                if (m_afterExecute) {
+                    m_afterExecute(task.slot);
+                }
+                complete(task.slot);
+            } else {
+                fail(task.slot, task.error);
+            }
+            task.inputValues.clear();
+        }
+        finished.clear();
+
+        // 超时：放弃仍在运行的任务，线程池为它多留一个线程
+        const qint64 checkNow = clock.elapsed();
+        for (size_t i = 0; i < running.size() && !report.aborted;) {
+            Task& task = *tasks[running[i]];
+            int expected = TaskRunning;
+            if (task.deadlineMs > 0 && checkNow >= task.deadlineMs
+                && task.state.compare_exchange_strong(expected, TaskAbandoned)) {
+                ++*m_abandonedTasks;
+                ++report.timeoutCount;
+                releaseType(graph.nodeTypeId(task.slot));
+                running.erase(running.begin() + static_cast<std::ptrdiff_t>(i));
+                fail(task.slot, QString("执行超时（%1 ms）").arg(policyOf(task.slot).timeoutMs));
+                continue;
+            }
+            ++i;
+        }
+    }
+
+    // 中止时放弃所有仍在运行的任务，它们的结果不再需要
+    for (int taskIndex : running) {
+        int expected = TaskRunning;
+        if (tasks[taskIndex]->state.compare_exchange_strong(expected, TaskAbandoned)) {
+            ++*m_abandonedTasks;
+        }
+    }
+
+    report.success = !report.aborted && report.failedNodes.isEmpty();
+    return report;
+}
\ No newline at end of file
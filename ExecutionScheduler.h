@@ -0,0 +1,110 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_EXECUTIONSCHEDULER_H
+#define NODEEDITORDEMO_EXECUTIONSCHEDULER_H
+
+#include "ExecutionContext.h"
+#include "NodeCostModel.h"
+#include "NodeTypeId.h"
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+class ExecutionProfiler;
+class QThreadPool;
+
+// 节点类型的调度策略
+struct NodeExecutionPolicy
+{
+    int timeoutMs = 0;              // 单次执行的最长时间，0 表示不限制
+    int maxAttempts = 1;            // 最多执行次数（含第一次）
+    int retryDelayMs = 100;         // 第一次重试前的等待时间
+    double retryBackoff = 2.0;      // 之后每次重试等待时间的倍数
+    int maxConcurrency = 0;         // 同一类型同时执行的实例上限，0 表示不限制
+    bool continueOnError = false;   // 最终失败时只跳过下游节点，其余分支继续执行
+};
+
+using NodePolicyTable = NodeTypeTable<NodeExecutionPolicy>;
+
+// 就绪节点多于空闲线程时的分派顺序；用户设置的节点优先级总是先比较
+enum class SchedulingOrder
+{
+    PlanOrder,      // 按执行计划（拓扑）顺序，先就绪先执行
+    CriticalPath    // 按节点到汇点的最长估计耗时（向上秩）从大到小，关键路径上的节点优先
+};
+
+// 一轮调度执行的结果；continueOnError 的节点失败时 success 为 false，但其他分支的结果仍然有效
+struct ExecutionReport
+{
+    bool success = false;
+    bool aborted = false;           // 没有 continueOnError 的节点失败，其余节点未执行
+    int executedCount = 0;
+    int retryCount = 0;
+    int timeoutCount = 0;
+    qint64 criticalPathNs = 0;      // 按耗时估计的关键路径长度（CriticalPath 顺序时计算）
+    QList<NodeId> failedNodes;
+    QList<NodeId> skippedNodes;     // 上游失败而没有执行
+    QHash<NodeId, QString> errors;
+};
+
+// 按策略调度执行计划：依赖就绪的节点在线程池上并行执行，遵守各类型的并发上限，
+// 就绪节点按用户优先级和关键路径排序，
+// 失败时按退避间隔重试，超时的执行被放弃（C++ 无法安全中止线程，它会在后台继续运行直到返回，
+// 结果被丢弃，不再计入并发上限）。
+// 线程池为被放弃的执行额外留出线程，它们的数目记在 abandonedTasks 中，由线程池的所有者持有，
+// 同一线程池上的各轮调度共享；任务返回时才减少，所以用共享指针，调度器销毁后仍然有效。
+// 调度循环运行在调用线程上，结果、释放、钩子和性能采样都在调用线程处理；
+// 执行器拿到的是输入的副本（缓冲区只增加引用计数），被放弃的执行不会访问已释放的结果，也不会访问分析器。
+class ExecutionScheduler
+{
+public:
+    ExecutionScheduler(ExecutionContext& context, const NodePolicyTable& policies,
+                       QThreadPool& pool, std::shared_ptr<std::atomic<int>> abandonedTasks, int maxParallel);
+
+    // 返回 true 的节点不执行，直接视为完成（例如已有检查点、结果不再需要）
+    void setSkipPredicate(std::function<bool(int slot)> skip) { m_skip = std::move(skip); }
+    // 分派前调用，可以抛出异常（按执行失败处理）
+    void setBeforeExecute(std::function<void(int slot)> hook) { m_beforeExecute = std::move(hook); }
+    // 结果写入 context.results 之后调用
+    void setAfterExecute(std::function<void(int slot)> hook) { m_afterExecute = std::move(hook); }
+    void setProfiler(ExecutionProfiler* profiler) { m_profiler = profiler; }
+    // 等待任务完成时至少每 intervalMs 毫秒调用一次（在调用线程上），用于刷新界面
+    void setIdleHook(int intervalMs, std::function<void()> hook)
+    {
+        m_idleIntervalMs = intervalMs;
+        m_idle = std::move(hook);
+    }
+    // 耗时估计来源；每个成功执行的节点的耗时也记录进去
+    void setCostModel(NodeCostModel* costModel) { m_costModel = costModel; }
+    void setOrder(SchedulingOrder order) { m_order = order; }
+    // 用户设置的节点优先级，数值大的先执行，未设置为 0
+    void setPriorities(const QHash<NodeId, int>* priorities) { m_priorities = priorities; }
+
+    ExecutionReport run();
+
+private:
+    const NodeExecutionPolicy& policyOf(int slot) const;
+
+private:
+    ExecutionContext& m_context;
+    const NodePolicyTable& m_policies;
+    QThreadPool& m_pool;
+    std::shared_ptr<std::atomic<int>> m_abandonedTasks;
+    int m_maxParallel;
+    std::function<bool(int)> m_skip;
+    std::function<void(int)> m_beforeExecute;
+    std::function<void(int)> m_afterExecute;
+    std::function<void()> m_idle;
+    int m_idleIntervalMs = 0;
+    ExecutionProfiler* m_profiler = nullptr;
+    NodeCostModel* m_costModel = nullptr;
+    SchedulingOrder m_order = SchedulingOrder::CriticalPath;
+    const QHash<NodeId, int>* m_priorities = nullptr;
+};
+
+#endif // NODEEDITORDEMO_EXECUTIONSCHEDULER_H
\ No newline at end of file
@@ -0,0 +1,251 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "ExecutionStateOverlay.h"
+#include <QGuiApplication>
+#include <QPainter>
+#include <QScreen>
+#include <QStyleOptionGraphicsItem>
+#include <algorithm>
+
+namespace {
+const qreal LabelHeight = 16.0;
+const qreal LabelGap = 2.0;
+const int PreviewLength = 16;
+}
+
+ExecutionStateOverlay::ExecutionStateOverlay(DataFlowGraphModel& graphModel, QGraphicsItem* parent)
+    : QGraphicsObject(parent)
+    , m_graphModel(graphModel)
+{
+    setAcceptedMouseButtons(Qt::NoButton);
+    setAcceptHoverEvents(false);
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+    setZValue(1001);
+
+    qreal refreshRate = 60.0;
+    if (QScreen* screen = QGuiApplication::primaryScreen()) {
+        refreshRate = std::max<qreal>(1.0, screen->refreshRate());
+    }
+    m_frameTimer.setInterval(std::max(1, qRound(1000.0 / refreshRate)));
+    m_frameTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_frameTimer, &QTimer::timeout, this, &ExecutionStateOverlay::flush);
+    m_clock.start();
+
+    // 批量移动、删除时每个节点都会通知一次，外接矩形在下一帧统一重算
+    connect(&m_graphModel, &DataFlowGraphModel::nodePositionUpdated, this, [this](NodeId nodeId) {
+        auto it = m_entries.find(nodeId);
+        if (it == m_entries.end()) return;
+        it->rect = nodeRect(nodeId);
+        markGeometryDirty();
+    });
+    connect(&m_graphModel, &DataFlowGraphModel::nodeDeleted, this, [this](NodeId nodeId) {
+        if (m_entries.remove(nodeId) > 0) {
+            markGeometryDirty();
+        }
+    });
+}
+
+void ExecutionStateOverlay::beginRun()
+{
+    m_events.clear();
+    m_entries.clear();
+    m_runningCount = 0;
+    for (NodeId nodeId : m_graphModel.allNodeIds()) {
+        Entry entry;
+        entry.rect = nodeRect(nodeId);
+        m_entries.insert(nodeId, entry);
+    }
+    refreshGeometry();
+    m_frameTimer.start();
+}
+
+void ExecutionStateOverlay::endRun()
+{
+    flush();
+    // 执行中的节点（例如被放弃的超时任务）不再更新
+    m_runningCount = 0;
+    m_frameTimer.stop();
+    update();
+}
+
+void ExecutionStateOverlay::nodeStarted(NodeId nodeId)
+{
+    enqueue(nodeId, NodeState::Running, QVariant());
+}
+
+void ExecutionStateOverlay::nodeExecuted(NodeId nodeId, const QVariant& result)
+{
+    enqueue(nodeId, NodeState::Done, result);
+}
+
+void ExecutionStateOverlay::nodeFailed(NodeId nodeId, const QString& error)
+{
+    enqueue(nodeId, NodeState::Failed, error);
+}
+
+void ExecutionStateOverlay::clear()
+{
+    m_frameTimer.stop();
+    m_events.clear();
+    m_entries.clear();
+    m_runningCount = 0;
+    refreshGeometry();
+}
+
+void ExecutionStateOverlay::enqueue(NodeId nodeId, NodeState state, const QVariant& result)
+{
+    // 只记录事件，不做任何绘制相关的工作
+    m_events.push_back(Event{nodeId, state, m_clock.elapsed(), result});
+    if (!m_frameTimer.isActive()) {
+        m_frameTimer.start();
+    }
+}
+
+void ExecutionStateOverlay::markGeometryDirty()
+{
+    m_geometryDirty = true;
+    if (!m_frameTimer.isActive()) {
+        m_frameTimer.start();
+    }
+}
+
+void ExecutionStateOverlay::flush()
+{
+    if (m_geometryDirty) {
+        refreshGeometry();
+    }
+
+    for (const Event& event : m_events) {
+        auto it = m_entries.find(event.nodeId);
+        if (it == m_entries.end()) continue;
+        Entry& entry = *it;
+
+        if (entry.state == NodeState::Running) {
+            --m_runningCount;
+        }
+        entry.state = event.state;
+        switch (event.state) {
+        case NodeState::Running:
+            entry.startMs = event.timeMs;
+            entry.elapsedMs = -1;
+            ++m_runningCount;
+            break;
+        case NodeState::Done:
+            entry.elapsedMs = entry.startMs >= 0 ? event.timeMs - entry.startMs : -1;
+            entry.preview = previewText(event.result);
+            break;
+        case NodeState::Failed:
+            entry.elapsedMs = entry.startMs >= 0 ? event.timeMs - entry.startMs : -1;
+            entry.preview = event.result.toString().left(PreviewLength);
+            break;
+        case NodeState::Pending:
+            break;
+        }
+        update(labelRect(entry.rect));
+    }
+    m_events.clear();
+
+    // 执行中的节点显示实时耗时，每帧重绘
+    if (m_runningCount > 0) {
+        for (const Entry& entry : m_entries) {
+            if (entry.state == NodeState::Running) {
+                update(labelRect(entry.rect));
+            }
+        }
+    } else {
+        m_frameTimer.stop();
+    }
+}
+
+QRectF ExecutionStateOverlay::nodeRect(NodeId nodeId) const
+{
+    QPointF pos = m_graphModel.nodeData(nodeId, NodeRole::Position).toPointF();
+    QSizeF size = m_graphModel.nodeData(nodeId, NodeRole::Size).toSize();
+    return QRectF(pos, size);
+}
+
+QRectF ExecutionStateOverlay::labelRect(const QRectF& rect) const
+{
+    return QRectF(rect.left(), rect.bottom() + LabelGap, std::max<qreal>(rect.width(), 120.0), LabelHeight);
+}
+
+void ExecutionStateOverlay::refreshGeometry()
+{
+    m_geometryDirty = false;
+    QRectF bounds;
+    for (const Entry& entry : m_entries) {
+        bounds |= labelRect(entry.rect);
+    }
+
+    prepareGeometryChange();
+    m_bounds = bounds;
+    update();
+}
+
+QRectF ExecutionStateOverlay::boundingRect() const
+{
+    return m_bounds;
+}
+
+void ExecutionStateOverlay::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    Q_UNUSED(widget);
+
+    if (m_entries.isEmpty()) return;
+
+    const QRectF exposed = option->exposedRect;
+    const qint64 now = m_clock.elapsed();
+    QFont font = painter->font();
+    font.setPointSizeF(7.5);
+    painter->setFont(font);
+    painter->setRenderHint(QPainter::Antialiasing);
+
+    for (const Entry& entry : m_entries) {
+        const QRectF label = labelRect(entry.rect);
+        if (!exposed.intersects(label)) continue;
+
+        QColor color;
+        QString text;
+        switch (entry.state) {
+        case NodeState::Pending:
+            color = QColor(150, 150, 150);
+            text = "等待";
+            break;
+        case NodeState::Running:
+            color = QColor(40, 120, 230);
+            text = QString("执行中 %1 ms").arg(now - entry.startMs);
+            break;
+        case NodeState::Done:
+            color = QColor(40, 170, 80);
+            text = entry.elapsedMs >= 0 ? QString("%1 ms  %2").arg(entry.elapsedMs).arg(entry.preview) : entry.preview;
+            break;
+        case NodeState::Failed:
+            color = QColor(220, 60, 50);
+            text = QString("失败 %1").arg(entry.preview);
+            break;
+        }
+
+        const qreal dot = LabelHeight * 0.5;
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(color);
+        painter->drawEllipse(QRectF(label.left(), label.center().y() - dot / 2, dot, dot));
+
+        painter->setPen(color.darker(140));
+        painter->drawText(label.adjusted(dot + 4, 0, 0, 0), Qt::AlignLeft | Qt::AlignVCenter, text);
+    }
+}
+
+QString ExecutionStateOverlay::previewText(const QVariant& value)
+{
+    if (!value.isValid()) return QString();
+    if (value.type() == QVariant::Double) {
+        return QString::number(value.toDouble(), 'g', 6);
+    }
+    const QString text = value.toString();
+    if (!text.isEmpty() || value.canConvert<QString>()) {
+        return text.length() > PreviewLength ? text.left(PreviewLength - 1) + "…" : text;
+    }
+    return QString("<%1>").arg(value.typeName());
+}
\ No newline at end of file
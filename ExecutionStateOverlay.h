@@ -0,0 +1,88 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_EXECUTIONSTATEOVERLAY_H
+#define NODEEDITORDEMO_EXECUTIONSTATEOVERLAY_H
+
+#include <QtNodes/DataFlowGraphModel>
+#include <QElapsedTimer>
+#include <QGraphicsObject>
+#include <QHash>
+#include <QTimer>
+#include <QVariant>
+#include <vector>
+
+using namespace QtNodes;
+
+// 执行过程中每个节点的实时状态（等待/执行中/完成/失败）、耗时和结果预览。
+// 与 ExecutionOverlay 一样整个场景只有一个图元，不创建控件；
+// 状态事件先追加到队列，按屏幕刷新间隔合并处理一次，只重绘状态变化的节点和执行中的节点。
+class ExecutionStateOverlay : public QGraphicsObject
+{
+    Q_OBJECT
+
+public:
+    enum class NodeState : quint8
+    {
+        Pending,
+        Running,
+        Done,
+        Failed
+    };
+
+    explicit ExecutionStateOverlay(DataFlowGraphModel& graphModel, QGraphicsItem* parent = nullptr);
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+
+    // 刷新间隔（屏幕刷新率对应的毫秒数）
+    int frameIntervalMs() const { return m_frameTimer.interval(); }
+
+public slots:
+    // 场景中所有节点进入等待状态
+    void beginRun();
+    void endRun();
+    void nodeStarted(NodeId nodeId);
+    void nodeExecuted(NodeId nodeId, const QVariant& result);
+    void nodeFailed(NodeId nodeId, const QString& error);
+    void clear();
+
+private:
+    struct Entry
+    {
+        QRectF rect;            // 节点外框，位置变化时更新
+        NodeState state = NodeState::Pending;
+        qint64 startMs = -1;
+        qint64 elapsedMs = -1;
+        QString preview;
+    };
+
+    struct Event
+    {
+        NodeId nodeId;
+        NodeState state;
+        qint64 timeMs;
+        QVariant result;        // 完成时为结果，失败时为错误信息
+    };
+
+    void enqueue(NodeId nodeId, NodeState state, const QVariant& result);
+    void flush();
+    QRectF nodeRect(NodeId nodeId) const;
+    QRectF labelRect(const QRectF& nodeRect) const;
+    void refreshGeometry();
+    void markGeometryDirty();
+    static QString previewText(const QVariant& value);
+
+private:
+    DataFlowGraphModel& m_graphModel;
+    QHash<NodeId, Entry> m_entries;
+    std::vector<Event> m_events;
+    int m_runningCount = 0;
+    QElapsedTimer m_clock;
+    QTimer m_frameTimer;
+    QRectF m_bounds;
+    bool m_geometryDirty = false;
+};
+
+#endif // NODEEDITORDEMO_EXECUTIONSTATEOVERLAY_H
\ No newline at end of file
@@ -0,0 +1,404 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "ExecutorDaemon.h"
+#include "FlowValidator.h"
+#include "Logging.h"
+#include "NodeEditorCore.h"
+#include "WorkerProtocol.h"
+#include <QApplication>
+#include <QCryptographicHash>
+#include <QJsonDocument>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+namespace {
+
+void beginMessage(QDataStream& stream, WorkerProtocol::MessageType type)
+{
+    stream.setVersion(WorkerProtocol::StreamVersion);
+    stream << quint8(type);
+}
+
+} // namespace
+
+ExecutorDaemon::ExecutorDaemon(QObject* parent)
+    : QObject(parent)
+    , m_server(new QTcpServer(this))
+{
+    connect(m_server, &QTcpServer::newConnection, this, &ExecutorDaemon::onNewConnection);
+}
+
+ExecutorDaemon::~ExecutorDaemon() = default;
+
+bool ExecutorDaemon::listen(const QHostAddress& address, quint16 port)
+{
+    m_core = std::make_unique<NodeEditorCore>();
+    if (!m_core->initialize()) {
+        qCCritical(lcExec) << "守护进程初始化失败";
+        return false;
+    }
+    m_core->validator()->setAutoValidate(false);
+
+    // 守护进程执行收到的任意场景：对外监听时必须有令牌
+    m_token = WorkerProtocol::daemonToken();
+    if (m_token.isEmpty() && !address.isLoopback()) {
+        qCCritical(lcExec) << "监听非本机地址" << address.toString() << "时必须设置环境变量"
+                           << WorkerProtocol::DaemonTokenVariable;
+        return false;
+    }
+
+    if (!m_server->listen(address, port)) {
+        qCCritical(lcExec) << "守护进程无法监听" << address.toString() << port << ":" << m_server->errorString();
+        return false;
+    }
+    qCDebug(lcExec) << "执行守护进程已启动:" << address.toString() << port;
+    return true;
+}
+
+void ExecutorDaemon::onNewConnection()
+{
+    while (QTcpSocket* socket = m_server->nextPendingConnection()) {
+        socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        m_buffers.insert(socket, QByteArray());
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { onReadyRead(socket); });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            m_buffers.remove(socket);
+            m_authenticated.remove(socket);
+            if (m_run.host == socket) {
+                // 编辑器断开，本轮作废
+                qCWarning(lcExec) << "编辑器断开连接，放弃执行轮次" << m_run.id;
+                m_run = Run();
+            }
+            socket->deleteLater();
+        });
+    }
+}
+
+void ExecutorDaemon::onReadyRead(QTcpSocket* socket)
+{
+    auto it = m_buffers.find(socket);
+    if (it == m_buffers.end()) return;
+    it->append(socket->readAll());
+
+    QByteArray frame;
+    while (m_buffers.contains(socket) && WorkerProtocol::takeFrame(m_buffers[socket], frame)) {
+        handleFrame(socket, frame);
+    }
+}
+
+void ExecutorDaemon::handleFrame(QTcpSocket* socket, const QByteArray& frame)
+{
+    QDataStream stream(frame);
+    stream.setVersion(WorkerProtocol::StreamVersion);
+    quint8 type = 0;
+    stream >> type;
+
+    if (!m_authenticated.contains(socket)) {
+        QByteArray token;
+        if (type == WorkerProtocol::Authenticate) {
+            stream >> token;
+        }
+        if (type != WorkerProtocol::Authenticate || !WorkerProtocol::tokenMatches(m_token, token)) {
+            qCWarning(lcExec) << "拒绝未认证的连接:" << socket->peerAddress().toString();
+            m_buffers.remove(socket);
+            socket->abort();
+            return;
+        }
+        m_authenticated.insert(socket);
+        return;
+    }
+
+    switch (type) {
+    case WorkerProtocol::AssignPartition:
+        assignPartition(socket, stream);
+        break;
+    case WorkerProtocol::RemoteValue: {
+        quint64 runId = 0;
+        qint64 nodeId = 0;
+        stream >> runId >> nodeId;
+        NodeValue value;
+        try {
+            value = WorkerProtocol::readValue(stream);
+        } catch (const std::exception& e) {
+            qCWarning(lcExec) << "无法读取远程结果:" << e.what();
+            return;
+        }
+
+        if (runId == m_run.id && m_run.host) {
+            if (acceptRemoteValue(static_cast<NodeId>(nodeId), std::move(value))) {
+                executeReady();
+            }
+        } else if (runId > m_run.id) {
+            m_earlyValues[runId].emplace_back(static_cast<NodeId>(nodeId), std::move(value));
+        }
+        break;
+    }
+    default:
+        qCWarning(lcExec) << "守护进程收到未知消息:" << type;
+        break;
+    }
+}
+
+void ExecutorDaemon::assignPartition(QTcpSocket* host, QDataStream& stream)
+{
+    quint64 runId = 0;
+    QByteArray sceneJson;
+    QVector<qint64> localNodes;
+    QVector<qint64> reportNodes;
+    quint32 routeCount = 0;
+    stream >> runId >> sceneJson >> localNodes >> routeCount;
+
+    Run run;
+    run.id = runId;
+    run.host = host;
+    for (quint32 i = 0; i < routeCount; ++i) {
+        qint64 nodeId = 0;
+        QStringList peers;
+        stream >> nodeId >> peers;
+        run.routes.insert(static_cast<NodeId>(nodeId), peers);
+    }
+    stream >> reportNodes;
+
+    // 场景内容不变时复用已加载的镜像
+    const QByteArray sceneHash = QCryptographicHash::hash(sceneJson, QCryptographicHash::Sha1);
+    if (sceneHash != m_sceneHash) {
+        QJsonParseError parseError;
+        const QJsonDocument document = QJsonDocument::fromJson(sceneJson, &parseError);
+        if (parseError.error != QJsonParseError::NoError || !m_core->loadScene(document.object())) {
+            // 镜像不可用：本分区不执行，通知编辑器放弃本轮；下次分配时重新加载
+            const QString error = parseError.error != QJsonParseError::NoError
+                ? QString("场景 JSON 无效: %1").arg(parseError.errorString())
+                : QStringLiteral("场景加载失败");
+            qCCritical(lcExec) << "执行轮次" << runId << "加载场景失败:" << error;
+            m_sceneHash.clear();
+            run.failed = true;
+            m_run = std::move(run);
+
+            QByteArray payload;
+            QDataStream reply(&payload, QIODevice::WriteOnly);
+            beginMessage(reply, WorkerProtocol::SceneError);
+            reply << runId << error;
+            WorkerProtocol::writeFrame(host, payload);
+            return;
+        }
+        m_sceneHash = sceneHash;
+        // 加载后立即构建执行计划，分区内的节点使用计划中已绑定的执行器
+        m_core->prepareExecutionPlan();
+    }
+
+    for (qint64 nodeId : localNodes) {
+        run.localNodes.insert(static_cast<NodeId>(nodeId));
+    }
+    for (qint64 nodeId : reportNodes) {
+        run.reportNodes.insert(static_cast<NodeId>(nodeId));
+    }
+
+    const auto snapshot = m_core->graphSnapshot();
+    for (NodeId nodeId : run.localNodes) {
+        const int slot = snapshot->slotOf(nodeId);
+        if (slot == GraphSnapshot::InvalidSlot) {
+            run.failed = true;
+            m_run = run;
+            reportFinished(nodeId, false, NodeValue(), "守护进程的场景中不存在该节点");
+            return;
+        }
+        run.pendingInputs.insert(nodeId, snapshot->inDegree(slot));
+        if (snapshot->inDegree(slot) == 0) {
+            run.ready.push_back(nodeId);
+        }
+        // 本地消费者计数，上游可能在本地也可能在其他守护进程
+        for (const GraphEdge* edge = snapshot->inBegin(slot); edge != snapshot->inEnd(slot); ++edge) {
+            const NodeId upstream = snapshot->nodeId(edge->node);
+            ++run.pendingConsumers[upstream];
+            if (!run.localNodes.contains(upstream)) {
+                run.remoteInputs.insert(upstream);
+            }
+        }
+    }
+
+    m_run = std::move(run);
+    qCDebug(lcExec) << "执行轮次" << runId << "本地节点数:" << m_run.localNodes.size();
+
+    // 丢弃更早轮次的暂存结果，取出本轮的
+    for (auto it = m_earlyValues.begin(); it != m_earlyValues.end();) {
+        if (it.key() < runId) {
+            it = m_earlyValues.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    auto early = m_earlyValues.take(runId);
+    for (auto& entry : early) {
+        acceptRemoteValue(entry.first, std::move(entry.second));
+    }
+    executeReady();
+}
+
+void ExecutorDaemon::acceptValue(NodeId nodeId, NodeValue value)
+{
+    const auto snapshot = m_core->graphSnapshot();
+    const int slot = snapshot->slotOf(nodeId);
+    if (slot == GraphSnapshot::InvalidSlot) return;
+
+    if (m_run.pendingConsumers.value(nodeId) > 0) {
+        m_run.values.insert(nodeId, std::move(value));
+    }
+    for (const GraphEdge* edge = snapshot->outBegin(slot); edge != snapshot->outEnd(slot); ++edge) {
+        const NodeId consumer = snapshot->nodeId(edge->node);
+        auto pending = m_run.pendingInputs.find(consumer);
+        if (pending != m_run.pendingInputs.end() && --pending.value() == 0) {
+            m_run.ready.push_back(consumer);
+        }
+    }
+}
+
+bool ExecutorDaemon::acceptRemoteValue(NodeId nodeId, NodeValue value)
+{
+    // 只接受本地节点需要、且尚未收到的远程上游结果；重复或无关的结果会打乱输入计数
+    if (!m_run.remoteInputs.remove(nodeId)) {
+        qCWarning(lcExec) << "执行轮次" << m_run.id << "忽略不需要的远程结果:" << nodeId;
+        return false;
+    }
+    acceptValue(nodeId, std::move(value));
+    return true;
+}
+
+void ExecutorDaemon::executeReady()
+{
+    // 执行期间发出的消息不会重入，但防止以后改为异步时重复执行
+    if (m_executing) return;
+    m_executing = true;
+    while (!m_run.ready.empty() && !m_run.failed) {
+        const NodeId nodeId = m_run.ready.back();
+        m_run.ready.pop_back();
+        executeLocal(nodeId);
+    }
+    m_executing = false;
+}
+
+void ExecutorDaemon::executeLocal(NodeId nodeId)
+{
+    const auto snapshot = m_core->graphSnapshot();
+    const int slot = snapshot->slotOf(nodeId);
+
+    std::vector<const NodeValue*> inputs(snapshot->inPortCount(slot), nullptr);
+    for (const GraphEdge* edge = snapshot->inBegin(slot); edge != snapshot->inEnd(slot); ++edge) {
+        auto value = m_run.values.find(snapshot->nodeId(edge->node));
+        if (edge->port < inputs.size() && value != m_run.values.end()) {
+            inputs[edge->port] = &value.value();
+        }
+    }
+
+    NodeValue result;
+    try {
+        result = m_core->executeNode(nodeId, NodeInputs(inputs.data(), inputs.size()));
+    } catch (const std::exception& e) {
+        m_run.failed = true;
+        reportFinished(nodeId, false, NodeValue(), QString::fromUtf8(e.what()));
+        return;
+    }
+
+    // 上游结果的本地消费者都执行完后释放
+    for (const GraphEdge* edge = snapshot->inBegin(slot); edge != snapshot->inEnd(slot); ++edge) {
+        const NodeId upstream = snapshot->nodeId(edge->node);
+        auto pending = m_run.pendingConsumers.find(upstream);
+        if (pending != m_run.pendingConsumers.end() && --pending.value() == 0) {
+            m_run.values.remove(upstream);
+        }
+    }
+
+    // 结果直接发给有消费者的守护进程
+    const QStringList peers = m_run.routes.value(nodeId);
+    if (!peers.isEmpty()) {
+        QByteArray payload;
+        QDataStream stream(&payload, QIODevice::WriteOnly);
+        beginMessage(stream, WorkerProtocol::RemoteValue);
+        stream << m_run.id << qint64(nodeId);
+        WorkerProtocol::writeValue(stream, result, nullptr);
+        for (const QString& peer : peers) {
+            sendToPeer(peer, nodeId, payload);
+        }
+    }
+
+    reportFinished(nodeId, true, m_run.reportNodes.contains(nodeId) ? result : NodeValue(), QString());
+    acceptValue(nodeId, std::move(result));
+}
+
+void ExecutorDaemon::sendToPeer(const QString& address, NodeId nodeId, const QByteArray& payload)
+{
+    QTcpSocket*& socket = m_peers[address];
+    if (!socket || socket->state() == QAbstractSocket::UnconnectedState) {
+        if (socket) socket->deleteLater();
+        const int colon = address.lastIndexOf(':');
+        socket = new QTcpSocket(this);
+        socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        // Qt 5.14 的 QAbstractSocket 还没有 errorOccurred 信号
+        QTcpSocket* peer = socket;
+        connect(peer, QOverload<QAbstractSocket::SocketError>::of(&QAbstractSocket::error), this,
+                [this, address, peer](QAbstractSocket::SocketError) {
+            if (m_peers.value(address) == peer) {
+                onPeerError(address, peer->errorString());
+            }
+        });
+        // 连接建立前写入的数据由 QTcpSocket 缓存
+        socket->connectToHost(address.left(colon), address.mid(colon + 1).toUShort());
+        WorkerProtocol::writeAuthenticate(socket, m_token);
+    }
+    m_run.sentTo.insert(address, nodeId);
+    WorkerProtocol::writeFrame(socket, payload);
+}
+
+void ExecutorDaemon::onPeerError(const QString& address, const QString& error)
+{
+    qCWarning(lcExec) << "与守护进程" << address << "的连接出错:" << error;
+
+    // 本轮发往该对端的结果可能丢失，对端会一直等待；报告失败，编辑器放弃本轮
+    auto sent = m_run.sentTo.find(address);
+    if (sent == m_run.sentTo.end() || m_run.failed) return;
+    const NodeId nodeId = sent.value();
+    m_run.failed = true;
+    reportFinished(nodeId, false, NodeValue(), QString("结果无法发送到守护进程 %1: %2").arg(address, error));
+}
+
+void ExecutorDaemon::reportFinished(NodeId nodeId, bool ok, const NodeValue& value, const QString& error)
+{
+    if (!m_run.host) return;
+
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    beginMessage(stream, WorkerProtocol::NodeFinished);
+    stream << m_run.id << qint64(nodeId) << ok;
+    if (ok) {
+        WorkerProtocol::writeValue(stream, value, nullptr);
+    } else {
+        stream << error;
+    }
+    WorkerProtocol::writeFrame(m_run.host, payload);
+}
+
+int ExecutorDaemon::run(int argc, char* argv[])
+{
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+
+    const QStringList arguments = app.arguments();
+    const int flagIndex = arguments.indexOf(CommandLineFlag);
+    QHostAddress address(QHostAddress::LocalHost);
+    quint16 port = DefaultPort;
+    if (flagIndex >= 0 && flagIndex + 1 < arguments.size()) {
+        const QString listen = arguments[flagIndex + 1];
+        const int colon = listen.lastIndexOf(':');
+        if (colon >= 0) {
+            address = QHostAddress(listen.left(colon));
+        }
+        port = listen.mid(colon + 1).toUShort();
+    }
+
+    ExecutorDaemon daemon;
+    if (!daemon.listen(address, port)) {
+        return 1;
+    }
+    return app.exec();
+}
\ No newline at end of file
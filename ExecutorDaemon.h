@@ -0,0 +1,87 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_EXECUTORDAEMON_H
+#define NODEEDITORDEMO_EXECUTORDAEMON_H
+
+#include "NodeValue.h"
+#include <QByteArray>
+#include <QHash>
+#include <QHostAddress>
+#include <QObject>
+#include <QSet>
+#include <QStringList>
+#include <memory>
+#include <vector>
+
+class NodeEditorCore;
+class QTcpServer;
+class QTcpSocket;
+
+// 分布式执行的守护进程：与编辑器是同一个可执行文件，以 --executor-daemon [地址:]端口 启动，
+// 默认只监听本机。编辑器把划分后的子图（AssignPartition）发给各守护进程，
+// 守护进程按数据流执行本地节点：输入齐全即执行，结果直接发给需要它的其他守护进程（RemoteValue），
+// 不经过编辑器；每个节点完成后向编辑器报告（NodeFinished）。
+// 每个连接的第一帧必须是携带共享令牌（环境变量 NODEEDITOR_DAEMON_TOKEN）的 Authenticate，
+// 否则断开；监听非本机地址时必须设置令牌。远程结果只接受本轮本地节点需要的上游节点。
+class ExecutorDaemon : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr const char* CommandLineFlag = "--executor-daemon";
+    static constexpr quint16 DefaultPort = 7301;
+
+    explicit ExecutorDaemon(QObject* parent = nullptr);
+    ~ExecutorDaemon();
+
+    bool listen(const QHostAddress& address, quint16 port);
+
+    static int run(int argc, char* argv[]);
+
+private:
+    // 当前一轮的执行状态
+    struct Run
+    {
+        quint64 id = 0;
+        QTcpSocket* host = nullptr;
+        QSet<NodeId> localNodes;
+        QHash<NodeId, QStringList> routes;
+        QSet<NodeId> reportNodes;
+        QSet<NodeId> remoteInputs;                // 由其他守护进程发来的上游结果，收到后移除
+        QHash<QString, NodeId> sentTo;            // 本轮最近发往各对端的结果，发送失败时据此报告
+        QHash<NodeId, NodeValue> values;          // 本地结果和收到的远程结果，本地消费者都执行完后释放
+        QHash<NodeId, int> pendingInputs;
+        QHash<NodeId, int> pendingConsumers;
+        std::vector<NodeId> ready;
+        bool failed = false;
+    };
+
+    void onNewConnection();
+    void onReadyRead(QTcpSocket* socket);
+    void handleFrame(QTcpSocket* socket, const QByteArray& frame);
+    void assignPartition(QTcpSocket* host, QDataStream& stream);
+    void acceptValue(NodeId nodeId, NodeValue value);
+    void executeReady();
+    void executeLocal(NodeId nodeId);
+    bool acceptRemoteValue(NodeId nodeId, NodeValue value);
+    void sendToPeer(const QString& address, NodeId nodeId, const QByteArray& payload);
+    void onPeerError(const QString& address, const QString& error);
+    void reportFinished(NodeId nodeId, bool ok, const NodeValue& value, const QString& error);
+
+private:
+    std::unique_ptr<NodeEditorCore> m_core;
+    QTcpServer* m_server = nullptr;
+    QByteArray m_token;
+    QHash<QTcpSocket*, QByteArray> m_buffers;
+    QSet<QTcpSocket*> m_authenticated;
+    QHash<QString, QTcpSocket*> m_peers;       // 发往其他守护进程的连接，按地址复用
+    QByteArray m_sceneHash;
+    Run m_run;
+    bool m_executing = false;
+    // 先于 AssignPartition 到达的远程结果，按轮次暂存
+    QHash<quint64, std::vector<std::pair<NodeId, NodeValue>>> m_earlyValues;
+};
+
+#endif // NODEEDITORDEMO_EXECUTORDAEMON_H
\ No newline at end of file
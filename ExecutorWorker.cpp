@@ -0,0 +1,173 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "ExecutorWorker.h"
+#include "FlowValidator.h"
+#include "Logging.h"
+#include "NodeEditorCore.h"
+#include <QApplication>
+#include <QJsonDocument>
+
+ExecutorWorker::ExecutorWorker(QObject* parent)
+    : QObject(parent)
+{
+    connect(&m_socket, &QLocalSocket::readyRead, this, &ExecutorWorker::onReadyRead);
+    connect(&m_socket, &QLocalSocket::disconnected, qApp, &QCoreApplication::quit);
+}
+
+ExecutorWorker::~ExecutorWorker() = default;
+
+bool ExecutorWorker::start(const QString& serverName, int index)
+{
+    m_core = std::make_unique<NodeEditorCore>();
+    if (!m_core->initialize()) {
+        qCCritical(lcExec) << "工作进程" << index << "初始化失败";
+        return false;
+    }
+    m_core->validator()->setAutoValidate(false);
+
+    m_socket.connectToServer(serverName);
+    if (!m_socket.waitForConnected(5000)) {
+        qCCritical(lcExec) << "工作进程" << index << "无法连接编辑器:" << m_socket.errorString();
+        return false;
+    }
+
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(WorkerProtocol::StreamVersion);
+    stream << quint8(WorkerProtocol::Hello) << quint32(index);
+    send(payload);
+
+    qCDebug(lcExec) << "工作进程" << index << "已连接";
+    return true;
+}
+
+void ExecutorWorker::onReadyRead()
+{
+    m_buffer.append(m_socket.readAll());
+
+    QByteArray frame;
+    while (WorkerProtocol::takeFrame(m_buffer, frame)) {
+        handleFrame(frame);
+    }
+}
+
+void ExecutorWorker::handleFrame(const QByteArray& frame)
+{
+    QDataStream stream(frame);
+    stream.setVersion(WorkerProtocol::StreamVersion);
+    quint8 type = 0;
+    stream >> type;
+
+    switch (type) {
+    case WorkerProtocol::SyncScene: {
+        quint64 runId = 0;
+        QByteArray json;
+        stream >> runId >> json;
+        QJsonParseError parseError;
+        const QJsonDocument document = QJsonDocument::fromJson(json, &parseError);
+        if (parseError.error != QJsonParseError::NoError) {
+            m_sceneError = QString("场景 JSON 无效: %1").arg(parseError.errorString());
+        } else if (!m_core->loadScene(document.object())) {
+            m_sceneError = QStringLiteral("场景加载失败");
+        } else {
+            m_sceneError.clear();
+            // 加载后立即构建执行计划，之后每个 Execute 直接使用计划中已绑定的执行器
+            m_core->prepareExecutionPlan();
+        }
+
+        if (!m_sceneError.isEmpty()) {
+            qCCritical(lcExec) << "工作进程同步场景失败，执行轮次" << runId << ":" << m_sceneError;
+            QByteArray payload;
+            QDataStream reply(&payload, QIODevice::WriteOnly);
+            reply.setVersion(WorkerProtocol::StreamVersion);
+            reply << quint8(WorkerProtocol::SceneError) << runId << m_sceneError;
+            send(payload);
+            break;
+        }
+        qCDebug(lcExec) << "工作进程同步场景，执行轮次" << runId;
+        break;
+    }
+    case WorkerProtocol::Execute: {
+        quint64 taskId = 0;
+        qint64 nodeId = 0;
+        quint32 portCount = 0;
+        stream >> taskId >> nodeId >> portCount;
+
+        QByteArray payload;
+        QDataStream reply(&payload, QIODevice::WriteOnly);
+        reply.setVersion(WorkerProtocol::StreamVersion);
+        reply << quint8(WorkerProtocol::Result) << taskId;
+
+        WorkerProtocol::Segments segments;
+        try {
+            if (!m_sceneError.isEmpty()) {
+                throw std::runtime_error(QString("场景未同步: %1").arg(m_sceneError).toStdString());
+            }
+            // 输入中的共享内存段由各自的 SharedBuffer 持有，执行完即分离
+            std::vector<NodeValue> values(portCount);
+            std::vector<const NodeValue*> pointers(portCount);
+            for (quint32 port = 0; port < portCount; ++port) {
+                values[port] = WorkerProtocol::readValue(stream);
+                pointers[port] = &values[port];
+            }
+
+            NodeValue result = m_core->executeNode(static_cast<NodeId>(nodeId),
+                                                   NodeInputs(pointers.data(), portCount));
+
+            QByteArray body;
+            QDataStream bodyStream(&body, QIODevice::WriteOnly);
+            bodyStream.setVersion(WorkerProtocol::StreamVersion);
+            WorkerProtocol::writeValue(bodyStream, result, &segments);
+            reply << true;
+            reply.writeRawData(body.constData(), body.size());
+        } catch (const std::exception& e) {
+            segments.clear();
+            reply << false << QString::fromUtf8(e.what());
+        }
+
+        for (auto& segment : segments) {
+            const QString key = segment->key();
+            m_pendingSegments.insert(key, std::shared_ptr<QSharedMemory>(segment.release()));
+        }
+        send(payload);
+        break;
+    }
+    case WorkerProtocol::ReleaseSegment: {
+        QString key;
+        stream >> key;
+        m_pendingSegments.remove(key);
+        break;
+    }
+    default:
+        qCWarning(lcExec) << "工作进程收到未知消息:" << type;
+        break;
+    }
+}
+
+void ExecutorWorker::send(const QByteArray& payload)
+{
+    WorkerProtocol::writeFrame(&m_socket, payload);
+    m_socket.flush();
+}
+
+int ExecutorWorker::run(int argc, char* argv[])
+{
+    // 工作进程不显示窗口，但节点模型依赖 QWidget，仍需要 QApplication
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+
+    const QStringList arguments = app.arguments();
+    const int flagIndex = arguments.indexOf(CommandLineFlag);
+    if (flagIndex < 0 || flagIndex + 2 >= arguments.size()) {
+        qCCritical(lcExec) << "工作进程参数错误:" << arguments;
+        return 2;
+    }
+
+    ExecutorWorker worker;
+    if (!worker.start(arguments[flagIndex + 1], arguments[flagIndex + 2].toInt())) {
+        return 1;
+    }
+    return app.exec();
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_EXECUTORWORKER_H
+#define NODEEDITORDEMO_EXECUTORWORKER_H
+
+#include "WorkerProtocol.h"
+#include <QByteArray>
+#include <QHash>
+#include <QLocalSocket>
+#include <QObject>
+#include <memory>
+
+class NodeEditorCore;
+
+// 执行工作进程：与编辑器是同一个可执行文件，以 --executor-worker <服务名> <编号> 启动。
+// 进程内持有一份场景镜像（执行器可能需要读取节点参数），按编辑器的请求逐个执行节点，
+// 大结果写入共享内存，等编辑器附加后再释放。连接断开时退出。
+class ExecutorWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr const char* CommandLineFlag = "--executor-worker";
+
+    explicit ExecutorWorker(QObject* parent = nullptr);
+    ~ExecutorWorker();
+
+    bool start(const QString& serverName, int index);
+
+    // main() 中检测到命令行标志时调用，进入工作进程的事件循环
+    static int run(int argc, char* argv[]);
+
+private:
+    void onReadyRead();
+    void handleFrame(const QByteArray& frame);
+    void send(const QByteArray& payload);
+
+private:
+    std::unique_ptr<NodeEditorCore> m_core;
+    QLocalSocket m_socket;
+    QByteArray m_buffer;
+    QString m_sceneError;   // 最近一次同步的场景加载失败时非空，此时拒绝执行节点
+    // 已发送给编辑器、尚未确认附加的结果段
+    QHash<QString, std::shared_ptr<QSharedMemory>> m_pendingSegments;
+};
+
+#endif // NODEEDITORDEMO_EXECUTORWORKER_H
\ No newline at end of file
@@ -0,0 +1,455 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "ExecutorWorkerPool.h"
+#include "ExecutorWorker.h"
+#include "Logging.h"
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QEventLoop>
+#include <QJsonDocument>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QProcess>
+#include <QTimer>
+#include <algorithm>
+
+namespace {
+
+constexpr int ConnectTimeoutMs = 10000;
+constexpr int RestartDelayMs = 500;
+
+} // namespace
+
+ExecutorWorkerPool::ExecutorWorkerPool(int workerCount, QObject* parent)
+    : QObject(parent)
+    , m_server(new QLocalServer(this))
+    , m_workers(static_cast<size_t>(std::max(1, workerCount)))
+{
+    connect(m_server, &QLocalServer::newConnection, this, &ExecutorWorkerPool::onNewConnection);
+}
+
+ExecutorWorkerPool::~ExecutorWorkerPool()
+{
+    m_shuttingDown = true;
+    for (Worker& worker : m_workers) {
+        if (worker.process) {
+            worker.process->disconnect(this);
+            worker.process->kill();
+            worker.process->waitForFinished(1000);
+        }
+    }
+}
+
+bool ExecutorWorkerPool::start(QString* error)
+{
+    const QString serverName = QString("nodeeditor-workers-%1-%2")
+                                   .arg(QCoreApplication::applicationPid())
+                                   .arg(reinterpret_cast<quintptr>(this), 0, 16);
+    QLocalServer::removeServer(serverName);
+    // 只允许当前用户连接，避免其他用户冒充工作进程
+    m_server->setSocketOptions(QLocalServer::UserAccessOption);
+    if (!m_server->listen(serverName)) {
+        if (error) *error = QString("无法监听本地套接字: %1").arg(m_server->errorString());
+        return false;
+    }
+
+    for (int index = 0; index < workerCount(); ++index) {
+        spawn(index);
+    }
+
+    QEventLoop loop;
+    QTimer timeout;
+    timeout.setSingleShot(true);
+    connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
+    QTimer poll;
+    connect(&poll, &QTimer::timeout, &loop, [this, &loop]() {
+        if (allConnected()) loop.quit();
+    });
+    timeout.start(ConnectTimeoutMs);
+    poll.start(20);
+    loop.exec(QEventLoop::ExcludeUserInputEvents);
+
+    if (!allConnected()) {
+        if (error) *error = "工作进程启动超时";
+        return false;
+    }
+    qCDebug(lcExec) << "工作进程池已启动，进程数:" << workerCount();
+    return true;
+}
+
+void ExecutorWorkerPool::spawn(int index)
+{
+    Worker& worker = m_workers[index];
+    worker.process = new QProcess(this);
+    // 工作进程运行在临时目录，不继承编辑器的标准输入
+    worker.process->setWorkingDirectory(QDir::tempPath());
+    worker.process->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    worker.process->setStandardInputFile(QProcess::nullDevice());
+    worker.process->setStandardOutputFile(QProcess::nullDevice());
+
+    connect(worker.process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this,
+            [this, index](int exitCode, QProcess::ExitStatus) {
+                onWorkerLost(index, QString("工作进程退出，退出码 %1").arg(exitCode));
+            });
+    connect(worker.process, &QProcess::errorOccurred, this, [this, index](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart) {
+            onWorkerLost(index, "工作进程无法启动");
+        }
+    });
+
+    worker.process->start(QCoreApplication::applicationFilePath(),
+                          {ExecutorWorker::CommandLineFlag, m_server->serverName(), QString::number(index)});
+}
+
+void ExecutorWorkerPool::onNewConnection()
+{
+    while (QLocalSocket* socket = m_server->nextPendingConnection()) {
+        m_handshakes.insert(socket, QByteArray());
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket]() { onReadyRead(socket); });
+        connect(socket, &QLocalSocket::disconnected, this, [this, socket]() {
+            const int index = workerIndexOf(socket);
+            if (index >= 0) {
+                onWorkerLost(index, "工作进程断开连接");
+            } else {
+                m_handshakes.remove(socket);
+                socket->deleteLater();
+            }
+        });
+    }
+}
+
+void ExecutorWorkerPool::onReadyRead(QLocalSocket* socket)
+{
+    int index = workerIndexOf(socket);
+    QByteArray frame;
+
+    if (index < 0) {
+        auto it = m_handshakes.find(socket);
+        if (it == m_handshakes.end()) return;
+        it->append(socket->readAll());
+        if (!WorkerProtocol::takeFrame(*it, frame)) return;
+
+        QDataStream stream(frame);
+        stream.setVersion(WorkerProtocol::StreamVersion);
+        quint8 type = 0;
+        quint32 workerIndex = 0;
+        stream >> type >> workerIndex;
+        if (type != WorkerProtocol::Hello || workerIndex >= m_workers.size()
+            || !m_workers[workerIndex].process || m_workers[workerIndex].socket) {
+            qCWarning(lcExec) << "拒绝未知的工作进程连接";
+            m_handshakes.remove(socket);
+            socket->disconnectFromServer();
+            return;
+        }
+
+        index = static_cast<int>(workerIndex);
+        Worker& worker = m_workers[index];
+        worker.socket = socket;
+        worker.buffer = m_handshakes.take(socket);
+        worker.hasScene = false;
+        qCDebug(lcExec) << "工作进程" << index << "已就绪";
+        dispatch();
+    } else {
+        m_workers[index].buffer.append(socket->readAll());
+    }
+
+    while (index >= 0 && m_workers[index].socket == socket
+           && WorkerProtocol::takeFrame(m_workers[index].buffer, frame)) {
+        handleFrame(index, frame);
+    }
+}
+
+void ExecutorWorkerPool::handleFrame(int index, const QByteArray& frame)
+{
+    Worker& worker = m_workers[index];
+    QDataStream stream(frame);
+    stream.setVersion(WorkerProtocol::StreamVersion);
+    quint8 type = 0;
+    stream >> type;
+    if (type == WorkerProtocol::SceneError) {
+        // 场景镜像不可用，本轮执行失败；下次分派时重新同步
+        quint64 runId = 0;
+        QString error;
+        stream >> runId >> error;
+        worker.hasScene = false;
+        qCWarning(lcExec) << "工作进程" << index << "同步场景失败:" << error;
+        if (m_context && runId == m_runId) {
+            fail(QString("工作进程 %1 同步场景失败: %2").arg(index).arg(error));
+        }
+        return;
+    }
+    if (type != WorkerProtocol::Result) {
+        qCWarning(lcExec) << "编辑器收到未知消息:" << type;
+        return;
+    }
+
+    quint64 taskId = 0;
+    bool ok = false;
+    stream >> taskId >> ok;
+    if (taskId != worker.taskId) {
+        qCWarning(lcExec) << "工作进程" << index << "返回了未知任务" << taskId;
+        return;
+    }
+
+    NodeValue value;
+    QString error;
+    QStringList attached;
+    if (ok) {
+        try {
+            value = WorkerProtocol::readValue(stream, &attached);
+        } catch (const std::exception& e) {
+            ok = false;
+            error = QString::fromUtf8(e.what());
+        }
+    } else {
+        stream >> error;
+    }
+
+    // 结果段已经附加（或附加失败），通知工作进程释放自己的引用
+    for (const QString& key : attached) {
+        QByteArray payload;
+        QDataStream release(&payload, QIODevice::WriteOnly);
+        release.setVersion(WorkerProtocol::StreamVersion);
+        release << quint8(WorkerProtocol::ReleaseSegment) << key;
+        send(index, payload);
+    }
+
+    worker.timer->stop();
+    worker.inputSegments.clear();
+    const int slot = worker.slot;
+    const bool currentRun = m_context && worker.runId == m_runId;
+    worker.taskId = 0;
+    worker.slot = -1;
+
+    if (currentRun && !m_failed) {
+        if (ok) {
+            m_context->results[slot] = std::move(value);
+            finishSlot(slot);
+        } else {
+            fail(QString("节点 %1 执行失败: %2").arg(m_context->nodeId(slot)).arg(error));
+        }
+    }
+    dispatch();
+}
+
+void ExecutorWorkerPool::onWorkerLost(int index, const QString& reason)
+{
+    Worker& worker = m_workers[index];
+    if (!worker.process) return;
+
+    qCWarning(lcExec) << "工作进程" << index << "失效:" << reason;
+
+    if (worker.taskId != 0 && m_context && worker.runId == m_runId) {
+        fail(QString("节点 %1 执行失败: %2").arg(m_context->nodeId(worker.slot)).arg(reason));
+    }
+
+    worker.process->disconnect(this);
+    worker.process->kill();
+    worker.process->deleteLater();
+    worker.process = nullptr;
+    if (worker.socket) {
+        worker.socket->disconnect(this);
+        worker.socket->abort();
+        worker.socket->deleteLater();
+        worker.socket = nullptr;
+    }
+    if (worker.timer) {
+        worker.timer->stop();
+    }
+    worker.buffer.clear();
+    worker.hasScene = false;
+    worker.taskId = 0;
+    worker.slot = -1;
+    worker.inputSegments.clear();
+
+    if (!m_shuttingDown) {
+        QTimer::singleShot(RestartDelayMs, this, [this, index]() {
+            if (!m_shuttingDown && !m_workers[index].process) {
+                qCDebug(lcExec) << "重启工作进程" << index;
+                spawn(index);
+            }
+        });
+    }
+}
+
+bool ExecutorWorkerPool::run(ExecutionContext& context, const QJsonObject& scene, QString* error)
+{
+    bool anyConnected = false;
+    for (const Worker& worker : m_workers) {
+        anyConnected = anyConnected || worker.socket;
+    }
+    if (!anyConnected) {
+        if (error) *error = "没有可用的工作进程";
+        return false;
+    }
+
+    const GraphSnapshot& graph = context.graph();
+    const int nodeCount = context.nodeCount();
+
+    m_context = &context;
+    ++m_runId;
+    m_sceneJson = QJsonDocument(scene).toJson(QJsonDocument::Compact);
+    m_sceneHash = QCryptographicHash::hash(m_sceneJson, QCryptographicHash::Sha1);
+    m_failed = false;
+    m_error.clear();
+    m_remaining = nodeCount;
+    m_ready.clear();
+    m_pendingInputs.resize(nodeCount);
+    m_pendingConsumers.resize(nodeCount);
+    m_releasable.assign(nodeCount, 0);
+    for (int slot : context.releaseSlots) {
+        m_releasable[slot] = 1;
+    }
+    for (int slot = 0; slot < nodeCount; ++slot) {
+        m_pendingInputs[slot] = graph.inDegree(slot);
+        m_pendingConsumers[slot] = graph.outDegree(slot);
+    }
+    // 按计划顺序放入就绪队列，保证多次执行的分派顺序一致
+    for (int slot : context.order) {
+        if (m_pendingInputs[slot] == 0) {
+            m_ready.push_back(slot);
+        }
+    }
+
+    dispatch();
+    if (m_remaining > 0 && !m_failed) {
+        QEventLoop loop;
+        m_loop = &loop;
+        loop.exec(QEventLoop::ExcludeUserInputEvents);
+        m_loop = nullptr;
+    }
+
+    const bool success = !m_failed && m_remaining == 0;
+    if (!success && error) {
+        *error = m_error;
+    }
+    m_context = nullptr;
+    m_sceneJson.clear();
+    return success;
+}
+
+void ExecutorWorkerPool::dispatch()
+{
+    if (!m_context || m_failed) return;
+
+    for (int index = 0; index < workerCount() && !m_ready.empty(); ++index) {
+        const Worker& worker = m_workers[index];
+        if (!worker.socket || worker.taskId != 0) continue;
+
+        const int slot = m_ready.front();
+        m_ready.pop_front();
+        if (!sendTask(index, slot)) return;
+    }
+}
+
+bool ExecutorWorkerPool::sendTask(int index, int slot)
+{
+    Worker& worker = m_workers[index];
+    const NodeId nodeId = m_context->nodeId(slot);
+
+    if (!worker.hasScene || worker.sceneHash != m_sceneHash) {
+        QByteArray payload;
+        QDataStream stream(&payload, QIODevice::WriteOnly);
+        stream.setVersion(WorkerProtocol::StreamVersion);
+        stream << quint8(WorkerProtocol::SyncScene) << m_runId << m_sceneJson;
+        send(index, payload);
+        worker.hasScene = true;
+        worker.sceneHash = m_sceneHash;
+    }
+
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(WorkerProtocol::StreamVersion);
+    const NodeInputs inputs = m_context->inputsOf(slot);
+    const quint64 taskId = ++m_nextTaskId;
+    stream << quint8(WorkerProtocol::Execute) << taskId << qint64(nodeId) << quint32(inputs.size());
+
+    try {
+        for (PortIndex port = 0; port < inputs.size(); ++port) {
+            WorkerProtocol::writeValue(stream, inputs[port], &worker.inputSegments);
+        }
+    } catch (const std::exception& e) {
+        worker.inputSegments.clear();
+        fail(QString("节点 %1 的输入无法发送: %2").arg(nodeId).arg(e.what()));
+        return false;
+    }
+
+    worker.taskId = taskId;
+    worker.slot = slot;
+    worker.runId = m_runId;
+    send(index, payload);
+
+    if (m_taskTimeoutMs > 0) {
+        if (!worker.timer) {
+            worker.timer = new QTimer(this);
+            worker.timer->setSingleShot(true);
+            connect(worker.timer, &QTimer::timeout, this, [this, index]() {
+                onWorkerLost(index, "节点执行超时");
+            });
+        }
+        worker.timer->start(m_taskTimeoutMs);
+    }
+    return true;
+}
+
+void ExecutorWorkerPool::send(int index, const QByteArray& payload)
+{
+    QLocalSocket* socket = m_workers[index].socket;
+    if (!socket) return;
+    WorkerProtocol::writeFrame(socket, payload);
+    socket->flush();
+}
+
+void ExecutorWorkerPool::fail(const QString& error)
+{
+    if (m_failed) return;
+    m_failed = true;
+    m_error = error;
+    m_ready.clear();
+    if (m_loop) {
+        m_loop->quit();
+    }
+}
+
+void ExecutorWorkerPool::finishSlot(int slot)
+{
+    ExecutionContext& context = *m_context;
+    const GraphSnapshot& graph = context.graph();
+    emit nodeFinished(context.nodeId(slot));
+    --m_remaining;
+
+    for (const GraphEdge* edge = graph.outBegin(slot); edge != graph.outEnd(slot); ++edge) {
+        if (--m_pendingInputs[edge->node] == 0) {
+            m_ready.push_back(edge->node);
+        }
+    }
+    // 所有消费者都执行完后释放上游结果，规则与进程内执行一致
+    for (const GraphEdge* edge = graph.inBegin(slot); edge != graph.inEnd(slot); ++edge) {
+        if (--m_pendingConsumers[edge->node] == 0 && m_releasable[edge->node]) {
+            context.results[edge->node].reset();
+        }
+    }
+
+    if (m_remaining == 0 && m_loop) {
+        m_loop->quit();
+    }
+}
+
+int ExecutorWorkerPool::workerIndexOf(QLocalSocket* socket) const
+{
+    for (int index = 0; index < workerCount(); ++index) {
+        if (m_workers[index].socket == socket) return index;
+    }
+    return -1;
+}
+
+bool ExecutorWorkerPool::allConnected() const
+{
+    for (const Worker& worker : m_workers) {
+        if (!worker.socket) return false;
+    }
+    return true;
+}
\ No newline at end of file
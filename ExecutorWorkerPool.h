@@ -0,0 +1,100 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_EXECUTORWORKERPOOL_H
+#define NODEEDITORDEMO_EXECUTORWORKERPOOL_H
+
+#include "ExecutionContext.h"
+#include "WorkerProtocol.h"
+#include <QByteArray>
+#include <QHash>
+#include <QJsonObject>
+#include <QObject>
+#include <deque>
+#include <vector>
+
+class QEventLoop;
+class QLocalServer;
+class QLocalSocket;
+class QProcess;
+class QTimer;
+
+// 进程外执行：一组本地工作进程（见 ExecutorWorker），通过 QLocalSocket 分派节点，
+// 大于 WorkerProtocol::InlineBufferLimit 的缓冲区经共享内存传递，不做序列化。
+// 工作进程崩溃、断开或单个节点超时都只让本次执行失败，进程随后自动重启。
+class ExecutorWorkerPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ExecutorWorkerPool(int workerCount, QObject* parent = nullptr);
+    ~ExecutorWorkerPool();
+
+    // 启动所有工作进程并等待它们连接
+    bool start(QString* error = nullptr);
+    int workerCount() const { return static_cast<int>(m_workers.size()); }
+
+    // 单个节点的最长执行时间，超时后结束该工作进程；<= 0 表示不限制
+    void setTaskTimeout(int milliseconds) { m_taskTimeoutMs = milliseconds; }
+
+    // 按 context 的计划执行一轮，结果写入 context.results，释放规则与进程内执行相同。
+    // 节点参数不一定改变图结构，工作进程镜像的场景按内容比较，不一致时先同步 scene。
+    // 执行期间运行局部事件循环（排除用户输入），阻塞直到完成或失败。
+    bool run(ExecutionContext& context, const QJsonObject& scene, QString* error = nullptr);
+
+signals:
+    void nodeFinished(NodeId nodeId);
+
+private:
+    struct Worker
+    {
+        QProcess* process = nullptr;
+        QLocalSocket* socket = nullptr;
+        QTimer* timer = nullptr;
+        QByteArray buffer;
+        bool hasScene = false;
+        QByteArray sceneHash;
+        quint64 taskId = 0;          // 0 表示空闲
+        int slot = -1;
+        quint64 runId = 0;
+        WorkerProtocol::Segments inputSegments;   // 当前任务输入的共享内存段，收到结果后释放
+    };
+
+    void spawn(int index);
+    void onNewConnection();
+    void onReadyRead(QLocalSocket* socket);
+    void handleFrame(int index, const QByteArray& frame);
+    void onWorkerLost(int index, const QString& reason);
+    void dispatch();
+    bool sendTask(int index, int slot);
+    void send(int index, const QByteArray& payload);
+    void fail(const QString& error);
+    void finishSlot(int slot);
+    int workerIndexOf(QLocalSocket* socket) const;
+    bool allConnected() const;
+
+private:
+    QLocalServer* m_server = nullptr;
+    std::vector<Worker> m_workers;
+    QHash<QLocalSocket*, QByteArray> m_handshakes;   // 已连接但尚未发送 Hello 的套接字
+    bool m_shuttingDown = false;
+    int m_taskTimeoutMs = 30000;
+    quint64 m_nextTaskId = 0;
+
+    // 单轮执行状态
+    ExecutionContext* m_context = nullptr;
+    quint64 m_runId = 0;
+    QByteArray m_sceneJson;
+    QByteArray m_sceneHash;
+    std::vector<int> m_pendingInputs;
+    std::vector<int> m_pendingConsumers;
+    std::vector<char> m_releasable;
+    std::deque<int> m_ready;
+    int m_remaining = 0;
+    bool m_failed = false;
+    QString m_error;
+    QEventLoop* m_loop = nullptr;
+};
+
+#endif // NODEEDITORDEMO_EXECUTORWORKERPOOL_H
\ No newline at end of file
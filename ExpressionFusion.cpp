@@ -0,0 +1,204 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "ExpressionFusion.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+bool FusedProgram::scalarInputs() const
+{
+    for (const NodeValue* input : inputs) {
+        switch (input->kind()) {
+        case NodeValue::Kind::Empty:
+        case NodeValue::Kind::Bool:
+        case NodeValue::Kind::Int:
+        case NodeValue::Kind::Double:
+            break;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+double FusedProgram::evaluate(double* stack) const
+{
+    int top = -1;
+    for (const Instruction& instruction : code) {
+        switch (instruction.code) {
+        case LoadInput:
+            stack[++top] = inputs[instruction.operand]->toDouble();
+            break;
+        case LoadZero:
+            stack[++top] = 0.0;
+            break;
+        default: {
+            const FusableOp op = static_cast<FusableOp>(instruction.code);
+            if (ExpressionFusion::arity(op) == 1) {
+                stack[top] = ExpressionFusion::apply(op, stack[top], 0.0);
+            } else {
+                stack[top - 1] = ExpressionFusion::apply(op, stack[top - 1], stack[top]);
+                --top;
+            }
+            break;
+        }
+        }
+    }
+    return stack[0];
+}
+
+int ExpressionFusion::arity(FusableOp op)
+{
+    switch (op) {
+    case FusableOp::None: return 0;
+    case FusableOp::Identity:
+    case FusableOp::Negate:
+    case FusableOp::Abs: return 1;
+    default: return 2;
+    }
+}
+
+double ExpressionFusion::apply(FusableOp op, double a, double b)
+{
+    switch (op) {
+    case FusableOp::Identity: return a;
+    case FusableOp::Negate: return -a;
+    case FusableOp::Abs: return std::fabs(a);
+    case FusableOp::Add: return a + b;
+    case FusableOp::Subtract: return a - b;
+    case FusableOp::Multiply: return a * b;
+    case FusableOp::Divide: return a / b;
+    // 与列内核一致：比较不成立（含 NaN、±0）时取 b
+    case FusableOp::Min: return a < b ? a : b;
+    case FusableOp::Max: return a > b ? a : b;
+    default: return 0.0;
+    }
+}
+
+TypedNodeExecutor ExpressionFusion::makeExecutor(FusableOp op)
+{
+    return [op](NodeId, const NodeInputs& inputs) -> NodeValue {
+        if (op == FusableOp::None) {
+            throw std::runtime_error("节点没有可执行的运算");
+        }
+        return NodeValue(apply(op, inputs[0].toDouble(), inputs[1].toDouble()));
+    };
+}
+
+void ExpressionFusion::clear()
+{
+    m_root.clear();
+    m_program.clear();
+    m_ops.clear();
+    m_programs.clear();
+    m_fusedNodeCount = 0;
+}
+
+void ExpressionFusion::build(const GraphSnapshot& graph, const std::vector<int>& order,
+                             const std::vector<FusableOp>& slotOps, const QSet<NodeId>& observed,
+                             const std::vector<NodeValue>& results)
+{
+    clear();
+    const int n = graph.nodeCount();
+    m_ops = slotOps;
+    m_root.assign(n, GraphSnapshot::InvalidSlot);
+    m_program.assign(n, NotFused);
+    m_hasInterior.assign(n, 0);
+
+    // 1. 逆拓扑序分组：消费者先确定所属的组，唯一消费者可融合时并入它的组
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        const int slot = *it;
+        if (m_ops[slot] == FusableOp::None) continue;
+
+        m_root[slot] = slot;
+        if (graph.outDegree(slot) != 1 || observed.contains(graph.nodeId(slot))) continue;
+
+        const GraphEdge& out = *graph.outBegin(slot);
+        const FusableOp consumerOp = m_ops[out.node];
+        if (consumerOp == FusableOp::None || out.peerPort >= static_cast<PortIndex>(arity(consumerOp))) continue;
+
+        m_root[slot] = m_root[out.node];
+        m_hasInterior[m_root[slot]] = 1;
+    }
+
+    // 2. 只有两个及以上节点的组才值得融合；成员按执行顺序收集
+    m_inputIndex.assign(n, -1);
+    for (int slot : order) {
+        const int root = m_root[slot];
+        if (root == GraphSnapshot::InvalidSlot) continue;
+        if (!m_hasInterior[root]) {
+            m_root[slot] = GraphSnapshot::InvalidSlot;
+            continue;
+        }
+
+        if (m_inputIndex[root] < 0) {
+            m_inputIndex[root] = static_cast<int>(m_programs.size());
+            m_programs.emplace_back();
+        }
+        m_programs[m_inputIndex[root]].members.push_back(slot);
+        m_program[slot] = (slot == root) ? m_inputIndex[root] : FusedAway;
+    }
+
+    // 3. 编译
+    m_inputIndex.assign(n, -1);
+    int stackDepth = 0;
+    for (FusedProgram& program : m_programs) {
+        compile(graph, program.members.back(), program, results);
+        stackDepth = std::max(stackDepth, program.stackDepth);
+        m_fusedNodeCount += static_cast<int>(program.members.size());
+    }
+    m_stack.assign(stackDepth, 0.0);
+}
+
+void ExpressionFusion::compile(const GraphSnapshot& graph, int root, FusedProgram& program,
+                               const std::vector<NodeValue>& results)
+{
+    // 后序遍历生成栈式字节码；用显式栈代替递归，长链不会耗尽调用栈
+    int depth = 0;
+    m_walk.clear();
+    m_walk.emplace_back(root, 0);
+    while (!m_walk.empty()) {
+        const int slot = m_walk.back().first;
+        const FusableOp op = m_ops[slot];
+
+        if (m_walk.back().second >= arity(op)) {
+            program.code.push_back({static_cast<quint8>(op), 0});
+            depth -= arity(op) - 1;
+            m_walk.pop_back();
+            continue;
+        }
+
+        const PortIndex port = static_cast<PortIndex>(m_walk.back().second++);
+        const GraphEdge* source = nullptr;
+        for (const GraphEdge* edge = graph.inBegin(slot); edge != graph.inEnd(slot); ++edge) {
+            if (edge->port == port) {
+                source = edge;
+                break;
+            }
+        }
+
+        if (source && source->node != root && m_root[source->node] == root) {
+            m_walk.emplace_back(source->node, 0);
+            continue;
+        }
+
+        if (!source) {
+            program.code.push_back({FusedProgram::LoadZero, 0});
+        } else {
+            int& index = m_inputIndex[source->node];
+            if (index < 0) {
+                index = static_cast<int>(program.inputs.size());
+                program.inputs.push_back(&results[source->node]);
+            }
+            program.code.push_back({FusedProgram::LoadInput, index});
+        }
+        program.stackDepth = std::max(program.stackDepth, ++depth);
+    }
+
+    // 输入下标只在当前程序内有效
+    for (const NodeValue* input : program.inputs) {
+        m_inputIndex[input - results.data()] = -1;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_EXPRESSIONFUSION_H
+#define NODEEDITORDEMO_EXPRESSIONFUSION_H
+
+#include "GraphSnapshot.h"
+#include "NodeValue.h"
+#include <QSet>
+#include <functional>
+#include <vector>
+
+// 可融合的纯运算：输入按 double 计算，单目运算只读端口 0，双目运算读端口 0 和 1
+enum class FusableOp : quint8
+{
+    None,       // 不可融合
+    Identity,
+    Negate,
+    Abs,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Min,
+    Max
+};
+
+// 按节点保存的状态解析运算（同一类型的节点可以有不同运算，例如可切换运算符的数学节点）
+// 构建执行计划时调用，组节点子图中的节点同样适用
+using FusableResolver = std::function<FusableOp(const QJsonObject& state)>;
+using FusableResolverTable = NodeTypeTable<FusableResolver>;
+
+// 融合后的内核：一段基于栈的字节码，输入直接引用 ExecutionContext::results 中的上游结果
+struct FusedProgram
+{
+    enum Code : quint8
+    {
+        LoadInput = 0xF0,   // 压入 inputs[operand]
+        LoadZero            // 未连接的端口
+        // 其余取值为 FusableOp
+    };
+
+    struct Instruction
+    {
+        quint8 code;
+        int operand;
+    };
+
+    std::vector<Instruction> code;
+    std::vector<const NodeValue*> inputs;
+    std::vector<int> members;   // 融合进来的槽位，按执行顺序排列，最后一个为根节点
+    int stackDepth = 0;
+
+    // 输入全部是数值标量时才能走融合内核，否则（例如列数据）逐节点执行
+    bool scalarInputs() const;
+    double evaluate(double* stack) const;
+};
+
+// 表达式融合：把由可融合节点组成的链或树编译为一个内核。
+// 中间节点只有一个消费者、该消费者也可融合、且结果没有被固定时才会并入下游；
+// 并入的节点不再单独执行，也不保留结果。
+class ExpressionFusion
+{
+public:
+    static constexpr int NotFused = -1;
+    static constexpr int FusedAway = -2;
+
+    static int arity(FusableOp op);
+    static double apply(FusableOp op, double a, double b);
+    // 与融合内核语义一致的逐节点执行器，融合不可用时（分析模式、列输入等）使用
+    static TypedNodeExecutor makeExecutor(FusableOp op);
+
+    // results 的大小在下次 build 之前不能改变，程序输入直接指向其中的元素
+    void build(const GraphSnapshot& graph, const std::vector<int>& order,
+               const std::vector<FusableOp>& slotOps, const QSet<NodeId>& observed,
+               const std::vector<NodeValue>& results);
+    void clear();
+
+    bool isEmpty() const { return m_programs.empty(); }
+    int programCount() const { return static_cast<int>(m_programs.size()); }
+    // 根节点返回程序下标；已并入下游的节点返回 FusedAway；其余返回 NotFused
+    int programOf(int slot) const { return m_program.empty() ? NotFused : m_program[slot]; }
+    // 节点所属融合组的根槽位，未融合时为 GraphSnapshot::InvalidSlot
+    int rootOf(int slot) const { return m_root.empty() ? GraphSnapshot::InvalidSlot : m_root[slot]; }
+    const FusedProgram& program(int index) const { return m_programs[index]; }
+    int fusedNodeCount() const { return m_fusedNodeCount; }
+
+    double evaluate(int index) const { return m_programs[index].evaluate(m_stack.data()); }
+
+private:
+    void compile(const GraphSnapshot& graph, int root, FusedProgram& program,
+                 const std::vector<NodeValue>& results);
+
+    std::vector<int> m_root;
+    std::vector<int> m_program;
+    std::vector<FusableOp> m_ops;
+    std::vector<FusedProgram> m_programs;
+    int m_fusedNodeCount = 0;
+
+    // 编译与求值的临时数组，复用容量
+    mutable std::vector<double> m_stack;
+    std::vector<std::pair<int, int>> m_walk;
+    std::vector<int> m_inputIndex;
+    std::vector<char> m_hasInterior;
+};
+
+#endif // NODEEDITORDEMO_EXPRESSIONFUSION_H
\ No newline at end of file
@@ -0,0 +1,492 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "FlowValidator.h"
+#include "NodeEditorCore.h"
+#include "Logging.h"
+#include <QtNodes/NodeData>
+#include <QtConcurrent/QtConcurrentRun>
+#include <QVarLengthArray>
+
+namespace {
+
+const NodeTypeId StartNodeType = NodeTypeIds::intern(QStringLiteral("StartNode"));
+const NodeTypeId EndNodeType = NodeTypeIds::intern(QStringLiteral("EndNode"));
+
+FlowDiagnostic makeDiagnostic(FlowDiagnostic::Severity severity, FlowDiagnostic::Kind kind,
+                              NodeId nodeId, PortIndex port, const QString& message)
+{
+    FlowDiagnostic diagnostic;
+    diagnostic.severity = severity;
+    diagnostic.kind = kind;
+    diagnostic.nodeId = nodeId;
+    diagnostic.port = port;
+    diagnostic.message = message;
+    return diagnostic;
+}
+
+void countDiagnostics(const QList<FlowDiagnostic>& diagnostics, int sign, int& errors, int& warnings)
+{
+    for (const FlowDiagnostic& diagnostic : diagnostics) {
+        if (diagnostic.severity == FlowDiagnostic::Severity::Error) {
+            errors += sign;
+        } else {
+            warnings += sign;
+        }
+    }
+}
+
+} // namespace
+
+FlowValidator::FlowValidator(NodeEditorCore& core, QObject* parent)
+    : QObject(parent)
+    , m_core(core)
+{
+    m_debounce.setSingleShot(true);
+    m_debounce.setInterval(200);
+    connect(&m_debounce, &QTimer::timeout, this, &FlowValidator::startValidation);
+    // 整图检查要重建快照，连续编辑时合并到停顿之后再做
+    m_globalDebounce.setSingleShot(true);
+    m_globalDebounce.setInterval(1000);
+    connect(&m_globalDebounce, &QTimer::timeout, this, &FlowValidator::startGlobalValidation);
+    connect(&m_watcher, &QFutureWatcher<FlowValidationResult>::finished, this, &FlowValidator::applyResult);
+
+    if (auto model = m_core.graphModel()) {
+        connectModel(*model);
+    }
+}
+
+FlowValidator::~FlowValidator()
+{
+    m_watcher.waitForFinished();
+}
+
+void FlowValidator::connectModel(DataFlowGraphModel& model)
+{
+    // 只记录受影响的节点，不在编辑路径上做任何检查
+    connect(&model, &DataFlowGraphModel::nodeCreated, this, &FlowValidator::invalidateNode);
+    connect(&model, &DataFlowGraphModel::nodeDeleted, this, &FlowValidator::invalidateNode);
+    connect(&model, &DataFlowGraphModel::connectionCreated, this, [this](ConnectionId const& connectionId) {
+        invalidateNode(connectionId.inNodeId);
+    });
+    connect(&model, &DataFlowGraphModel::connectionDeleted, this, [this](ConnectionId const& connectionId) {
+        invalidateNode(connectionId.inNodeId);
+    });
+}
+
+void FlowValidator::setAutoValidate(bool enabled)
+{
+    m_autoValidate = enabled;
+    if (!enabled) {
+        m_debounce.stop();
+        m_globalDebounce.stop();
+    }
+}
+
+void FlowValidator::invalidateNode(NodeId nodeId)
+{
+    m_globalPending = true;
+    if (!m_fullPending) {
+        m_dirtyNodes.insert(nodeId);
+        // 大批量编辑时直接改为完整校验，不再维护巨大的脏节点集合
+        if (m_dirtyNodes.size() > MaxIncrementalNodes) {
+            m_fullPending = true;
+            m_dirtyNodes.clear();
+        }
+    }
+    scheduleValidation();
+}
+
+void FlowValidator::invalidateAll()
+{
+    m_fullPending = true;
+    m_dirtyNodes.clear();
+    scheduleValidation();
+}
+
+void FlowValidator::validateAll()
+{
+    m_fullPending = true;
+    m_dirtyNodes.clear();
+    m_debounce.stop();
+    m_globalDebounce.stop();
+    startValidation();
+}
+
+void FlowValidator::scheduleValidation()
+{
+    if (m_autoValidate) {
+        m_debounce.start();
+    }
+}
+
+void FlowValidator::startValidation()
+{
+    // 上一轮尚未结束时只记下需要再跑一次，结束后合并所有积累的变化；
+    // 进行中的完整校验会整体替换局部结果，期间不能先写入实时检查的结果
+    if (m_watcher.isRunning()) {
+        m_pending = true;
+        return;
+    }
+    if (m_fullPending) {
+        startJob(true);
+        return;
+    }
+    if (!m_dirtyNodes.isEmpty()) {
+        checkDirtyNodes();
+    }
+    if (m_globalPending && m_autoValidate) {
+        m_globalDebounce.start();
+    }
+}
+
+void FlowValidator::startGlobalValidation()
+{
+    if (m_watcher.isRunning()) {
+        m_pending = true;
+        return;
+    }
+    if (m_fullPending) {
+        startJob(true);
+        return;
+    }
+    if (m_globalPending) {
+        startJob(false);
+    }
+}
+
+void FlowValidator::startJob(bool full)
+{
+    // 只有这里需要快照：完整校验，或编辑停顿后的整图检查
+    auto job = std::make_shared<FlowValidationJob>();
+    job->snapshot = m_core.graphSnapshot();
+    job->executorTypes = m_core.executorTypes();
+    job->full = full;
+    if (full) {
+        m_fullPending = false;
+        m_dirtyNodes.clear();
+    }
+    m_globalPending = false;
+
+    qCDebug(lcGraph) << "开始后台校验 - 版本:" << job->snapshot->version()
+                     << (job->full ? "完整" : "整图检查");
+
+    m_watcher.setFuture(QtConcurrent::run([job]() {
+        return FlowValidator::validate(*job);
+    }));
+}
+
+void FlowValidator::checkDirtyNodes()
+{
+    auto model = m_core.graphModel();
+    if (!model) return;
+
+    FlowValidationResult result;
+    const QSet<NodeTypeId> executorTypes = m_core.executorTypes();
+    result.checkedNodes.assign(m_dirtyNodes.begin(), m_dirtyNodes.end());
+    m_dirtyNodes.clear();
+
+    for (NodeId nodeId : result.checkedNodes) {
+        if (!model->nodeExists(nodeId)) continue;
+        QList<FlowDiagnostic> diagnostics = checkLocal(*model, nodeId, m_core.nodeTypeId(nodeId), executorTypes);
+        if (!diagnostics.isEmpty()) {
+            result.local.insert(nodeId, std::move(diagnostics));
+        }
+    }
+
+    qCDebug(lcGraph) << "局部校验完成 - 节点数:" << result.checkedNodes.size();
+    mergeResult(result);
+}
+
+void FlowValidator::applyResult()
+{
+    FlowValidationResult result = m_watcher.result();
+    mergeResult(result);
+
+    if (m_pending) {
+        m_pending = false;
+        startValidation();
+    }
+}
+
+void FlowValidator::mergeResult(FlowValidationResult& result)
+{
+    // 受影响的节点：本次检查过的节点以及上次/本次带有整图诊断的节点
+    QSet<NodeId> affected;
+    if (result.full) {
+        for (auto it = m_local.constBegin(); it != m_local.constEnd(); ++it) affected.insert(it.key());
+        for (auto it = result.local.constBegin(); it != result.local.constEnd(); ++it) affected.insert(it.key());
+    } else {
+        for (NodeId nodeId : result.checkedNodes) affected.insert(nodeId);
+    }
+    if (result.globalChecked) {
+        for (auto it = m_global.constBegin(); it != m_global.constEnd(); ++it) affected.insert(it.key());
+        for (auto it = result.global.constBegin(); it != result.global.constEnd(); ++it) affected.insert(it.key());
+    }
+
+    QHash<NodeId, QList<FlowDiagnostic>> previous;
+    for (NodeId nodeId : affected) {
+        previous.insert(nodeId, diagnostics(nodeId));
+    }
+
+    if (result.full) {
+        m_local = std::move(result.local);
+    } else {
+        for (NodeId nodeId : result.checkedNodes) {
+            auto it = result.local.find(nodeId);
+            if (it != result.local.end()) {
+                m_local.insert(nodeId, std::move(it.value()));
+            } else {
+                m_local.remove(nodeId);
+            }
+        }
+    }
+    if (result.globalChecked) {
+        m_global = std::move(result.global);
+    }
+
+    int changed = 0;
+    for (NodeId nodeId : affected) {
+        QList<FlowDiagnostic> current = diagnostics(nodeId);
+        const QList<FlowDiagnostic>& before = previous[nodeId];
+        if (current == before) continue;
+
+        countDiagnostics(before, -1, m_errorCount, m_warningCount);
+        countDiagnostics(current, 1, m_errorCount, m_warningCount);
+        ++changed;
+        emit nodeDiagnosticsChanged(nodeId, current);
+    }
+
+    if (result.globalChecked && result.graphDiagnostics != m_graphDiagnostics) {
+        countDiagnostics(m_graphDiagnostics, -1, m_errorCount, m_warningCount);
+        countDiagnostics(result.graphDiagnostics, 1, m_errorCount, m_warningCount);
+        m_graphDiagnostics = std::move(result.graphDiagnostics);
+        emit graphDiagnosticsChanged(m_graphDiagnostics);
+    }
+
+    qCDebug(lcGraph) << "校验完成 - 版本:" << result.version << "诊断变化节点:" << changed
+                     << "错误:" << m_errorCount << "警告:" << m_warningCount;
+    emit validationFinished(m_errorCount, m_warningCount);
+}
+
+QList<FlowDiagnostic> FlowValidator::diagnostics(NodeId nodeId) const
+{
+    QList<FlowDiagnostic> result = m_local.value(nodeId);
+    result += m_global.value(nodeId);
+    return result;
+}
+
+QList<FlowDiagnostic> FlowValidator::allDiagnostics() const
+{
+    QList<FlowDiagnostic> result = m_graphDiagnostics;
+    for (auto it = m_global.constBegin(); it != m_global.constEnd(); ++it) result += it.value();
+    for (auto it = m_local.constBegin(); it != m_local.constEnd(); ++it) result += it.value();
+    return result;
+}
+
+FlowValidationResult FlowValidator::validate(const FlowValidationJob& job)
+{
+    FlowValidationResult result;
+    result.full = job.full;
+    if (!job.snapshot) {
+        return result;
+    }
+
+    const GraphSnapshot& graph = *job.snapshot;
+    result.version = graph.version();
+
+    if (job.full) {
+        result.checkedNodes = graph.nodeIds();
+        for (int slot = 0; slot < graph.nodeCount(); ++slot) {
+            checkLocal(job, slot, result);
+        }
+    } else {
+        result.checkedNodes = job.dirtyNodes;
+        for (NodeId nodeId : job.dirtyNodes) {
+            int slot = graph.slotOf(nodeId);
+            if (slot != GraphSnapshot::InvalidSlot) {
+                checkLocal(job, slot, result);
+            }
+        }
+    }
+
+    checkGlobal(graph, result);
+    result.globalChecked = true;
+    return result;
+}
+
+void FlowValidator::checkLocal(const FlowValidationJob& job, int slot, FlowValidationResult& result)
+{
+    const GraphSnapshot& graph = *job.snapshot;
+    const NodeId nodeId = graph.nodeId(slot);
+    QList<FlowDiagnostic> diagnostics;
+
+    if (!job.executorTypes.contains(graph.nodeTypeId(slot))) {
+        diagnostics.append(makeDiagnostic(FlowDiagnostic::Severity::Error, FlowDiagnostic::Kind::MissingExecutor,
+                                          nodeId, 0,
+                                          QString("节点类型 %1 没有注册执行器").arg(graph.nodeType(slot))));
+    }
+
+    const unsigned int inPorts = graph.inPortCount(slot);
+    QVarLengthArray<bool, 8> connected(static_cast<int>(inPorts));
+    std::fill(connected.begin(), connected.end(), false);
+
+    for (const GraphEdge* edge = graph.inBegin(slot); edge != graph.inEnd(slot); ++edge) {
+        if (edge->port >= inPorts || edge->peerPort >= graph.outPortCount(edge->node)) continue;
+        connected[static_cast<int>(edge->port)] = true;
+
+        int inType = graph.inPortType(slot, edge->port);
+        int outType = graph.outPortType(edge->node, edge->peerPort);
+        if (inType != outType) {
+            diagnostics.append(makeDiagnostic(FlowDiagnostic::Severity::Error, FlowDiagnostic::Kind::TypeMismatch,
+                                              nodeId, edge->port,
+                                              QString("输入端口 %1 类型为 %2，上游节点 %3 输出类型为 %4")
+                                                  .arg(edge->port)
+                                                  .arg(graph.portTypeId(inType))
+                                                  .arg(graph.nodeId(edge->node))
+                                                  .arg(graph.portTypeId(outType))));
+        }
+    }
+
+    for (unsigned int port = 0; port < inPorts; ++port) {
+        if (!connected[static_cast<int>(port)]) {
+            diagnostics.append(makeDiagnostic(FlowDiagnostic::Severity::Warning, FlowDiagnostic::Kind::UnconnectedInput,
+                                              nodeId, port, QString("输入端口 %1 未连接").arg(port)));
+        }
+    }
+
+    if (!diagnostics.isEmpty()) {
+        result.local.insert(nodeId, diagnostics);
+    }
+}
+
+void FlowValidator::checkGlobal(const GraphSnapshot& graph, FlowValidationResult& result)
+{
+    const int n = graph.nodeCount();
+    if (n == 0) return;
+
+    std::vector<int> starts;
+    bool hasEnd = false;
+    for (int slot = 0; slot < n; ++slot) {
+        if (graph.nodeTypeId(slot) == StartNodeType) starts.push_back(slot);
+        else if (graph.nodeTypeId(slot) == EndNodeType) hasEnd = true;
+    }
+    if (starts.empty()) {
+        result.graphDiagnostics.append(makeDiagnostic(FlowDiagnostic::Severity::Error,
+                                                      FlowDiagnostic::Kind::MissingStartNode,
+                                                      InvalidNodeId, 0, "缺少开始节点"));
+    }
+    if (!hasEnd) {
+        result.graphDiagnostics.append(makeDiagnostic(FlowDiagnostic::Severity::Error,
+                                                      FlowDiagnostic::Kind::MissingEndNode,
+                                                      InvalidNodeId, 0, "缺少结束节点"));
+    }
+
+    // 环：正向 Kahn 剥掉所有源点后，再在剩余子图中反向剥掉汇点，剩下的节点都在环上
+    std::vector<int> order;
+    std::vector<int> indegree;
+    if (!graph.topologicalOrder(order, indegree)) {
+        std::vector<int> outdegree(n, 0);
+        std::vector<int> queue;
+        for (int slot = 0; slot < n; ++slot) {
+            if (indegree[slot] == 0) continue;
+            for (const GraphEdge* edge = graph.outBegin(slot); edge != graph.outEnd(slot); ++edge) {
+                if (indegree[edge->node] > 0) ++outdegree[slot];
+            }
+            if (outdegree[slot] == 0) queue.push_back(slot);
+        }
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int slot = queue[head];
+            for (const GraphEdge* edge = graph.inBegin(slot); edge != graph.inEnd(slot); ++edge) {
+                int source = edge->node;
+                if (indegree[source] > 0 && --outdegree[source] == 0) {
+                    queue.push_back(source);
+                }
+            }
+        }
+        std::vector<char> peeled(n, 0);
+        for (int slot : queue) peeled[slot] = 1;
+        for (int slot = 0; slot < n; ++slot) {
+            if (indegree[slot] > 0 && !peeled[slot]) {
+                NodeId nodeId = graph.nodeId(slot);
+                result.global[nodeId].append(makeDiagnostic(FlowDiagnostic::Severity::Error,
+                                                            FlowDiagnostic::Kind::Cycle,
+                                                            nodeId, 0, "节点位于循环依赖中"));
+            }
+        }
+    }
+
+    // 可达性：从所有开始节点沿出边做一次 BFS
+    if (!starts.empty()) {
+        std::vector<char> visited(n, 0);
+        std::vector<int> queue = starts;
+        for (int slot : starts) visited[slot] = 1;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int slot = queue[head];
+            for (const GraphEdge* edge = graph.outBegin(slot); edge != graph.outEnd(slot); ++edge) {
+                if (!visited[edge->node]) {
+                    visited[edge->node] = 1;
+                    queue.push_back(edge->node);
+                }
+            }
+        }
+        for (int slot = 0; slot < n; ++slot) {
+            if (!visited[slot]) {
+                NodeId nodeId = graph.nodeId(slot);
+                result.global[nodeId].append(makeDiagnostic(FlowDiagnostic::Severity::Warning,
+                                                            FlowDiagnostic::Kind::Unreachable,
+                                                            nodeId, 0, "无法从开始节点到达"));
+            }
+        }
+    }
+}
+
+QList<FlowDiagnostic> FlowValidator::checkLocal(const AbstractGraphModel& model, NodeId nodeId, NodeTypeId typeId,
+                                                const QSet<NodeTypeId>& executorTypes)
+{
+    // 与快照上的局部检查给出相同的诊断，只读取本节点的端口和入边
+    QList<FlowDiagnostic> diagnostics;
+    if (typeId == InvalidNodeTypeId) {
+        typeId = NodeTypeIds::intern(model.nodeData(nodeId, NodeRole::Type).toString());
+    }
+
+    if (!executorTypes.contains(typeId)) {
+        diagnostics.append(makeDiagnostic(FlowDiagnostic::Severity::Error, FlowDiagnostic::Kind::MissingExecutor,
+                                          nodeId, 0,
+                                          QString("节点类型 %1 没有注册执行器").arg(NodeTypeIds::name(typeId))));
+    }
+
+    const unsigned int inPorts = model.nodeData(nodeId, NodeRole::InPortCount).toUInt();
+    QVarLengthArray<bool, 8> connected(static_cast<int>(inPorts));
+    std::fill(connected.begin(), connected.end(), false);
+
+    for (PortIndex port = 0; port < inPorts; ++port) {
+        const auto connections = model.connections(nodeId, PortType::In, port);
+        if (connections.empty()) continue;
+        connected[static_cast<int>(port)] = true;
+
+        const QString inType = model.portData(nodeId, PortType::In, port, PortRole::DataType).value<NodeDataType>().id;
+        for (const ConnectionId& connection : connections) {
+            const QString outType = model.portData(connection.outNodeId, PortType::Out, connection.outPortIndex,
+                                                   PortRole::DataType).value<NodeDataType>().id;
+            if (inType != outType) {
+                diagnostics.append(makeDiagnostic(FlowDiagnostic::Severity::Error, FlowDiagnostic::Kind::TypeMismatch,
+                                                  nodeId, port,
+                                                  QString("输入端口 %1 类型为 %2，上游节点 %3 输出类型为 %4")
+                                                      .arg(port)
+                                                      .arg(inType)
+                                                      .arg(connection.outNodeId)
+                                                      .arg(outType)));
+            }
+        }
+    }
+
+    for (unsigned int port = 0; port < inPorts; ++port) {
+        if (!connected[static_cast<int>(port)]) {
+            diagnostics.append(makeDiagnostic(FlowDiagnostic::Severity::Warning, FlowDiagnostic::Kind::UnconnectedInput,
+                                              nodeId, port, QString("输入端口 %1 未连接").arg(port)));
+        }
+    }
+    return diagnostics;
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_FLOWVALIDATOR_H
+#define NODEEDITORDEMO_FLOWVALIDATOR_H
+
+#include "GraphSnapshot.h"
+#include <QtNodes/DataFlowGraphModel>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QTimer>
+#include <memory>
+#include <vector>
+
+using namespace QtNodes;
+
+class NodeEditorCore;
+
+// 单条诊断信息；nodeId 为 InvalidNodeId 时表示整图级别的问题
+struct FlowDiagnostic
+{
+    enum class Severity { Warning, Error };
+    enum class Kind {
+        Cycle,              // 位于循环依赖中
+        Unreachable,        // 无法从任何开始节点到达
+        MissingStartNode,
+        MissingEndNode,
+        UnconnectedInput,   // 输入端口未连接
+        TypeMismatch,       // 连接两端的 NodeDataType 不一致
+        MissingExecutor     // 节点类型没有注册执行器
+    };
+
+    Severity severity = Severity::Error;
+    Kind kind = Kind::Cycle;
+    NodeId nodeId = InvalidNodeId;
+    PortIndex port = 0;
+    QString message;
+
+    bool operator==(const FlowDiagnostic& other) const
+    {
+        return severity == other.severity && kind == other.kind && nodeId == other.nodeId
+            && port == other.port && message == other.message;
+    }
+};
+
+Q_DECLARE_METATYPE(FlowDiagnostic)
+
+// 后台线程上的一次校验任务，只读取快照，不访问模型
+struct FlowValidationJob
+{
+    std::shared_ptr<const GraphSnapshot> snapshot;
+    QSet<NodeTypeId> executorTypes;
+    std::vector<NodeId> dirtyNodes;     // 需要重新做局部检查的节点
+    bool full = false;                  // true 时对全部节点做局部检查
+};
+
+struct FlowValidationResult
+{
+    quint64 version = 0;
+    bool full = false;
+    bool globalChecked = false;                             // false 时 global 与 graphDiagnostics 未计算，沿用上次结果
+    std::vector<NodeId> checkedNodes;                       // 已删除的节点不在 local 中
+    QHash<NodeId, QList<FlowDiagnostic>> local;             // 只依赖节点自身及其入边的检查
+    QHash<NodeId, QList<FlowDiagnostic>> global;            // 依赖整图结构的检查（环、可达性）
+    QList<FlowDiagnostic> graphDiagnostics;
+};
+
+// 流程校验器
+// 编辑时只记录受影响的节点。防抖后局部检查（未连接输入、类型不匹配、缺少执行器）
+// 直接在界面线程上对变化节点查询实时模型，开销只与变化节点的端口和连接数有关；
+// 整图检查（环、可达性、开始/结束节点）需要 GraphSnapshot，用更长的防抖间隔合并编辑，
+// 之后才重建快照并在后台线程上做 CSR 线性遍历。完整校验（首次、批量编辑、“验证”）全部在后台进行。
+// 结果与上次结果比较，只为诊断发生变化的节点发出通知。
+class FlowValidator : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int MaxIncrementalNodes = 4096;
+
+    explicit FlowValidator(NodeEditorCore& core, QObject* parent = nullptr);
+    ~FlowValidator() override;
+
+    void setAutoValidate(bool enabled);
+    bool autoValidate() const { return m_autoValidate; }
+    void setDebounceInterval(int msec) { m_debounce.setInterval(msec); }
+    void setGlobalDebounceInterval(int msec) { m_globalDebounce.setInterval(msec); }
+
+    // 立即（异步）做一次完整校验
+    void validateAll();
+    // 标记节点需要重新检查，防抖后自动校验
+    void invalidateNode(NodeId nodeId);
+    void invalidateAll();
+
+    bool isRunning() const { return m_watcher.isRunning(); }
+    QList<FlowDiagnostic> diagnostics(NodeId nodeId) const;
+    QList<FlowDiagnostic> allDiagnostics() const;
+    const QList<FlowDiagnostic>& graphDiagnostics() const { return m_graphDiagnostics; }
+    int errorCount() const { return m_errorCount; }
+    int warningCount() const { return m_warningCount; }
+
+    // 在任意线程上执行校验，不依赖任何界面对象
+    static FlowValidationResult validate(const FlowValidationJob& job);
+
+signals:
+    void nodeDiagnosticsChanged(NodeId nodeId, const QList<FlowDiagnostic>& diagnostics);
+    void graphDiagnosticsChanged(const QList<FlowDiagnostic>& diagnostics);
+    void validationFinished(int errorCount, int warningCount);
+
+private slots:
+    void startValidation();
+    void startGlobalValidation();
+    void applyResult();
+
+private:
+    void connectModel(DataFlowGraphModel& model);
+    void scheduleValidation();
+    void startJob(bool full);
+    void checkDirtyNodes();
+    void mergeResult(FlowValidationResult& result);
+    static void checkLocal(const FlowValidationJob& job, int slot, FlowValidationResult& result);
+    static QList<FlowDiagnostic> checkLocal(const AbstractGraphModel& model, NodeId nodeId, NodeTypeId typeId,
+                                            const QSet<NodeTypeId>& executorTypes);
+    static void checkGlobal(const GraphSnapshot& graph, FlowValidationResult& result);
+
+private:
+    NodeEditorCore& m_core;
+    QTimer m_debounce;
+    QTimer m_globalDebounce;
+    QFutureWatcher<FlowValidationResult> m_watcher;
+    bool m_autoValidate = true;
+    bool m_pending = false;
+
+    QSet<NodeId> m_dirtyNodes;
+    bool m_fullPending = true;
+    bool m_globalPending = false;
+
+    QHash<NodeId, QList<FlowDiagnostic>> m_local;
+    QHash<NodeId, QList<FlowDiagnostic>> m_global;
+    QList<FlowDiagnostic> m_graphDiagnostics;
+    int m_errorCount = 0;
+    int m_warningCount = 0;
+};
+
+#endif // NODEEDITORDEMO_FLOWVALIDATOR_H
\ No newline at end of file
@@ -0,0 +1,108 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "GraphPartitioner.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr int MaxRefinePasses = 8;
+
+} // namespace
+
+std::vector<int> GraphPartition::slotsOf(int part) const
+{
+    std::vector<int> slots;
+    for (int slot = 0; slot < static_cast<int>(partOf.size()); ++slot) {
+        if (partOf[slot] == part) {
+            slots.push_back(slot);
+        }
+    }
+    return slots;
+}
+
+namespace GraphPartitioner {
+
+qint64 cutWeight(const GraphSnapshot& graph, const std::vector<int>& partOf, const OutputWeight& outputWeight)
+{
+    qint64 total = 0;
+    for (int slot = 0; slot < graph.nodeCount(); ++slot) {
+        // 同一输出送往同一个子图只传输一次
+        std::vector<int> remoteParts;
+        for (const GraphEdge* edge = graph.outBegin(slot); edge != graph.outEnd(slot); ++edge) {
+            const int part = partOf[edge->node];
+            if (part != partOf[slot] && std::find(remoteParts.begin(), remoteParts.end(), part) == remoteParts.end()) {
+                remoteParts.push_back(part);
+            }
+        }
+        total += outputWeight(slot) * static_cast<qint64>(remoteParts.size());
+    }
+    return total;
+}
+
+GraphPartition partition(const GraphSnapshot& graph, const std::vector<int>& topologicalOrder,
+                         int partCount, const OutputWeight& outputWeight)
+{
+    const int n = graph.nodeCount();
+    GraphPartition result;
+    result.partCount = std::max(1, std::min(partCount, n));
+    result.partOf.assign(n, 0);
+    if (result.partCount <= 1) {
+        return result;
+    }
+
+    // 初始划分：沿拓扑顺序切成大小相同的连续块
+    const int k = result.partCount;
+    for (int position = 0; position < static_cast<int>(topologicalOrder.size()); ++position) {
+        result.partOf[topologicalOrder[position]] = static_cast<int>(static_cast<qint64>(position) * k / n);
+    }
+
+    std::vector<int> partSize(k, 0);
+    for (int part : result.partOf) {
+        ++partSize[part];
+    }
+    const int maxPartSize = static_cast<int>(std::ceil(static_cast<double>(n) / k * (1.0 + Imbalance)));
+
+    std::vector<qint64> weight(n);
+    for (int slot = 0; slot < n; ++slot) {
+        weight[slot] = std::max<qint64>(1, outputWeight(slot));
+    }
+
+    // 节点与每个子图之间的连接权重：入边按上游输出计，出边按自身输出计
+    std::vector<qint64> affinity(k);
+    for (int pass = 0; pass < MaxRefinePasses; ++pass) {
+        bool improved = false;
+        for (int slot : topologicalOrder) {
+            std::fill(affinity.begin(), affinity.end(), 0);
+            for (const GraphEdge* edge = graph.inBegin(slot); edge != graph.inEnd(slot); ++edge) {
+                affinity[result.partOf[edge->node]] += weight[edge->node];
+            }
+            for (const GraphEdge* edge = graph.outBegin(slot); edge != graph.outEnd(slot); ++edge) {
+                affinity[result.partOf[edge->node]] += weight[slot];
+            }
+
+            const int current = result.partOf[slot];
+            int best = current;
+            for (int part = 0; part < k; ++part) {
+                if (part != current && partSize[part] < maxPartSize && affinity[part] > affinity[best]) {
+                    best = part;
+                }
+            }
+            // 子图不能被移空
+            if (best != current && partSize[current] > 1) {
+                result.partOf[slot] = best;
+                --partSize[current];
+                ++partSize[best];
+                improved = true;
+            }
+        }
+        if (!improved) break;
+    }
+
+    result.cutWeight = cutWeight(graph, result.partOf, outputWeight);
+    return result;
+}
+
+} // namespace GraphPartitioner
\ No newline at end of file
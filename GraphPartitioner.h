@@ -0,0 +1,40 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_GRAPHPARTITIONER_H
+#define NODEEDITORDEMO_GRAPHPARTITIONER_H
+
+#include "GraphSnapshot.h"
+#include <functional>
+#include <vector>
+
+// 图划分结果：partOf[槽位] 为所在子图编号
+struct GraphPartition
+{
+    std::vector<int> partOf;
+    int partCount = 0;
+    qint64 cutWeight = 0;      // 跨子图的边上传输的数据量估计
+
+    std::vector<int> slotsOf(int part) const;
+};
+
+// 把执行图划分为若干子图，使跨子图边的数据量尽量小，同时各子图节点数大致均衡。
+// 初始划分沿拓扑顺序切成连续的块（相邻节点多在同一块），再做 Fiduccia–Mattheyses 式的
+// 单点移动改进：每轮把能减少割边数据量、且不破坏均衡的节点移到邻居最多的子图。
+namespace GraphPartitioner {
+
+// 节点输出的数据量估计（字节），用作其所有出边的权重
+using OutputWeight = std::function<qint64(int slot)>;
+
+// 允许的子图大小为平均值的 (1 + Imbalance) 倍
+constexpr double Imbalance = 0.1;
+
+GraphPartition partition(const GraphSnapshot& graph, const std::vector<int>& topologicalOrder,
+                         int partCount, const OutputWeight& outputWeight);
+
+qint64 cutWeight(const GraphSnapshot& graph, const std::vector<int>& partOf, const OutputWeight& outputWeight);
+
+} // namespace GraphPartitioner
+
+#endif // NODEEDITORDEMO_GRAPHPARTITIONER_H
\ No newline at end of file
@@ -0,0 +1,126 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "GraphSnapshot.h"
+#include <QtNodes/NodeData>
+#include <algorithm>
+
+int GraphSnapshot::slotOf(NodeId nodeId) const
+{
+    auto it = std::lower_bound(m_nodes.begin(), m_nodes.end(), nodeId);
+    if (it == m_nodes.end() || *it != nodeId) {
+        return InvalidSlot;
+    }
+    return static_cast<int>(it - m_nodes.begin());
+}
+
+void GraphSnapshot::rebuild(const AbstractGraphModel& model, quint64 version,
+                            const QHash<NodeId, NodeTypeId>* nodeTypes)
+{
+    m_version = version;
+
+    auto nodeIds = model.allNodeIds();
+    m_nodes.assign(nodeIds.begin(), nodeIds.end());
+    std::sort(m_nodes.begin(), m_nodes.end());
+    const int n = nodeCount();
+
+    m_typeIds.resize(n);
+    m_inPortCount.assign(n, 0);
+    m_outPortCount.assign(n, 0);
+    m_inOffset.assign(n + 1, 0);
+    m_inEdges.clear();
+    m_inPortBase.assign(n + 1, 0);
+    m_inPortTypes.clear();
+    m_outPortBase.assign(n + 1, 0);
+    m_outPortTypes.clear();
+    m_portTypeIds.clear();
+
+    QHash<QString, int> typeIndex;
+    auto internPortType = [&](NodeId nodeId, PortType portType, PortIndex port) {
+        QString id = model.portData(nodeId, portType, port, PortRole::DataType).value<NodeDataType>().id;
+        auto it = typeIndex.constFind(id);
+        if (it != typeIndex.constEnd()) {
+            return it.value();
+        }
+        int index = static_cast<int>(m_portTypeIds.size());
+        m_portTypeIds.push_back(id);
+        typeIndex.insert(id, index);
+        return index;
+    };
+
+    // 入边：每条连接只在其输入节点处记录一次
+    for (int slot = 0; slot < n; ++slot) {
+        NodeId nodeId = m_nodes[slot];
+        const NodeTypeId cachedType = nodeTypes ? nodeTypes->value(nodeId, InvalidNodeTypeId) : InvalidNodeTypeId;
+        m_typeIds[slot] = (cachedType != InvalidNodeTypeId)
+            ? cachedType
+            : NodeTypeIds::intern(model.nodeData(nodeId, NodeRole::Type).toString());
+        m_inPortCount[slot] = model.nodeData(nodeId, NodeRole::InPortCount).toUInt();
+        m_outPortCount[slot] = model.nodeData(nodeId, NodeRole::OutPortCount).toUInt();
+
+        for (PortIndex port = 0; port < m_inPortCount[slot]; ++port) {
+            m_inPortTypes.push_back(internPortType(nodeId, PortType::In, port));
+        }
+        m_inPortBase[slot + 1] = static_cast<int>(m_inPortTypes.size());
+        for (PortIndex port = 0; port < m_outPortCount[slot]; ++port) {
+            m_outPortTypes.push_back(internPortType(nodeId, PortType::Out, port));
+        }
+        m_outPortBase[slot + 1] = static_cast<int>(m_outPortTypes.size());
+
+        for (const auto& conn : model.allConnectionIds(nodeId)) {
+            if (conn.inNodeId != nodeId) continue;
+            int source = slotOf(conn.outNodeId);
+            if (source == InvalidSlot) continue;
+            m_inEdges.push_back(GraphEdge{source, conn.inPortIndex, conn.outPortIndex});
+        }
+        m_inOffset[slot + 1] = static_cast<int>(m_inEdges.size());
+    }
+
+    // 出边：由入边转置得到
+    m_outOffset.assign(n + 1, 0);
+    for (const GraphEdge& edge : m_inEdges) {
+        ++m_outOffset[edge.node + 1];
+    }
+    for (int slot = 0; slot < n; ++slot) {
+        m_outOffset[slot + 1] += m_outOffset[slot];
+    }
+
+    m_outEdges.resize(m_inEdges.size());
+    std::vector<int> fill(m_outOffset.begin(), m_outOffset.end() - 1);
+    for (int slot = 0; slot < n; ++slot) {
+        for (const GraphEdge* edge = inBegin(slot); edge != inEnd(slot); ++edge) {
+            m_outEdges[fill[edge->node]++] = GraphEdge{slot, edge->peerPort, edge->port};
+        }
+    }
+}
+
+bool GraphSnapshot::topologicalOrder(std::vector<int>& order) const
+{
+    std::vector<int> indegree;
+    return topologicalOrder(order, indegree);
+}
+
+bool GraphSnapshot::topologicalOrder(std::vector<int>& order, std::vector<int>& indegree) const
+{
+    const int n = nodeCount();
+    indegree.assign(n, 0);
+    order.clear();
+    order.reserve(n);
+
+    for (int slot = 0; slot < n; ++slot) {
+        indegree[slot] = inDegree(slot);
+        if (indegree[slot] == 0) order.push_back(slot);
+    }
+
+    // order 本身兼作队列
+    for (size_t head = 0; head < order.size(); ++head) {
+        int slot = order[head];
+        for (const GraphEdge* edge = outBegin(slot); edge != outEnd(slot); ++edge) {
+            if (--indegree[edge->node] == 0) {
+                order.push_back(edge->node);
+            }
+        }
+    }
+    return static_cast<int>(order.size()) == n;
+}
\ No newline at end of file
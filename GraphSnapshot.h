@@ -0,0 +1,89 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_GRAPHSNAPSHOT_H
+#define NODEEDITORDEMO_GRAPHSNAPSHOT_H
+
+#include <QtNodes/AbstractGraphModel>
+#include "NodeTypeId.h"
+#include <QHash>
+#include <QString>
+#include <vector>
+
+using namespace QtNodes;
+
+// CSR 邻接表中的一条边
+// 对入边：node 为上游槽位，port 为本节点输入端口，peerPort 为上游输出端口
+// 对出边：node 为下游槽位，port 为本节点输出端口，peerPort 为下游输入端口
+struct GraphEdge
+{
+    int node;
+    PortIndex port;
+    PortIndex peerPort;
+};
+
+// 图的只读压缩稀疏行（CSR）快照
+// 节点按 NodeId 升序映射到稠密槽位 0..N-1，入边和出边分别存放在连续数组中。
+// 整图遍历（调度、计数、校验、布局）都基于快照进行，不再逐节点调用 allConnectionIds()。
+// 快照构建后不再修改，可以用 shared_ptr<const GraphSnapshot> 安全地交给后台线程。
+class GraphSnapshot
+{
+public:
+    static constexpr int InvalidSlot = -1;
+
+    // nodeTypes 为调用方在节点创建时缓存的类型标识；为空或缺少某个节点时从模型读取类型名再驻留
+    void rebuild(const AbstractGraphModel& model, quint64 version,
+                 const QHash<NodeId, NodeTypeId>* nodeTypes = nullptr);
+
+    quint64 version() const { return m_version; }
+    int nodeCount() const { return static_cast<int>(m_nodes.size()); }
+    int edgeCount() const { return static_cast<int>(m_inEdges.size()); }
+
+    int slotOf(NodeId nodeId) const;
+    NodeId nodeId(int slot) const { return m_nodes[slot]; }
+    const std::vector<NodeId>& nodeIds() const { return m_nodes; }
+    NodeTypeId nodeTypeId(int slot) const { return m_typeIds[slot]; }
+    // 类型名，仅用于日志和提示；执行路径使用 nodeTypeId
+    QString nodeType(int slot) const { return NodeTypeIds::name(m_typeIds[slot]); }
+    unsigned int inPortCount(int slot) const { return m_inPortCount[slot]; }
+    unsigned int outPortCount(int slot) const { return m_outPortCount[slot]; }
+
+    // 端口数据类型（NodeDataType::id）在快照内驻留为整数，比较时不再比较字符串
+    int inPortType(int slot, PortIndex port) const { return m_inPortTypes[m_inPortBase[slot] + port]; }
+    int outPortType(int slot, PortIndex port) const { return m_outPortTypes[m_outPortBase[slot] + port]; }
+    const QString& portTypeId(int typeIndex) const { return m_portTypeIds[typeIndex]; }
+
+    const GraphEdge* inBegin(int slot) const { return m_inEdges.data() + m_inOffset[slot]; }
+    const GraphEdge* inEnd(int slot) const { return m_inEdges.data() + m_inOffset[slot + 1]; }
+    int inDegree(int slot) const { return m_inOffset[slot + 1] - m_inOffset[slot]; }
+
+    const GraphEdge* outBegin(int slot) const { return m_outEdges.data() + m_outOffset[slot]; }
+    const GraphEdge* outEnd(int slot) const { return m_outEdges.data() + m_outOffset[slot + 1]; }
+    int outDegree(int slot) const { return m_outOffset[slot + 1] - m_outOffset[slot]; }
+
+    // 拓扑序（Kahn 算法）；存在环时返回 false，order 中只包含不在环上的部分
+    // indegree 为调用方提供的临时数组，便于复用容量
+    bool topologicalOrder(std::vector<int>& order, std::vector<int>& indegree) const;
+    bool topologicalOrder(std::vector<int>& order) const;
+
+private:
+    quint64 m_version = 0;
+    std::vector<NodeId> m_nodes;
+    std::vector<NodeTypeId> m_typeIds;
+    std::vector<unsigned int> m_inPortCount;
+    std::vector<unsigned int> m_outPortCount;
+
+    std::vector<int> m_inPortBase;
+    std::vector<int> m_inPortTypes;
+    std::vector<int> m_outPortBase;
+    std::vector<int> m_outPortTypes;
+    std::vector<QString> m_portTypeIds;
+
+    std::vector<int> m_inOffset;
+    std::vector<GraphEdge> m_inEdges;
+    std::vector<int> m_outOffset;
+    std::vector<GraphEdge> m_outEdges;
+};
+
+#endif // NODEEDITORDEMO_GRAPHSNAPSHOT_H
\ No newline at end of file
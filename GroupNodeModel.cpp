@@ -0,0 +1,364 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "GroupNodeModel.h"
+#include "BasicNodes.h"
+#include <QHash>
+#include <QJsonArray>
+#include <stdexcept>
+
+namespace {
+
+QJsonArray portsToJson(const QVector<GroupPort>& ports)
+{
+    QJsonArray array;
+    for (const GroupPort& port : ports) {
+        QJsonObject json;
+        json["node"] = static_cast<qint64>(port.node);
+        json["port"] = static_cast<qint64>(port.port);
+        json["type-id"] = port.type.id;
+        json["type-name"] = port.type.name;
+        array.append(json);
+    }
+    return array;
+}
+
+QVector<GroupPort> portsFromJson(const QJsonArray& array)
+{
+    QVector<GroupPort> ports;
+    ports.reserve(array.size());
+    for (const QJsonValue& value : array) {
+        QJsonObject json = value.toObject();
+        GroupPort port;
+        port.node = static_cast<NodeId>(json["node"].toInt());
+        port.port = static_cast<PortIndex>(json["port"].toInt());
+        port.type = NodeDataType{json["type-id"].toString(), json["type-name"].toString()};
+        ports.append(port);
+    }
+    return ports;
+}
+
+} // namespace
+
+// 子图的编译结果：槽位、执行顺序、输入表和结果数组，多次执行之间复用
+struct GroupNodeModel::CompiledPlan
+{
+    quint64 executorGeneration = 0;
+    std::vector<NodeId> nodes;
+    std::vector<QString> types;
+    std::vector<const TypedNodeExecutor*> executors;
+    std::vector<TypedNodeExecutor> boundExecutors;          // 按子图节点状态绑定的执行器，executors 指向其中的元素
+    std::vector<std::unique_ptr<GroupNodeModel>> children;  // 嵌套的组节点，其余槽位为空
+    std::vector<int> order;
+    std::vector<int> inputBase;
+    std::vector<int> inputSource;       // >=0 上游槽位，-1 未连接，<=-2 组输入 -(k+2)
+    std::vector<int> outputSlots;
+    std::vector<NodeValue> results;
+    std::vector<const NodeValue*> inputPointers;
+    std::vector<std::pair<int, int>> groupInputBindings;   // (输入表下标, 组输入端口)
+};
+
+GroupNodeModel::GroupNodeModel()
+{
+    m_label = new QLabel();
+    m_label->setAlignment(Qt::AlignCenter);
+    m_label->setStyleSheet("QLabel { background-color: #607D8B; color: white; border: 2px solid #455A64; border-radius: 6px; padding: 6px; }");
+    m_label->setMinimumSize(100, 40);
+    updateLabel();
+}
+
+GroupNodeModel::~GroupNodeModel() = default;
+
+unsigned int GroupNodeModel::nPorts(PortType portType) const
+{
+    if (portType == PortType::In) return static_cast<unsigned int>(m_inputs.size());
+    if (portType == PortType::Out) return static_cast<unsigned int>(m_outputs.size());
+    return 0;
+}
+
+NodeDataType GroupNodeModel::dataType(PortType portType, PortIndex portIndex) const
+{
+    const QVector<GroupPort>& ports = (portType == PortType::In) ? m_inputs : m_outputs;
+    if (portIndex < static_cast<PortIndex>(ports.size())) {
+        return ports[static_cast<int>(portIndex)].type;
+    }
+    return NodeDataType{};
+}
+
+std::shared_ptr<NodeData> GroupNodeModel::outData(PortIndex port)
+{
+    if (port >= m_outData.size()) return nullptr;
+
+    // 流程端口与 StartNodeModel 一样输出不带状态的 FlowData
+    if (!m_outData[port] && m_outputs[static_cast<int>(port)].type.id == FlowData().type().id) {
+        m_outData[port] = std::make_shared<FlowData>();
+    }
+    return m_outData[port];
+}
+
+void GroupNodeModel::setInData(std::shared_ptr<NodeData> data, PortIndex portIndex)
+{
+    // 组节点的计算在执行数据流时进行，这里不需要保存界面传递的数据
+}
+
+QWidget* GroupNodeModel::embeddedWidget()
+{
+    return m_label;
+}
+
+QJsonObject GroupNodeModel::save() const
+{
+    return makeInternalData(m_subgraph, m_inputs, m_outputs, m_origin);
+}
+
+QJsonObject GroupNodeModel::makeInternalData(const QJsonObject& subgraph, const QVector<GroupPort>& inputs,
+                                             const QVector<GroupPort>& outputs, const QPointF& origin)
+{
+    QJsonObject json;
+    json["model-name"] = QStringLiteral("GroupNode");
+    json["subgraph"] = subgraph;
+    json["inputs"] = portsToJson(inputs);
+    json["outputs"] = portsToJson(outputs);
+    json["origin"] = QJsonObject{{"x", origin.x()}, {"y", origin.y()}};
+    return json;
+}
+
+void GroupNodeModel::load(QJsonObject const& json)
+{
+    QJsonObject origin = json["origin"].toObject();
+    setSubgraph(json["subgraph"].toObject(),
+                portsFromJson(json["inputs"].toArray()),
+                portsFromJson(json["outputs"].toArray()),
+                QPointF(origin["x"].toDouble(), origin["y"].toDouble()));
+}
+
+void GroupNodeModel::setSubgraph(const QJsonObject& subgraph, const QVector<GroupPort>& inputs,
+                                 const QVector<GroupPort>& outputs, const QPointF& origin)
+{
+    m_subgraph = subgraph;
+    m_inputs = inputs;
+    m_outputs = outputs;
+    m_origin = origin;
+    m_outData.assign(static_cast<size_t>(m_outputs.size()), nullptr);
+    invalidatePlan();
+    updateLabel();
+}
+
+int GroupNodeModel::innerNodeCount() const
+{
+    return m_subgraph["nodes"].toArray().size();
+}
+
+void GroupNodeModel::updateLabel()
+{
+    if (m_label) {
+        m_label->setText(QString("包含 %1 个节点").arg(innerNodeCount()));
+    }
+}
+
+void GroupNodeModel::invalidatePlan()
+{
+    QMutexLocker locker(&m_executeMutex);
+    m_plan.reset();
+    m_memoValid = false;
+    m_memoInputs.clear();
+    m_memoOutput.reset();
+}
+
+QJsonObject GroupNodeModel::connectionToJson(const ConnectionId& connectionId)
+{
+    QJsonObject json;
+    json["outNodeId"] = static_cast<qint64>(connectionId.outNodeId);
+    json["outPortIndex"] = static_cast<qint64>(connectionId.outPortIndex);
+    json["inNodeId"] = static_cast<qint64>(connectionId.inNodeId);
+    json["inPortIndex"] = static_cast<qint64>(connectionId.inPortIndex);
+    return json;
+}
+
+ConnectionId GroupNodeModel::connectionFromJson(const QJsonObject& json)
+{
+    // 兼容 QtNodes 场景文件中的 "intNodeId" 写法
+    QJsonValue inNode = json.contains("inNodeId") ? json["inNodeId"] : json["intNodeId"];
+    return ConnectionId{static_cast<NodeId>(json["outNodeId"].toInt()),
+                        static_cast<PortIndex>(json["outPortIndex"].toInt()),
+                        static_cast<NodeId>(inNode.toInt()),
+                        static_cast<PortIndex>(json["inPortIndex"].toInt())};
+}
+
+void GroupNodeModel::compile(const NodeExecutorTable& executors, const NodeExecutorBinderTable& binders,
+                             quint64 executorGeneration)
+{
+    auto plan = std::make_unique<CompiledPlan>();
+    plan->executorGeneration = executorGeneration;
+
+    const QJsonArray nodes = m_subgraph["nodes"].toArray();
+    const int n = nodes.size();
+    QHash<NodeId, int> slotOf;
+    slotOf.reserve(n);
+
+    std::vector<int> inPortCount(n, 0);
+    plan->nodes.resize(n);
+    plan->types.resize(n);
+    plan->executors.assign(n, nullptr);
+    plan->boundExecutors.reserve(n);
+    plan->children.resize(n);
+
+    for (int slot = 0; slot < n; ++slot) {
+        QJsonObject nodeJson = nodes[slot].toObject();
+        QJsonObject internalData = nodeJson["internal-data"].toObject();
+        plan->nodes[slot] = static_cast<NodeId>(nodeJson["id"].toInt());
+        plan->types[slot] = internalData["model-name"].toString();
+        inPortCount[slot] = nodeJson["in-port-count"].toInt();
+        slotOf.insert(plan->nodes[slot], slot);
+
+        if (plan->types[slot] == name()) {
+            plan->children[slot] = std::make_unique<GroupNodeModel>();
+            plan->children[slot]->load(internalData);
+        } else if (const NodeExecutorBinder* binder = binders.find(plan->types[slot])) {
+            // internal-data 即节点 save() 的结果
+            plan->boundExecutors.push_back((*binder)(internalData));
+            plan->executors[slot] = &plan->boundExecutors.back();
+        } else {
+            plan->executors[slot] = executors.find(plan->types[slot]);
+            if (!plan->executors[slot]) {
+                throw std::runtime_error(QString("子图节点 %1 的类型 %2 未注册执行器")
+                                             .arg(plan->nodes[slot]).arg(plan->types[slot]).toStdString());
+            }
+        }
+    }
+
+    // 连接：端口数以记录值为准，连接到更高端口时自动扩展
+    std::vector<ConnectionId> connections;
+    for (const QJsonValue& value : m_subgraph["connections"].toArray()) {
+        ConnectionId conn = connectionFromJson(value.toObject());
+        if (!slotOf.contains(conn.outNodeId) || !slotOf.contains(conn.inNodeId)) continue;
+        int target = slotOf.value(conn.inNodeId);
+        inPortCount[target] = std::max(inPortCount[target], static_cast<int>(conn.inPortIndex) + 1);
+        connections.push_back(conn);
+    }
+    for (const GroupPort& port : m_inputs) {
+        auto it = slotOf.constFind(port.node);
+        if (it != slotOf.constEnd()) {
+            inPortCount[it.value()] = std::max(inPortCount[it.value()], static_cast<int>(port.port) + 1);
+        }
+    }
+
+    plan->inputBase.assign(n + 1, 0);
+    for (int slot = 0; slot < n; ++slot) {
+        plan->inputBase[slot + 1] = plan->inputBase[slot] + inPortCount[slot];
+    }
+    plan->inputSource.assign(plan->inputBase[n], -1);
+
+    std::vector<int> indegree(n, 0);
+    std::vector<std::vector<int>> successors(n);
+    for (const ConnectionId& conn : connections) {
+        int source = slotOf.value(conn.outNodeId);
+        int target = slotOf.value(conn.inNodeId);
+        plan->inputSource[plan->inputBase[target] + conn.inPortIndex] = source;
+        successors[source].push_back(target);
+        ++indegree[target];
+    }
+    for (int k = 0; k < m_inputs.size(); ++k) {
+        auto it = slotOf.constFind(m_inputs[k].node);
+        if (it == slotOf.constEnd()) continue;
+        int index = plan->inputBase[it.value()] + static_cast<int>(m_inputs[k].port);
+        plan->inputSource[index] = -(k + 2);
+        plan->groupInputBindings.emplace_back(index, k);
+    }
+
+    // 拓扑排序（Kahn），order 本身兼作队列
+    plan->order.reserve(n);
+    for (int slot = 0; slot < n; ++slot) {
+        if (indegree[slot] == 0) plan->order.push_back(slot);
+    }
+    for (size_t head = 0; head < plan->order.size(); ++head) {
+        for (int next : successors[plan->order[head]]) {
+            if (--indegree[next] == 0) plan->order.push_back(next);
+        }
+    }
+    if (static_cast<int>(plan->order.size()) != n) {
+        throw std::runtime_error("子图存在循环依赖");
+    }
+
+    // 输出端口对应的子图节点：每个节点只有一个执行结果，按节点取值
+    for (const GroupPort& port : m_outputs) {
+        plan->outputSlots.push_back(slotOf.value(port.node, -1));
+    }
+
+    plan->results.resize(n);
+    plan->inputPointers.assign(plan->inputSource.size(), nullptr);
+    for (size_t i = 0; i < plan->inputSource.size(); ++i) {
+        if (plan->inputSource[i] >= 0) {
+            plan->inputPointers[i] = &plan->results[plan->inputSource[i]];
+        }
+    }
+
+    m_plan = std::move(plan);
+    m_memoValid = false;
+}
+
+NodeValue GroupNodeModel::execute(const NodeInputs& inputs, const NodeExecutorTable& executors,
+                                  const NodeExecutorBinderTable& binders, quint64 executorGeneration)
+{
+    QMutexLocker locker(&m_executeMutex);
+    if (!m_plan || m_plan->executorGeneration != executorGeneration) {
+        compile(executors, binders, executorGeneration);
+    }
+    CompiledPlan& plan = *m_plan;
+
+    // 输入与上一次相同时直接返回记忆的结果（要求子图中的执行器是纯函数）
+    const int inputCount = m_inputs.size();
+    if (m_memoValid) {
+        bool same = true;
+        for (int k = 0; k < inputCount && same; ++k) {
+            same = inputs[static_cast<PortIndex>(k)] == m_memoInputs[k];
+        }
+        if (same) {
+            return m_memoOutput;
+        }
+    }
+
+    for (const auto& binding : plan.groupInputBindings) {
+        PortIndex port = static_cast<PortIndex>(binding.second);
+        plan.inputPointers[binding.first] = inputs.has(port) ? &inputs[port] : nullptr;
+    }
+
+    for (int slot : plan.order) {
+        const int base = plan.inputBase[slot];
+        NodeInputs slotInputs(plan.inputPointers.data() + base,
+                              static_cast<size_t>(plan.inputBase[slot + 1] - base));
+        if (plan.children[slot]) {
+            plan.results[slot] = plan.children[slot]->execute(slotInputs, executors, binders, executorGeneration);
+        } else {
+            plan.results[slot] = (*plan.executors[slot])(plan.nodes[slot], slotInputs);
+        }
+    }
+
+    NodeValue output;
+    if (plan.outputSlots.size() == 1) {
+        if (plan.outputSlots[0] >= 0) output = plan.results[plan.outputSlots[0]];
+    } else if (!plan.outputSlots.empty()) {
+        QVariantList values;
+        for (int slot : plan.outputSlots) {
+            values.append(slot >= 0 ? plan.results[slot].toVariant() : QVariant());
+        }
+        output = NodeValue(QVariant(values));
+    }
+
+    // 子图中间结果不保留，组输入的指针也不能留到下一次执行
+    for (NodeValue& value : plan.results) {
+        value.reset();
+    }
+    for (const auto& binding : plan.groupInputBindings) {
+        plan.inputPointers[binding.first] = nullptr;
+    }
+
+    m_memoInputs.resize(inputCount);
+    for (int k = 0; k < inputCount; ++k) {
+        m_memoInputs[k] = inputs[static_cast<PortIndex>(k)];
+    }
+    m_memoOutput = output;
+    m_memoValid = true;
+    return output;
+}
\ No newline at end of file
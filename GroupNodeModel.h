@@ -0,0 +1,101 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_GROUPNODEMODEL_H
+#define NODEEDITORDEMO_GROUPNODEMODEL_H
+
+#include <QtNodes/NodeDelegateModel>
+#include <QtNodes/NodeData>
+#include "NodeValue.h"
+#include <QJsonObject>
+#include <QLabel>
+#include <QMutex>
+#include <QPointF>
+#include <QVector>
+#include <memory>
+#include <vector>
+
+using namespace QtNodes;
+
+// 组节点的外部端口，对应子图中某个节点的端口
+struct GroupPort
+{
+    NodeId node = InvalidNodeId;
+    PortIndex port = 0;
+    NodeDataType type;
+};
+
+// 组节点：把一段子图折叠为场景中的单个节点
+// 子图以嵌套场景的形式随 save/load 保存：{"nodes": [...], "connections": [...]}，
+// 节点条目与 DataFlowGraphModel::saveNode 的格式相同。
+// 执行时组节点只在第一次（或执行器变化后）把子图编译为执行计划，此后直接复用；
+// 输入与上一次相同则直接返回记忆的结果，不再执行子图。
+class GroupNodeModel : public NodeDelegateModel
+{
+    Q_OBJECT
+public:
+    GroupNodeModel();
+    ~GroupNodeModel() override;
+
+    QString caption() const override { return "组"; }
+    QString name() const override { return "GroupNode"; }
+
+    unsigned int nPorts(PortType portType) const override;
+    NodeDataType dataType(PortType portType, PortIndex portIndex) const override;
+    std::shared_ptr<NodeData> outData(PortIndex port) override;
+    void setInData(std::shared_ptr<NodeData> data, PortIndex portIndex) override;
+    QWidget* embeddedWidget() override;
+    QJsonObject save() const override;
+    void load(QJsonObject const& json) override;
+
+    void setSubgraph(const QJsonObject& subgraph, const QVector<GroupPort>& inputs,
+                     const QVector<GroupPort>& outputs, const QPointF& origin);
+    const QJsonObject& subgraph() const { return m_subgraph; }
+    const QVector<GroupPort>& inputs() const { return m_inputs; }
+    const QVector<GroupPort>& outputs() const { return m_outputs; }
+    // 折叠时子图节点的中心位置，展开时据此平移
+    QPointF origin() const { return m_origin; }
+    int innerNodeCount() const;
+
+    // 执行子图；executorGeneration 变化时重新编译。只有一个输出端口时直接返回该端口的值，
+    // 多个输出端口时返回按端口顺序排列的 QVariantList。
+    // 子图节点不在外层模型中：有绑定器的类型在编译时按子图 JSON 中保存的状态绑定执行器，
+    // 其余执行器收到的是子图内部的节点 ID，不能据此查询外层模型。
+    // 编译结果和记忆化的输出是共享状态，同一组节点的并发调用（例如超时后被放弃的执行与重试）串行进行
+    NodeValue execute(const NodeInputs& inputs, const NodeExecutorTable& executors,
+                      const NodeExecutorBinderTable& binders, quint64 executorGeneration);
+    void invalidatePlan();
+
+    // 组节点 internal-data 的 JSON，与 save() 的结果相同
+    static QJsonObject makeInternalData(const QJsonObject& subgraph, const QVector<GroupPort>& inputs,
+                                        const QVector<GroupPort>& outputs, const QPointF& origin);
+
+    // 子图中连接的 JSON 表示
+    static QJsonObject connectionToJson(const ConnectionId& connectionId);
+    static ConnectionId connectionFromJson(const QJsonObject& json);
+
+private:
+    struct CompiledPlan;
+
+    void compile(const NodeExecutorTable& executors, const NodeExecutorBinderTable& binders,
+                 quint64 executorGeneration);
+    void updateLabel();
+
+private:
+    QJsonObject m_subgraph;
+    QVector<GroupPort> m_inputs;
+    QVector<GroupPort> m_outputs;
+    QPointF m_origin;
+
+    QMutex m_executeMutex;
+    std::unique_ptr<CompiledPlan> m_plan;
+    bool m_memoValid = false;
+    std::vector<NodeValue> m_memoInputs;
+    NodeValue m_memoOutput;
+
+    std::vector<std::shared_ptr<NodeData>> m_outData;
+    QLabel* m_label = nullptr;
+};
+
+#endif // NODEEDITORDEMO_GROUPNODEMODEL_H
\ No newline at end of file
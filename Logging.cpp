@@ -0,0 +1,10 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "Logging.h"
+
+Q_LOGGING_CATEGORY(lcCore, "nodeeditor.core")
+Q_LOGGING_CATEGORY(lcGraph, "nodeeditor.graph", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcExec, "nodeeditor.exec", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcUi, "nodeeditor.ui")
\ No newline at end of file
@@ -0,0 +1,19 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_LOGGING_H
+#define NODEEDITORDEMO_LOGGING_H
+
+#include <QLoggingCategory>
+
+// 日志分类，可通过 QT_LOGGING_RULES 或 QLoggingCategory::setFilterRules 在运行时过滤，例如：
+//   QT_LOGGING_RULES="nodeeditor.exec.debug=true;nodeeditor.ui.debug=false"
+// 编辑和执行热路径（graph/exec）默认关闭 debug 级别，关闭时不会格式化任何参数。
+// CMake 选项 NODEEDITOR_DEBUG_LOG=OFF 会定义 QT_NO_DEBUG_OUTPUT，所有 debug 输出在编译期移除。
+Q_DECLARE_LOGGING_CATEGORY(lcCore)   // nodeeditor.core  初始化、注册、场景读写
+Q_DECLARE_LOGGING_CATEGORY(lcGraph)  // nodeeditor.graph 节点/连接/位置编辑
+Q_DECLARE_LOGGING_CATEGORY(lcExec)   // nodeeditor.exec  数据流执行
+Q_DECLARE_LOGGING_CATEGORY(lcUi)     // nodeeditor.ui    主窗口与拖拽
+
+#endif // NODEEDITORDEMO_LOGGING_H
\ No newline at end of file
@@ -0,0 +1,219 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "MathNodes.h"
+#include <QSignalBlocker>
+#include <cmath>
+
+namespace {
+
+struct OperationInfo
+{
+    MathOperationModel::Operation operation;
+    const char* key;    // 保存到场景文件
+    const char* label;  // 下拉框显示
+};
+
+const OperationInfo Operations[] = {
+    {MathOperationModel::Operation::Add, "add", "加 +"},
+    {MathOperationModel::Operation::Subtract, "subtract", "减 -"},
+    {MathOperationModel::Operation::Multiply, "multiply", "乘 ×"},
+    {MathOperationModel::Operation::Divide, "divide", "除 ÷"},
+    {MathOperationModel::Operation::Min, "min", "最小值"},
+    {MathOperationModel::Operation::Max, "max", "最大值"},
+};
+
+bool sameNumber(double a, double b)
+{
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+} // namespace
+
+// 数学运算节点实现
+MathOperationModel::MathOperationModel()
+    : m_result(std::make_shared<NumberData>(0.0))
+{
+    m_comboBox = new QComboBox();
+    for (const OperationInfo& info : Operations) {
+        m_comboBox->addItem(QString::fromUtf8(info.label));
+    }
+    m_comboBox->setMinimumWidth(90);
+
+    connect(m_comboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int index) {
+        if (index >= 0) {
+            setOperation(Operations[index].operation);
+        }
+    });
+}
+
+unsigned int MathOperationModel::nPorts(PortType portType) const
+{
+    return (portType == PortType::In) ? 2 : 1;
+}
+
+NodeDataType MathOperationModel::dataType(PortType portType, PortIndex portIndex) const
+{
+    return NumberData().type();
+}
+
+std::shared_ptr<NodeData> MathOperationModel::outData(PortIndex port)
+{
+    return m_result;
+}
+
+void MathOperationModel::setInData(std::shared_ptr<NodeData> data, PortIndex portIndex)
+{
+    if (portIndex > 1) return;
+
+    auto number = std::dynamic_pointer_cast<NumberData>(data);
+    const bool connected = (number != nullptr);
+    const double value = connected ? number->value() : 0.0;
+
+    // 输入没有变化时不重算，也不通知下游
+    if (m_connected[portIndex] == connected && sameNumber(m_inputs[portIndex], value)) return;
+
+    m_connected[portIndex] = connected;
+    m_inputs[portIndex] = value;
+    recompute();
+}
+
+QWidget* MathOperationModel::embeddedWidget()
+{
+    return m_comboBox;
+}
+
+QJsonObject MathOperationModel::save() const
+{
+    QJsonObject json = NodeDelegateModel::save();
+    json["operation"] = QString::fromLatin1(Operations[static_cast<int>(operation())].key);
+    return json;
+}
+
+void MathOperationModel::load(QJsonObject const& json)
+{
+    setOperation(operationFromState(json));
+}
+
+MathOperationModel::Operation MathOperationModel::operationFromState(const QJsonObject& state)
+{
+    const QString key = state["operation"].toString();
+    for (const OperationInfo& info : Operations) {
+        if (key == QLatin1String(info.key)) {
+            return info.operation;
+        }
+    }
+    return Operation::Add;
+}
+
+void MathOperationModel::setOperation(Operation operation)
+{
+    const int index = static_cast<int>(operation);
+    if (m_comboBox->currentIndex() != index) {
+        QSignalBlocker blocker(m_comboBox);
+        m_comboBox->setCurrentIndex(index);
+    }
+
+    if (this->operation() == operation) return;
+    m_operation = operation;
+    emit operationChanged();
+    recompute();
+}
+
+FusableOp MathOperationModel::toFusableOp(Operation operation)
+{
+    switch (operation) {
+    case Operation::Add: return FusableOp::Add;
+    case Operation::Subtract: return FusableOp::Subtract;
+    case Operation::Multiply: return FusableOp::Multiply;
+    case Operation::Divide: return FusableOp::Divide;
+    case Operation::Min: return FusableOp::Min;
+    case Operation::Max: return FusableOp::Max;
+    }
+    return FusableOp::None;
+}
+
+ColumnOp MathOperationModel::toColumnOp(Operation operation)
+{
+    switch (operation) {
+    case Operation::Add: return ColumnOp::Add;
+    case Operation::Subtract: return ColumnOp::Subtract;
+    case Operation::Multiply: return ColumnOp::Multiply;
+    case Operation::Divide: return ColumnOp::Divide;
+    case Operation::Min: return ColumnOp::Min;
+    case Operation::Max: return ColumnOp::Max;
+    }
+    return ColumnOp::Add;
+}
+
+void MathOperationModel::recompute()
+{
+    // 与执行器、融合内核使用同一套运算语义
+    const double result = ExpressionFusion::apply(fusableOp(), m_inputs[0], m_inputs[1]);
+    if (sameNumber(m_result->value(), result)) return;
+
+    m_result = std::make_shared<NumberData>(result);
+    emit dataUpdated(0);
+}
+
+// 文本显示节点实现
+TextDisplayModel::TextDisplayModel()
+{
+    m_label = new QLabel("-");
+    m_label->setAlignment(Qt::AlignCenter);
+    m_label->setStyleSheet("QLabel { background-color: #ECEFF1; color: #263238; border: 1px solid #90A4AE; border-radius: 4px; padding: 6px; }");
+    m_label->setMinimumSize(80, 30);
+
+    m_repaintTimer.setSingleShot(true);
+    m_repaintTimer.setInterval(RepaintIntervalMs);
+    connect(&m_repaintTimer, &QTimer::timeout, this, &TextDisplayModel::repaint);
+}
+
+unsigned int TextDisplayModel::nPorts(PortType portType) const
+{
+    return (portType == PortType::In) ? 1 : 0; // 只有输入端口
+}
+
+NodeDataType TextDisplayModel::dataType(PortType portType, PortIndex portIndex) const
+{
+    return NumberData().type();
+}
+
+std::shared_ptr<NodeData> TextDisplayModel::outData(PortIndex port)
+{
+    return nullptr;
+}
+
+void TextDisplayModel::setInData(std::shared_ptr<NodeData> data, PortIndex portIndex)
+{
+    auto number = std::dynamic_pointer_cast<NumberData>(data);
+    m_text = number ? QString::number(number->value(), 'g', 12) : QString();
+
+    // 合并高频更新：定时器未启动时才启动，到期后只显示最新的值
+    if (!m_repaintTimer.isActive()) {
+        m_repaintTimer.start();
+    }
+}
+
+QWidget* TextDisplayModel::embeddedWidget()
+{
+    return m_label;
+}
+
+QJsonObject TextDisplayModel::save() const
+{
+    return NodeDelegateModel::save();
+}
+
+void TextDisplayModel::load(QJsonObject const& json)
+{
+}
+
+void TextDisplayModel::repaint()
+{
+    const QString shown = m_text.isEmpty() ? QStringLiteral("-") : m_text;
+    if (m_label->text() != shown) {
+        m_label->setText(shown);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_MATHNODES_H
+#define NODEEDITORDEMO_MATHNODES_H
+
+#include <QtNodes/NodeDelegateModel>
+#include <QtNodes/NodeData>
+#include <QComboBox>
+#include <QLabel>
+#include <QTimer>
+#include "ColumnKernels.h"
+#include "ExpressionFusion.h"
+
+using namespace QtNodes;
+
+// 数值数据类型，创建后不再修改，值变化时下发新的实例
+class NumberData : public NodeData
+{
+public:
+    explicit NumberData(double value = 0.0) : m_value(value) {}
+
+    NodeDataType type() const override
+    {
+        return NodeDataType{"number", "Number"};
+    }
+
+    double value() const { return m_value; }
+
+private:
+    double m_value;
+};
+
+// 数学运算节点：两个数值输入（未连接按 0 处理），一个数值输出
+// 只有输入或运算符真正改变、且结果也改变时才通知下游，下游只重算受影响的节点
+class MathOperationModel : public NodeDelegateModel
+{
+    Q_OBJECT
+public:
+    enum class Operation
+    {
+        Add,
+        Subtract,
+        Multiply,
+        Divide,
+        Min,
+        Max
+    };
+
+    MathOperationModel();
+
+    QString caption() const override { return "数学运算"; }
+    QString name() const override { return "MathOperation"; }
+
+    unsigned int nPorts(PortType portType) const override;
+    NodeDataType dataType(PortType portType, PortIndex portIndex) const override;
+    std::shared_ptr<NodeData> outData(PortIndex port) override;
+    void setInData(std::shared_ptr<NodeData> data, PortIndex portIndex) override;
+    QWidget* embeddedWidget() override;
+    QJsonObject save() const override;
+    void load(QJsonObject const& json) override;
+
+    Operation operation() const { return m_operation; }
+    void setOperation(Operation operation);
+
+    FusableOp fusableOp() const { return toFusableOp(operation()); }
+    static FusableOp toFusableOp(Operation operation);
+    // 从保存的节点状态（save() 的结果）解析运算符，未知取值按加法处理
+    static Operation operationFromState(const QJsonObject& state);
+    static ColumnOp toColumnOp(Operation operation);
+
+signals:
+    // 运算符改变会影响执行计划（表达式融合）
+    void operationChanged();
+
+private:
+    void recompute();
+
+    QComboBox* m_comboBox = nullptr;
+    Operation m_operation = Operation::Add;
+    double m_inputs[2] = {0.0, 0.0};
+    bool m_connected[2] = {false, false};
+    std::shared_ptr<NumberData> m_result;
+};
+
+// 文本显示节点：显示输入的数值。输入可以高频变化，标签最多每 RepaintIntervalMs 刷新一次
+class TextDisplayModel : public NodeDelegateModel
+{
+    Q_OBJECT
+public:
+    static constexpr int RepaintIntervalMs = 33;
+
+    TextDisplayModel();
+
+    QString caption() const override { return "文本显示"; }
+    QString name() const override { return "TextDisplay"; }
+
+    unsigned int nPorts(PortType portType) const override;
+    NodeDataType dataType(PortType portType, PortIndex portIndex) const override;
+    std::shared_ptr<NodeData> outData(PortIndex port) override;
+    void setInData(std::shared_ptr<NodeData> data, PortIndex portIndex) override;
+    QWidget* embeddedWidget() override;
+    QJsonObject save() const override;
+    void load(QJsonObject const& json) override;
+
+    QString text() const { return m_text; }
+
+private:
+    void repaint();
+
+    QLabel* m_label = nullptr;
+    QTimer m_repaintTimer;
+    QString m_text;
+};
+
+#endif // NODEEDITORDEMO_MATHNODES_H
\ No newline at end of file
@@ -0,0 +1,48 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "NodeCostModel.h"
+
+void NodeCostModel::record(NodeTypeId type, qint64 wallNs)
+{
+    if (type == InvalidNodeTypeId) return;
+
+    const double* previous = m_costs.find(type);
+    const double cost = previous ? *previous + Smoothing * (wallNs - *previous) : static_cast<double>(wallNs);
+    m_totalCost += cost - (previous ? *previous : 0.0);
+    m_costs.set(type, cost);
+}
+
+qint64 NodeCostModel::estimate(NodeTypeId type) const
+{
+    if (const double* cost = m_costs.find(type)) {
+        return static_cast<qint64>(*cost);
+    }
+    return m_costs.isEmpty() ? DefaultCostNs : static_cast<qint64>(m_totalCost / m_costs.size());
+}
+
+void NodeCostModel::clear()
+{
+    m_costs = NodeTypeTable<double>();
+    m_totalCost = 0.0;
+}
+
+QJsonObject NodeCostModel::toJson() const
+{
+    QJsonObject json;
+    for (NodeTypeId type : m_costs.types()) {
+        json[NodeTypeIds::name(type)] = *m_costs.find(type);
+    }
+    return json;
+}
+
+void NodeCostModel::fromJson(const QJsonObject& json)
+{
+    clear();
+    for (auto it = json.begin(); it != json.end(); ++it) {
+        const double cost = it.value().toDouble();
+        m_costs.set(it.key(), cost);
+        m_totalCost += cost;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_NODECOSTMODEL_H
+#define NODEEDITORDEMO_NODECOSTMODEL_H
+
+#include "NodeTypeId.h"
+#include <QJsonObject>
+
+// 按节点类型统计的历史执行耗时（指数滑动平均），调度器据此估计关键路径。
+// 只在调度线程上读写，不加锁
+class NodeCostModel
+{
+public:
+    // 新样本的权重
+    static constexpr double Smoothing = 0.2;
+    // 没有任何历史时每个节点的估计耗时
+    static constexpr qint64 DefaultCostNs = 1000000;
+
+    void record(NodeTypeId type, qint64 wallNs);
+    bool hasHistory(NodeTypeId type) const { return m_costs.contains(type); }
+    // 没有记录的类型使用已知类型的平均值
+    qint64 estimate(NodeTypeId type) const;
+    void clear();
+
+    // 按类型名保存，可以在多次启动之间保留
+    QJsonObject toJson() const;
+    void fromJson(const QJsonObject& json);
+
+private:
+    NodeTypeTable<double> m_costs;
+    double m_totalCost = 0.0;
+};
+
+#endif // NODEEDITORDEMO_NODECOSTMODEL_H
\ No newline at end of file
@@ -4,11 +4,87 @@
 
 #include "NodeEditorCore.h"
 #include "BasicNodes.h"
+#include "BufferNodes.h"
+#include "DistributedExecutor.h"
+#include "ExecutionOverlay.h"
+#include "ExecutionStateOverlay.h"
+#include "ExecutorWorkerPool.h"
+#include "FlowValidator.h"
+#include "GroupNodeModel.h"
+#include "Logging.h"
+#include "MathNodes.h"
+#include "NodeSearchIndex.h"
+#include "SelectionDragController.h"
 #include <QtNodes/ConnectionStyle>
+#include <QtNodes/internal/ConnectionGraphicsObject.hpp>
+#include <QtNodes/internal/NodeGraphicsObject.hpp>
 #include <QtNodes/StyleCollection>
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QMetaMethod>
 #include <QStack>
+#include <QThread>
 #include <QSet>
-#include <QDebug>
+#include <algorithm>
+#include <tuple>
+#include <unordered_set>
+
+namespace {
+
+// 析构时等待调度线程池中仍在运行的执行的最长时间
+constexpr int SchedulerShutdownWaitMs = 2000;
+
+// 插件通过它注册节点，注册结果与内置节点相同
+class CorePluginContext : public NodePluginContext
+{
+public:
+    explicit CorePluginContext(NodeEditorCore& core) : m_core(core) {}
+
+    NodeDelegateModelRegistry& registry() override { return *m_core.registry(); }
+    void registerTypedNodeExecutor(const QString& nodeType, TypedNodeExecutor executor) override
+    {
+        m_core.registerTypedNodeExecutor(nodeType, std::move(executor));
+    }
+    void registerBoundNodeExecutor(const QString& nodeType, NodeExecutorBinder binder) override
+    {
+        m_core.registerBoundNodeExecutor(nodeType, std::move(binder));
+    }
+    void registerBatchNodeExecutor(const QString& nodeType, BatchNodeExecutor executor) override
+    {
+        m_core.registerBatchNodeExecutor(nodeType, std::move(executor));
+    }
+    void registerFusableNode(const QString& nodeType, FusableResolver resolver) override
+    {
+        m_core.registerFusableNode(nodeType, std::move(resolver));
+    }
+
+private:
+    NodeEditorCore& m_core;
+};
+
+// 场景 JSON 中引用的节点类型，包括组节点子图中的类型
+void collectNodeTypes(const QJsonObject& graphJson, QSet<QString>& types)
+{
+    for (const QJsonValue& value : graphJson["nodes"].toArray()) {
+        const QJsonObject internalData = value.toObject()["internal-data"].toObject();
+        const QString modelName = internalData["model-name"].toString();
+        if (!modelName.isEmpty()) {
+            types.insert(modelName);
+        }
+        if (internalData.contains("subgraph")) {
+            collectNodeTypes(internalData["subgraph"].toObject(), types);
+        }
+    }
+}
+
+// 端口键：(节点, 端口) 打包为一个整数
+quint64 portKey(NodeId nodeId, PortIndex port)
+{
+    return (static_cast<quint64>(nodeId) << 32) | port;
+}
+
+} // namespace
 
 NodeEditorCore::NodeEditorCore(QObject* parent)
     : QObject(parent)
@@ -21,6 +97,13 @@ NodeEditorCore::NodeEditorCore(QObject* parent)
 
 NodeEditorCore::~NodeEditorCore()
 {
+    // 超时被放弃的执行无法中止，~QThreadPool 会无限期等待它们；
+    // 等待超过上限时不再销毁线程池，剩下的线程交给进程退出回收
+    m_schedulerPool->clear();
+    if (!m_schedulerPool->waitForDone(SchedulerShutdownWaitMs)) {
+        qCWarning(lcCore) << "仍有" << m_abandonedTasks->load() << "个超时的节点执行未返回，不再等待";
+        Q_UNUSED(m_schedulerPool.release());
+    }
     delete m_view;
     delete m_scene;
 }
@@ -28,7 +111,10 @@ NodeEditorCore::~NodeEditorCore()
 bool NodeEditorCore::initialize()
 {
     try {
-        qDebug() << "初始化 NodeEditorCore";
+        qCDebug(lcCore) << "初始化 NodeEditorCore";
+
+        qRegisterMetaType<SharedBuffer>("SharedBuffer");
+        qRegisterMetaType<FlowDiagnostic>("FlowDiagnostic");
 
         m_registry = std::make_shared<NodeDelegateModelRegistry>();
         registerNodeModels();
@@ -42,6 +128,9 @@ bool NodeEditorCore::initialize()
         m_view->setRenderHint(QPainter::Antialiasing);
         m_view->setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
         m_view->setDragMode(QGraphicsView::RubberBandDrag);
+        // 选中大量节点时由它接管拖动，按帧批量移动
+        m_selectionDrag = new SelectionDragController(*this, this);
+        m_view->viewport()->installEventFilter(m_selectionDrag);
 
         QtNodes::ConnectionStyle::setConnectionStyle(R"({
             "ConnectionStyle": {
@@ -58,15 +147,22 @@ bool NodeEditorCore::initialize()
 
         registerNodeExecutors();
 
+        // 插件只读取元数据，场景用到其中的类型时才加载
+        loadPlugins(QCoreApplication::applicationDirPath() + "/plugins");
+
         setupConnections();
 
+        // 校验器在核心的信号连接之后创建，保证收到变化通知时快照已被标记为过期
+        m_validator = new FlowValidator(*this, this);
+        m_searchIndex = new NodeSearchIndex(*this, this);
+
         m_scene->setSceneRect(-1000, -1000, 2000, 2000);
 
-        qDebug() << "NodeEditorCore 初始化完成";
+        qCDebug(lcCore) << "NodeEditorCore 初始化完成";
         return true;
 
     } catch (const std::exception& e) {
-        qCritical() << "初始化失败:" << e.what();
+        qCCritical(lcCore) << "初始化失败:" << e.what();
         return false;
     }
 }
@@ -74,71 +170,168 @@ bool NodeEditorCore::initialize()
 void NodeEditorCore::registerNodeModels()
 {
     if (!m_registry) {
-        qWarning() << "注册表未初始化";
+        qCWarning(lcCore) << "注册表未初始化";
         return;
     }
 
     try {
         m_registry->registerModel<StartNodeModel>();
         m_registry->registerModel<EndNodeModel>();
+        m_registry->registerModel<GroupNodeModel>();
+        m_registry->registerModel<MathOperationModel>();
+        m_registry->registerModel<TextDisplayModel>();
+        m_registry->registerModel<FileSourceModel>();
+        m_registry->registerModel<BufferInfoModel>();
 
-        qDebug() << "注册节点模型: StartNode, EndNode";
+        qCDebug(lcCore) << "注册节点模型: StartNode, EndNode, GroupNode, MathOperation, TextDisplay, FileSource, BufferInfo";
 
     } catch (const std::exception& e) {
-        qCritical() << "注册节点模型失败:" << e.what();
+        qCCritical(lcCore) << "注册节点模型失败:" << e.what();
     }
 }
 
 void NodeEditorCore::registerNodeExecutors()
 {
-    registerNodeExecutor("StartNode", [this](NodeId nodeId, const QVariantMap& inputs) {
-        qDebug() << "执行开始节点" << nodeId;
-        return QVariant("flow_started");
+    registerTypedNodeExecutor("StartNode", [](NodeId nodeId, const NodeInputs& inputs) {
+        qCDebug(lcExec) << "执行开始节点" << nodeId;
+        return NodeValue(QStringLiteral("flow_started"));
     });
 
-    registerNodeExecutor("EndNode", [this](NodeId nodeId, const QVariantMap& inputs) {
-        qDebug() << "执行结束节点" << nodeId;
+    registerTypedNodeExecutor("EndNode", [](NodeId nodeId, const NodeInputs& inputs) {
+        qCDebug(lcExec) << "执行结束节点" << nodeId;
 
-        if (inputs.contains("input0")) {
-            qDebug() << "结束节点接收到输入:" << inputs["input0"];
-            return QVariant("flow_completed_with_input");
+        if (inputs.has(0)) {
+            qCDebug(lcExec) << "结束节点接收到输入:" << inputs[0].toVariant();
+            return NodeValue(QStringLiteral("flow_completed_with_input"));
         } else {
-            qDebug() << "结束节点无输入";
-            return QVariant("flow_completed_no_input");
+            qCDebug(lcExec) << "结束节点无输入";
+            return NodeValue(QStringLiteral("flow_completed_no_input"));
         }
     });
 
-    qDebug() << "注册节点执行器: StartNode, EndNode";
+    // 组节点执行自己缓存的子图计划
+    registerTypedNodeExecutor("GroupNode", [this](NodeId nodeId, const NodeInputs& inputs) {
+        auto* group = m_graphModel->delegateModel<GroupNodeModel>(nodeId);
+        if (!group) {
+            throw std::runtime_error(QString("组节点不存在: %1").arg(nodeId).toStdString());
+        }
+        return group->execute(inputs, m_nodeExecutors, m_executorBinders, m_executorGeneration);
+    });
+
+    // 数学运算节点：标量输入可参与表达式融合，列输入按块调用向量化内核。
+    // 运算符在构建执行计划时从节点状态读取，组节点子图中的数学节点同样适用
+    auto kernels = std::make_shared<std::vector<ColumnKernel>>();
+    for (int op = 0; op <= static_cast<int>(MathOperationModel::Operation::Max); ++op) {
+        auto operation = static_cast<MathOperationModel::Operation>(op);
+        kernels->push_back(ColumnKernels::binary(MathOperationModel::toColumnOp(operation)));
+    }
+    registerBoundNodeExecutor("MathOperation", [kernels](const QJsonObject& state) {
+        const auto operation = MathOperationModel::operationFromState(state);
+        return ColumnKernels::toNodeExecutor((*kernels)[static_cast<int>(operation)],
+                                             ExpressionFusion::makeExecutor(MathOperationModel::toFusableOp(operation)));
+    });
+    m_fusableNodes.set("MathOperation", [](const QJsonObject& state) {
+        return MathOperationModel::toFusableOp(MathOperationModel::operationFromState(state));
+    });
+    // 流式执行的批量执行器同样在开始执行时按运算符绑定
+    registerBoundBatchNodeExecutor("MathOperation", [kernels](const QJsonObject& state) {
+        const auto operation = MathOperationModel::operationFromState(state);
+        return ColumnKernels::toBatchExecutor((*kernels)[static_cast<int>(operation)]);
+    });
+
+    // 文本显示节点原样输出收到的值
+    registerTypedNodeExecutor("TextDisplay", [](NodeId, const NodeInputs& inputs) {
+        return inputs[0];
+    });
+
+    // 文件数据节点每次执行重新读取文件，下游拿到的都是同一个缓冲区句柄
+    registerBoundNodeExecutor("FileSource", [](const QJsonObject& state) -> TypedNodeExecutor {
+        const QString filePath = FileSourceModel::filePathFromState(state);
+        return [filePath](NodeId nodeId, const NodeInputs&) {
+            SharedBuffer buffer = FileSourceModel::loadFile(filePath);
+            if (buffer.isNull()) {
+                throw std::runtime_error(QString("节点 %1 无法读取文件: %2").arg(nodeId).arg(filePath).toStdString());
+            }
+            return NodeValue(std::move(buffer));
+        };
+    });
+    // 数据块信息节点原样输出收到的句柄
+    registerTypedNodeExecutor("BufferInfo", [](NodeId, const NodeInputs& inputs) {
+        return inputs[0];
+    });
+
+    qCDebug(lcCore) << "注册节点执行器: StartNode, EndNode, GroupNode, MathOperation, TextDisplay, FileSource, BufferInfo";
 }
 
 void NodeEditorCore::setupConnections()
 {
     if (!m_graphModel) return;
 
+    // 批量操作期间只记录变化，结束时统一通知一次
     connect(m_graphModel.get(), &DataFlowGraphModel::nodeCreated,
             this, [this](NodeId nodeId) {
-        qDebug() << "节点创建:" << nodeId;
+        markGraphChanged();
+        ++m_liveNodeCount;
+        // 类型只在创建时读取一次并驻留
+        m_nodeTypeIds.insert(nodeId, NodeTypeIds::intern(m_graphModel->nodeData(nodeId, NodeRole::Type).toString()));
+        // 运算符影响执行计划（表达式融合），改变时重建
+        if (auto* math = m_graphModel->delegateModel<MathOperationModel>(nodeId)) {
+            connect(math, &MathOperationModel::operationChanged, this, [this, nodeId]() {
+                invalidateExecutionPlan();
+                if (m_searchIndex) {
+                    m_searchIndex->invalidateNode(nodeId);
+                }
+                setModified(true);
+            });
+        }
+        if (auto* source = m_graphModel->delegateModel<FileSourceModel>(nodeId)) {
+            connect(source, &FileSourceModel::filePathChanged, this, [this]() {
+                invalidateExecutionPlan();
+                setModified(true);
+            });
+        }
+        if (m_batchDepth > 0) {
+            m_batchAddedNodes.append(nodeId);
+            return;
+        }
+        qCDebug(lcGraph) << "节点创建:" << nodeId;
         emit nodeAdded(nodeId);
         setModified(true);
     });
 
     connect(m_graphModel.get(), &DataFlowGraphModel::nodeDeleted,
             this, [this](NodeId nodeId) {
-        qDebug() << "节点删除:" << nodeId;
+        markGraphChanged();
+        --m_liveNodeCount;
+        m_pinnedResults.remove(nodeId);
+        m_checkpointedNodes.remove(nodeId);
+        m_nodePriorities.remove(nodeId);
+        m_nodeTypeIds.remove(nodeId);
+        if (m_batchDepth > 0) {
+            m_batchRemovedNodes.append(nodeId);
+            return;
+        }
+        qCDebug(lcGraph) << "节点删除:" << nodeId;
         emit nodeRemoved(nodeId);
         setModified(true);
     });
 
     connect(m_graphModel.get(), &DataFlowGraphModel::connectionCreated,
             this, [this](ConnectionId const& connectionId) {
-        qDebug() << "连接创建:" << connectionIdToString(connectionId);
+        markGraphChanged();
+        ++m_liveConnectionCount;
+        if (m_batchDepth > 0) return;
+        qCDebug(lcGraph) << "连接创建:" << connectionIdToString(connectionId);
         emit connectionAdded(connectionId);
         setModified(true);
     });
 
     connect(m_graphModel.get(), &DataFlowGraphModel::connectionDeleted,
             this, [this](ConnectionId const& connectionId) {
-        qDebug() << "连接删除:" << connectionIdToString(connectionId);
+        markGraphChanged();
+        --m_liveConnectionCount;
+        if (m_batchDepth > 0) return;
+        qCDebug(lcGraph) << "连接删除:" << connectionIdToString(connectionId);
         emit connectionRemoved(connectionId);
         setModified(true);
     });
@@ -147,14 +340,19 @@ void NodeEditorCore::setupConnections()
 NodeId NodeEditorCore::addNode(const QString& nodeType, const QPointF& position)
 {
     if (!m_graphModel) {
-        qWarning() << "图形模型未初始化";
+        qCWarning(lcGraph) << "图形模型未初始化";
+        return InvalidNodeId;
+    }
+
+    if (!ensureNodeType(nodeType)) {
+        qCWarning(lcGraph) << "添加节点失败，未注册的节点类型:" << nodeType;
         return InvalidNodeId;
     }
 
     try {
         NodeId nodeId = m_graphModel->addNode(nodeType);
         if (nodeId == InvalidNodeId) {
-            qWarning() << "添加节点失败，类型:" << nodeType;
+            qCWarning(lcGraph) << "添加节点失败，类型:" << nodeType;
             return InvalidNodeId;
         }
 
@@ -162,12 +360,12 @@ NodeId NodeEditorCore::addNode(const QString& nodeType, const QPointF& position)
         m_graphModel->setNodeData(nodeId, NodeRole::Position, finalPosition);
 
         m_nodeCounter++;
-        qDebug() << "添加节点成功 - 类型:" << nodeType << "ID:" << nodeId << "位置:" << finalPosition;
+        qCDebug(lcGraph) << "添加节点成功 - 类型:" << nodeType << "ID:" << nodeId << "位置:" << finalPosition;
 
         return nodeId;
 
     } catch (const std::exception& e) {
-        qCritical() << "添加节点异常:" << e.what();
+        qCCritical(lcGraph) << "添加节点异常:" << e.what();
         return InvalidNodeId;
     }
 }
@@ -182,14 +380,14 @@ bool NodeEditorCore::removeNode(NodeId nodeId)
         bool success = m_graphModel->deleteNode(nodeId);
         if (success) {
             m_nodeCounter--;
-            qDebug() << "删除节点成功，ID:" << nodeId;
+            qCDebug(lcGraph) << "删除节点成功，ID:" << nodeId;
         } else {
-            qWarning() << "删除节点失败，ID:" << nodeId;
+            qCWarning(lcGraph) << "删除节点失败，ID:" << nodeId;
         }
         return success;
 
     } catch (const std::exception& e) {
-        qCritical() << "删除节点异常:" << e.what();
+        qCCritical(lcGraph) << "删除节点异常:" << e.what();
         return false;
     }
 }
@@ -198,7 +396,7 @@ void NodeEditorCore::setNodePosition(NodeId nodeId, const QPointF& position)
 {
     if (m_graphModel && nodeId != InvalidNodeId) {
         m_graphModel->setNodeData(nodeId, NodeRole::Position, position);
-        qDebug() << "设置节点位置 - ID:" << nodeId << "位置:" << position;
+        qCDebug(lcGraph) << "设置节点位置 - ID:" << nodeId << "位置:" << position;
     }
 }
 
@@ -215,11 +413,11 @@ ConnectionId NodeEditorCore::addConnection(NodeId sourceNode, PortIndex sourcePo
         // 修复：addConnection 返回 void，不返回 bool
         m_graphModel->addConnection(connectionId);
 
-        qDebug() << "添加连接成功 -" << connectionIdToString(connectionId);
+        qCDebug(lcGraph) << "添加连接成功 -" << connectionIdToString(connectionId);
         return connectionId;
 
     } catch (const std::exception& e) {
-        qCritical() << "添加连接异常:" << e.what();
+        qCCritical(lcGraph) << "添加连接异常:" << e.what();
         return InvalidConnectionId;
     }
 }
@@ -237,245 +435,1665 @@ bool NodeEditorCore::removeConnection(ConnectionId connectionId)
     try {
         // 修复：deleteConnection 返回 void，不返回 bool
         m_graphModel->deleteConnection(connectionId);
-        qDebug() << "删除连接成功 -" << connectionIdToString(connectionId);
+        qCDebug(lcGraph) << "删除连接成功 -" << connectionIdToString(connectionId);
         return true;
 
     } catch (const std::exception& e) {
-        qCritical() << "删除连接异常:" << e.what();
+        qCCritical(lcGraph) << "删除连接异常:" << e.what();
         return false;
     }
 }
 
-QJsonObject NodeEditorCore::saveScene() const
+void NodeEditorCore::beginBatch()
 {
-    if (!m_graphModel) {
-        return QJsonObject();
+    if (m_batchDepth++ == 0) {
+        m_batchAddedNodes.clear();
+        m_batchRemovedNodes.clear();
+        // 批量期间暂停视图重绘，结束后统一刷新一次
+        if (m_view) {
+            m_view->setUpdatesEnabled(false);
+        }
     }
+}
 
-    try {
-        QJsonObject sceneData = m_graphModel->save();
-        qDebug() << "保存场景成功，节点数:" << nodeCount() << "连接数:" << connectionCount();
+void NodeEditorCore::endBatch(bool changed)
+{
+    if (--m_batchDepth > 0) return;
 
-        // 修复：移除 const 限定符来发射信号
-        const_cast<NodeEditorCore*>(this)->emit sceneSaved();
-        return sceneData;
+    if (m_view) {
+        m_view->setUpdatesEnabled(true);
+        m_view->viewport()->update();
+    }
 
-    } catch (const std::exception& e) {
-        qCritical() << "保存场景失败:" << e.what();
-        return QJsonObject();
+    QList<NodeId> added;
+    QList<NodeId> removed;
+    added.swap(m_batchAddedNodes);
+    removed.swap(m_batchRemovedNodes);
+
+    if (changed) {
+        emit graphBatchApplied(added, removed);
+        setModified(true);
     }
 }
 
-bool NodeEditorCore::loadScene(const QJsonObject& json)
+std::vector<NodeId> NodeEditorCore::addGraph(const std::vector<NodeSpec>& nodes,
+                                             const std::vector<ConnectionSpec>& connections)
 {
-    if (!m_graphModel) {
-        return false;
+    if (!m_graphModel || !m_registry) {
+        qCWarning(lcGraph) << "图形模型未初始化";
+        return {};
     }
 
-    if (json.isEmpty()) {
-        qWarning() << "加载场景失败: JSON 数据为空";
-        return false;
+    // 1. 整体校验节点类型和连接引用，任何一项不合法都不做修改
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (!ensureNodeType(nodes[i].type)) {
+            qCWarning(lcGraph) << "批量添加失败: 未注册的节点类型" << nodes[i].type << "下标:" << i;
+            return {};
+        }
+    }
+
+    const int specCount = static_cast<int>(nodes.size());
+    auto refValid = [&](int index, NodeId nodeId) {
+        if (index >= 0) return index < specCount;
+        return nodeId != InvalidNodeId && m_graphModel->nodeExists(nodeId);
+    };
+    for (size_t i = 0; i < connections.size(); ++i) {
+        const ConnectionSpec& spec = connections[i];
+        if (!refValid(spec.sourceIndex, spec.sourceNode) || !refValid(spec.targetIndex, spec.targetNode)) {
+            qCWarning(lcGraph) << "批量添加失败: 连接引用了不存在的节点，下标:" << i;
+            return {};
+        }
     }
 
+    std::vector<NodeId> createdIds;
+    createdIds.reserve(nodes.size());
+
+    auto rollback = [&]() {
+        for (NodeId nodeId : createdIds) {
+            m_graphModel->deleteNode(nodeId);
+        }
+        m_nodeCounter -= static_cast<int>(createdIds.size());
+        createdIds.clear();
+    };
+
+    beginBatch();
     try {
-        clearScene();
+        // 2. 创建节点
+        for (const NodeSpec& spec : nodes) {
+            NodeId nodeId = m_graphModel->addNode(spec.type);
+            if (nodeId == InvalidNodeId) {
+                qCWarning(lcGraph) << "批量添加失败: 创建节点失败，类型:" << spec.type;
+                rollback();
+                endBatch(false);
+                return {};
+            }
+            createdIds.push_back(nodeId);
 
-        m_graphModel->load(json);
+            QPointF finalPosition = spec.position.isNull() ? getNextNodePosition() : spec.position;
+            m_graphModel->setNodeData(nodeId, NodeRole::Position, finalPosition);
+            m_nodeCounter++;
+        }
 
-        // 修复：size_t 到 int 的转换
-        auto nodeIds = m_graphModel->allNodeIds();
-        m_nodeCounter = static_cast<int>(nodeIds.size());
+        // 3. 在添加任何连接之前确认全部连接都可以建立
+        // connectionPossible 只检查已有的连接，同一批次内的重复连接和
+        // 多条连接指向同一个单连接输入端口需要在这里检查
+        std::vector<ConnectionId> connectionIds;
+        connectionIds.reserve(connections.size());
+        std::unordered_set<ConnectionId> batchConnections;
+        std::unordered_set<quint64> occupiedInputs;
+        for (const ConnectionSpec& spec : connections) {
+            NodeId outNode = spec.sourceIndex >= 0 ? createdIds[spec.sourceIndex] : spec.sourceNode;
+            NodeId inNode = spec.targetIndex >= 0 ? createdIds[spec.targetIndex] : spec.targetNode;
+            ConnectionId connectionId{outNode, spec.sourcePort, inNode, spec.targetPort};
+
+            bool conflict = !batchConnections.insert(connectionId).second;
+            if (!conflict) {
+                const auto policy = m_graphModel->portData(inNode, PortType::In, spec.targetPort,
+                                                           PortRole::ConnectionPolicyRole).value<ConnectionPolicy>();
+                conflict = policy == ConnectionPolicy::One
+                           && !occupiedInputs.insert(portKey(inNode, spec.targetPort)).second;
+            }
+            if (conflict || !m_graphModel->connectionPossible(connectionId)) {
+                qCWarning(lcGraph) << "批量添加失败: 无法建立连接" << connectionIdToString(connectionId);
+                rollback();
+                endBatch(false);
+                return {};
+            }
+            connectionIds.push_back(connectionId);
+        }
 
-        qDebug() << "加载场景成功，节点数:" << nodeCount() << "连接数:" << connectionCount();
+        // 4. 应用连接
+        for (const ConnectionId& connectionId : connectionIds) {
+            m_graphModel->addConnection(connectionId);
+        }
 
-        emit sceneLoaded();
-        setModified(false);
-        return true;
+        qCDebug(lcGraph) << "批量添加完成 - 节点数:" << createdIds.size() << "连接数:" << connectionIds.size();
 
     } catch (const std::exception& e) {
-        qCritical() << "加载场景失败:" << e.what();
-        return false;
+        qCCritical(lcGraph) << "批量添加异常，已回滚:" << e.what();
+        rollback();
+        endBatch(false);
+        return {};
     }
+
+    endBatch(!createdIds.empty() || !connections.empty());
+    return createdIds;
 }
 
-void NodeEditorCore::clearScene()
+bool NodeEditorCore::removeNodes(const std::vector<NodeId>& nodeIds)
 {
-    if (!m_graphModel) return;
+    if (!m_graphModel) {
+        return false;
+    }
 
-    try {
-        auto nodeIds = m_graphModel->allNodeIds();
-        for (auto nodeId : nodeIds) {
-            m_graphModel->deleteNode(nodeId);
+    for (NodeId nodeId : nodeIds) {
+        if (nodeId == InvalidNodeId || !m_graphModel->nodeExists(nodeId)) {
+            qCWarning(lcGraph) << "批量删除失败: 节点不存在，ID:" << nodeId;
+            return false;
         }
-        m_nodeCounter = 0;
+    }
 
-        qDebug() << "清空场景完成";
-        setModified(true);
+    if (nodeIds.empty()) {
+        return true;
+    }
+
+    // 先保存被删除节点及其连接，异常时据此恢复
+    QList<QJsonObject> savedNodes;
+    std::vector<ConnectionId> savedConnections;
+    std::unordered_set<ConnectionId> seenConnections;
+    for (NodeId nodeId : nodeIds) {
+        savedNodes.append(m_graphModel->saveNode(nodeId));
+        for (const auto& conn : m_graphModel->allConnectionIds(nodeId)) {
+            if (seenConnections.insert(conn).second) {
+                savedConnections.push_back(conn);
+            }
+        }
+    }
+
+    beginBatch();
+    size_t deleted = 0;
+    try {
+        for (NodeId nodeId : nodeIds) {
+            if (!m_graphModel->deleteNode(nodeId)) {
+                throw std::runtime_error(QString("删除节点失败: %1").arg(nodeId).toStdString());
+            }
+            ++deleted;
+        }
+        m_nodeCounter -= static_cast<int>(deleted);
+        qCDebug(lcGraph) << "批量删除完成 - 节点数:" << deleted;
 
     } catch (const std::exception& e) {
-        qCritical() << "清空场景失败:" << e.what();
+        qCCritical(lcGraph) << "批量删除异常，正在回滚:" << e.what();
+        for (size_t i = 0; i < deleted; ++i) {
+            m_graphModel->loadNode(savedNodes[static_cast<int>(i)]);
+        }
+        for (const auto& conn : savedConnections) {
+            if (!m_graphModel->connectionExists(conn)
+                && m_graphModel->nodeExists(conn.outNodeId)
+                && m_graphModel->nodeExists(conn.inNodeId)) {
+                m_graphModel->addConnection(conn);
+            }
+        }
+        endBatch(false);
+        return false;
     }
+
+    endBatch(true);
+    return true;
 }
 
-bool NodeEditorCore::executeFlow()
+void NodeEditorCore::setNodePositions(const std::vector<std::pair<NodeId, QPointF>>& positions)
 {
-    if (!m_graphModel) {
-        qWarning() << "图形模型未初始化";
-        return false;
+    if (!m_graphModel || positions.empty()) return;
+
+    beginBatch();
+    for (const auto& entry : positions) {
+        if (entry.first != InvalidNodeId && m_graphModel->nodeExists(entry.first)) {
+            m_graphModel->setNodeData(entry.first, NodeRole::Position, entry.second);
+        }
     }
+    qCDebug(lcGraph) << "批量设置节点位置 - 节点数:" << positions.size();
+    endBatch(true);
+}
 
-    qDebug() << "开始执行数据流...";
-    emit executionStarted();
-    m_executionResults.clear();
+void NodeEditorCore::translateNodes(const std::vector<NodeId>& nodeIds, const QPointF& delta)
+{
+    if (!m_graphModel || nodeIds.empty() || delta.isNull()) return;
 
-    QList<NodeId> executionOrder = getExecutionOrder();
-    if (executionOrder.isEmpty()) {
-        qWarning() << "无法确定执行顺序，可能为空场景或循环依赖";
-        emit executionFinished(false);
-        return false;
+    beginBatch();
+    for (NodeId nodeId : nodeIds) {
+        if (!m_graphModel->nodeExists(nodeId)) continue;
+        const QPointF position = m_graphModel->nodeData(nodeId, NodeRole::Position).toPointF();
+        m_graphModel->setNodeData(nodeId, NodeRole::Position, position + delta);
     }
+    // 拖动期间每帧调用一次；位置不影响图结构，不发出 graphBatchApplied，也不逐次记录日志
+    endBatch(false);
+    setModified(true);
+}
 
-    qDebug() << "执行顺序:" << executionOrder;
+void NodeEditorCore::alignNodes(const std::vector<NodeId>& nodeIds, NodeAlignment alignment)
+{
+    if (!m_graphModel || nodeIds.size() < 2) return;
 
-    for (NodeId nodeId : executionOrder) {
-        try {
-            QVariant result = executeNode(nodeId);
-            m_executionResults[nodeId] = result;
-            emit nodeExecuted(nodeId, result);
+    std::vector<std::pair<NodeId, QRectF>> rects;
+    QRectF bounds;
+    for (NodeId nodeId : nodeIds) {
+        if (!m_graphModel->nodeExists(nodeId)) continue;
+        const QRectF rect(m_graphModel->nodeData(nodeId, NodeRole::Position).toPointF(),
+                          m_graphModel->nodeData(nodeId, NodeRole::Size).toSizeF());
+        rects.emplace_back(nodeId, rect);
+        bounds |= rect;
+    }
 
-            qDebug() << "执行节点" << nodeId << "结果:" << result;
-        } catch (const std::exception& e) {
-            qCritical() << "执行节点" << nodeId << "失败:" << e.what();
-            emit executionFinished(false);
-            return false;
+    std::vector<std::pair<NodeId, QPointF>> positions;
+    positions.reserve(rects.size());
+    for (const auto& entry : rects) {
+        QRectF rect = entry.second;
+        switch (alignment) {
+        case NodeAlignment::Left: rect.moveLeft(bounds.left()); break;
+        case NodeAlignment::HorizontalCenter: rect.moveCenter(QPointF(bounds.center().x(), rect.center().y())); break;
+        case NodeAlignment::Right: rect.moveRight(bounds.right()); break;
+        case NodeAlignment::Top: rect.moveTop(bounds.top()); break;
+        case NodeAlignment::VerticalCenter: rect.moveCenter(QPointF(rect.center().x(), bounds.center().y())); break;
+        case NodeAlignment::Bottom: rect.moveBottom(bounds.bottom()); break;
+        }
+        if (rect.topLeft() != entry.second.topLeft()) {
+            positions.emplace_back(entry.first, rect.topLeft());
         }
     }
-
-    qDebug() << "数据流执行完成";
-    emit executionFinished(true);
-    return true;
+    setNodePositions(positions);
 }
 
-QVariant NodeEditorCore::executeNode(NodeId nodeId)
+void NodeEditorCore::distributeNodes(const std::vector<NodeId>& nodeIds, Qt::Orientation orientation)
 {
-    if (!m_graphModel) {
-        throw std::runtime_error("图形模型未初始化");
+    if (!m_graphModel || nodeIds.size() < 3) return;
+
+    const bool horizontal = (orientation == Qt::Horizontal);
+    std::vector<std::pair<NodeId, QRectF>> rects;
+    for (NodeId nodeId : nodeIds) {
+        if (!m_graphModel->nodeExists(nodeId)) continue;
+        rects.emplace_back(nodeId, QRectF(m_graphModel->nodeData(nodeId, NodeRole::Position).toPointF(),
+                                          m_graphModel->nodeData(nodeId, NodeRole::Size).toSizeF()));
     }
+    if (rects.size() < 3) return;
 
-    QString nodeType = m_graphModel->nodeData(nodeId, NodeRole::Type).toString();
-    qDebug() << "执行节点:" << nodeId << "类型:" << nodeType;
+    std::sort(rects.begin(), rects.end(), [horizontal](const auto& a, const auto& b) {
+        return horizontal ? a.second.center().x() < b.second.center().x()
+                          : a.second.center().y() < b.second.center().y();
+    });
 
-    QVariantMap inputs;
-    auto connections = m_graphModel->allConnectionIds(nodeId);
-    for (const auto& conn : connections) {
-        if (conn.inNodeId == nodeId) {
-            QString inputKey = QString("input%1").arg(conn.inPortIndex);
+    // 相邻节点之间的空隙相等；节点总长超过跨度时空隙为负，节点会重叠
+    const QRectF& first = rects.front().second;
+    const QRectF& last = rects.back().second;
+    qreal occupied = 0.0;
+    for (const auto& entry : rects) {
+        occupied += horizontal ? entry.second.width() : entry.second.height();
+    }
+    const qreal span = horizontal ? last.right() - first.left() : last.bottom() - first.top();
+    const qreal gap = (span - occupied) / static_cast<qreal>(rects.size() - 1);
+
+    std::vector<std::pair<NodeId, QPointF>> positions;
+    qreal cursor = horizontal ? first.right() + gap : first.bottom() + gap;
+    for (size_t i = 1; i + 1 < rects.size(); ++i) {
+        const QRectF& rect = rects[i].second;
+        positions.emplace_back(rects[i].first, horizontal ? QPointF(cursor, rect.top()) : QPointF(rect.left(), cursor));
+        cursor += (horizontal ? rect.width() : rect.height()) + gap;
+    }
+    setNodePositions(positions);
+}
 
-            // 使用 QMap<NodeId, QVariant> 可以直接用 NodeId 作为键
-            if (m_executionResults.contains(conn.outNodeId)) {
-                inputs[inputKey] = m_executionResults[conn.outNodeId];
-                qDebug() << "输入" << inputKey << "来自节点" << conn.outNodeId
-                         << "值:" << m_executionResults[conn.outNodeId];
+int NodeEditorCore::removeSelection()
+{
+    if (!m_scene || !m_graphModel) return 0;
+
+    const std::vector<NodeId> nodeIds = m_scene->selectedNodes();
+    const std::unordered_set<NodeId> removedNodes(nodeIds.begin(), nodeIds.end());
+
+    // 一端在被删除节点上的连接随节点一起删除，这里只收集其余选中的连接
+    std::vector<ConnectionId> connections;
+    for (QGraphicsItem* item : m_scene->selectedItems()) {
+        QGraphicsObject* object = item->toGraphicsObject();
+        if (auto* connection = object ? qobject_cast<ConnectionGraphicsObject*>(object) : nullptr) {
+            const ConnectionId connectionId = connection->connectionId();
+            if (!removedNodes.count(connectionId.outNodeId) && !removedNodes.count(connectionId.inNodeId)) {
+                connections.push_back(connectionId);
             }
         }
     }
+    if (nodeIds.empty() && connections.empty()) return 0;
 
-    if (m_nodeExecutors.contains(nodeType)) {
-        return m_nodeExecutors[nodeType](nodeId, inputs);
-    } else {
-        throw std::runtime_error(QString("未注册的执行器: %1").arg(nodeType).toStdString());
+    beginBatch();
+    std::vector<ConnectionId> deletedConnections;
+    for (const ConnectionId& connectionId : connections) {
+        if (m_graphModel->deleteConnection(connectionId)) {
+            deletedConnections.push_back(connectionId);
+        }
+    }
+    const bool success = removeNodes(nodeIds);
+    if (!success) {
+        // 节点删除已回滚，已删除的连接一并恢复
+        for (const ConnectionId& connectionId : deletedConnections) {
+            if (!m_graphModel->connectionExists(connectionId)) {
+                m_graphModel->addConnection(connectionId);
+            }
+        }
+        endBatch(false);
+        qCWarning(lcGraph) << "删除选中项失败，已恢复";
+        return 0;
     }
+    endBatch(true);
+
+    qCDebug(lcGraph) << "删除选中项 - 节点数:" << nodeIds.size() << "连接数:" << deletedConnections.size();
+    return static_cast<int>(nodeIds.size() + deletedConnections.size());
 }
 
-QVariantMap NodeEditorCore::getExecutionResults() const
+NodeId NodeEditorCore::groupNodes(const std::vector<NodeId>& nodeIds)
 {
-    // 如果需要返回 QVariantMap，可以转换一下
-    QVariantMap result;
-    for (auto it = m_executionResults.begin(); it != m_executionResults.end(); ++it) {
-        result[QString::number(it.key())] = it.value();
+    if (!m_graphModel || nodeIds.empty()) {
+        return InvalidNodeId;
     }
-    return result;
-}
 
-QList<NodeId> NodeEditorCore::getExecutionOrder() const
-{
-    if (!m_graphModel) {
-        return QList<NodeId>();
+    QSet<NodeId> members;
+    for (NodeId nodeId : nodeIds) {
+        if (nodeId == InvalidNodeId || !m_graphModel->nodeExists(nodeId)) {
+            qCWarning(lcGraph) << "组合失败: 节点不存在，ID:" << nodeId;
+            return InvalidNodeId;
+        }
+        members.insert(nodeId);
+    }
+    std::vector<NodeId> sorted(members.begin(), members.end());
+    std::sort(sorted.begin(), sorted.end());
+
+    // 1. 子图节点以及内部、流入、流出三类连接
+    QList<QJsonObject> savedNodes;
+    QJsonArray nodesJson;
+    std::vector<ConnectionId> internal;
+    std::vector<ConnectionId> incoming;
+    std::vector<ConnectionId> outgoing;
+    QSet<quint64> fedInternally;
+    QSet<quint64> consumedInternally;
+    QPointF center;
+
+    for (NodeId nodeId : sorted) {
+        QJsonObject nodeJson = m_graphModel->saveNode(nodeId);
+        savedNodes.append(nodeJson);
+
+        // 子图编译时不实例化节点模型，端口数直接记录在条目中（类型见 internal-data 的 model-name）
+        nodeJson["in-port-count"] = static_cast<int>(m_graphModel->nodeData(nodeId, NodeRole::InPortCount).toUInt());
+        nodeJson["out-port-count"] = static_cast<int>(m_graphModel->nodeData(nodeId, NodeRole::OutPortCount).toUInt());
+        nodesJson.append(nodeJson);
+
+        center += m_graphModel->nodeData(nodeId, NodeRole::Position).toPointF();
+
+        for (const auto& conn : m_graphModel->allConnectionIds(nodeId)) {
+            bool outInside = members.contains(conn.outNodeId);
+            bool inInside = members.contains(conn.inNodeId);
+            if (outInside && inInside) {
+                if (conn.inNodeId == nodeId) {
+                    internal.push_back(conn);
+                    fedInternally.insert(portKey(conn.inNodeId, conn.inPortIndex));
+                    consumedInternally.insert(portKey(conn.outNodeId, conn.outPortIndex));
+                }
+            } else if (inInside) {
+                incoming.push_back(conn);
+            } else {
+                outgoing.push_back(conn);
+            }
+        }
+    }
+    center /= static_cast<qreal>(sorted.size());
+
+    // 2. 组的外部端口：没有被子图内部连接占用的输入、输出端口
+    QVector<GroupPort> inputs;
+    QVector<GroupPort> outputs;
+    QHash<quint64, int> inputIndex;
+    QHash<quint64, int> outputIndex;
+    for (NodeId nodeId : sorted) {
+        unsigned int inCount = m_graphModel->nodeData(nodeId, NodeRole::InPortCount).toUInt();
+        for (PortIndex port = 0; port < inCount; ++port) {
+            if (fedInternally.contains(portKey(nodeId, port))) continue;
+            inputIndex.insert(portKey(nodeId, port), inputs.size());
+            inputs.append(GroupPort{nodeId, port,
+                                    m_graphModel->portData(nodeId, PortType::In, port, PortRole::DataType).value<NodeDataType>()});
+        }
+        unsigned int outCount = m_graphModel->nodeData(nodeId, NodeRole::OutPortCount).toUInt();
+        for (PortIndex port = 0; port < outCount; ++port) {
+            if (consumedInternally.contains(portKey(nodeId, port))) continue;
+            outputIndex.insert(portKey(nodeId, port), outputs.size());
+            outputs.append(GroupPort{nodeId, port,
+                                     m_graphModel->portData(nodeId, PortType::Out, port, PortRole::DataType).value<NodeDataType>()});
+        }
     }
 
-    QList<NodeId> executionOrder;
-    QSet<NodeId> visited;
-    QSet<NodeId> tempMark;
+    QJsonArray connectionsJson;
+    for (const ConnectionId& conn : internal) {
+        connectionsJson.append(GroupNodeModel::connectionToJson(conn));
+    }
+    QJsonObject subgraph;
+    subgraph["nodes"] = nodesJson;
+    subgraph["connections"] = connectionsJson;
 
-    auto nodeIds = m_graphModel->allNodeIds();
+    // 3. 删除原节点，创建组节点并改接外部连接
+    beginBatch();
+    NodeId groupId = InvalidNodeId;
+    try {
+        for (NodeId nodeId : sorted) {
+            if (!m_graphModel->deleteNode(nodeId)) {
+                throw std::runtime_error(QString("删除节点失败: %1").arg(nodeId).toStdString());
+            }
+        }
 
-    std::function<bool(NodeId)> dfs = [&](NodeId nodeId) {
-        if (tempMark.contains(nodeId)) {
-            qWarning() << "发现循环依赖，节点:" << nodeId;
-            return false;
+        groupId = m_graphModel->newNodeId();
+        QJsonObject groupJson;
+        groupJson["id"] = static_cast<qint64>(groupId);
+        groupJson["internal-data"] = GroupNodeModel::makeInternalData(subgraph, inputs, outputs, center);
+        groupJson["position"] = QJsonObject{{"x", center.x()}, {"y", center.y()}};
+        m_graphModel->loadNode(groupJson);
+        if (!m_graphModel->nodeExists(groupId)) {
+            throw std::runtime_error("创建组节点失败");
         }
-        if (visited.contains(nodeId)) {
-            return true;
+
+        for (const ConnectionId& conn : incoming) {
+            PortIndex port = static_cast<PortIndex>(inputIndex.value(portKey(conn.inNodeId, conn.inPortIndex)));
+            m_graphModel->addConnection(ConnectionId{conn.outNodeId, conn.outPortIndex, groupId, port});
+        }
+        for (const ConnectionId& conn : outgoing) {
+            PortIndex port = static_cast<PortIndex>(outputIndex.value(portKey(conn.outNodeId, conn.outPortIndex)));
+            m_graphModel->addConnection(ConnectionId{groupId, port, conn.inNodeId, conn.inPortIndex});
         }
 
-        tempMark.insert(nodeId);
+        m_nodeCounter -= static_cast<int>(sorted.size()) - 1;
+        qCDebug(lcGraph) << "组合完成 - 组节点:" << groupId << "子图节点数:" << sorted.size()
+                         << "输入端口:" << inputs.size() << "输出端口:" << outputs.size();
 
-        auto connections = m_graphModel->allConnectionIds(nodeId);
-        for (const auto& connection : connections) {
-            if (connection.inNodeId == nodeId) {
-                if (!dfs(connection.outNodeId)) {
-                    return false;
+    } catch (const std::exception& e) {
+        qCCritical(lcGraph) << "组合异常，正在回滚:" << e.what();
+        if (groupId != InvalidNodeId && m_graphModel->nodeExists(groupId)) {
+            m_graphModel->deleteNode(groupId);
+        }
+        for (const QJsonObject& nodeJson : savedNodes) {
+            if (!m_graphModel->nodeExists(static_cast<NodeId>(nodeJson["id"].toInt()))) {
+                m_graphModel->loadNode(nodeJson);
+            }
+        }
+        for (const auto* list : {&internal, &incoming, &outgoing}) {
+            for (const ConnectionId& conn : *list) {
+                if (!m_graphModel->connectionExists(conn)
+                    && m_graphModel->nodeExists(conn.outNodeId)
+                    && m_graphModel->nodeExists(conn.inNodeId)) {
+                    m_graphModel->addConnection(conn);
                 }
             }
         }
+        endBatch(false);
+        return InvalidNodeId;
+    }
+
+    endBatch(true);
+    return groupId;
+}
+
+std::vector<NodeId> NodeEditorCore::ungroupNode(NodeId groupId)
+{
+    if (!m_graphModel) return {};
+
+    auto* group = m_graphModel->delegateModel<GroupNodeModel>(groupId);
+    if (!group) {
+        qCWarning(lcGraph) << "展开失败: 不是组节点，ID:" << groupId;
+        return {};
+    }
+
+    const QJsonObject subgraph = group->subgraph();
+    const QVector<GroupPort> inputs = group->inputs();
+    const QVector<GroupPort> outputs = group->outputs();
+    const QPointF offset = m_graphModel->nodeData(groupId, NodeRole::Position).toPointF() - group->origin();
+    const QJsonObject savedGroup = m_graphModel->saveNode(groupId);
+    const auto externalSet = m_graphModel->allConnectionIds(groupId);
+    const std::vector<ConnectionId> external(externalSet.begin(), externalSet.end());
+
+    std::vector<NodeId> createdIds;
+    QHash<NodeId, NodeId> idMap;
+
+    beginBatch();
+    try {
+        if (!m_graphModel->deleteNode(groupId)) {
+            throw std::runtime_error(QString("删除组节点失败: %1").arg(groupId).toStdString());
+        }
+
+        // 子图节点使用新的 ID，位置随组节点一起平移
+        for (const QJsonValue& value : subgraph["nodes"].toArray()) {
+            QJsonObject nodeJson = value.toObject();
+            NodeId oldId = static_cast<NodeId>(nodeJson["id"].toInt());
+            NodeId newId = m_graphModel->newNodeId();
+            idMap.insert(oldId, newId);
+
+            QJsonObject position = nodeJson["position"].toObject();
+            nodeJson["id"] = static_cast<qint64>(newId);
+            nodeJson["position"] = QJsonObject{{"x", position["x"].toDouble() + offset.x()},
+                                               {"y", position["y"].toDouble() + offset.y()}};
+            nodeJson.remove("in-port-count");
+            nodeJson.remove("out-port-count");
+            m_graphModel->loadNode(nodeJson);
+            if (!m_graphModel->nodeExists(newId)) {
+                throw std::runtime_error(QString("恢复子图节点失败: %1").arg(oldId).toStdString());
+            }
+            createdIds.push_back(newId);
+        }
 
-        tempMark.remove(nodeId);
-        visited.insert(nodeId);
-        executionOrder.prepend(nodeId);
+        for (const QJsonValue& value : subgraph["connections"].toArray()) {
+            ConnectionId conn = GroupNodeModel::connectionFromJson(value.toObject());
+            m_graphModel->addConnection(ConnectionId{idMap.value(conn.outNodeId), conn.outPortIndex,
+                                                     idMap.value(conn.inNodeId), conn.inPortIndex});
+        }
 
-        return true;
-    };
+        for (const ConnectionId& conn : external) {
+            if (conn.inNodeId == groupId && conn.inPortIndex < static_cast<PortIndex>(inputs.size())) {
+                const GroupPort& port = inputs[static_cast<int>(conn.inPortIndex)];
+                m_graphModel->addConnection(ConnectionId{conn.outNodeId, conn.outPortIndex,
+                                                         idMap.value(port.node), port.port});
+            } else if (conn.outNodeId == groupId && conn.outPortIndex < static_cast<PortIndex>(outputs.size())) {
+                const GroupPort& port = outputs[static_cast<int>(conn.outPortIndex)];
+                m_graphModel->addConnection(ConnectionId{idMap.value(port.node), port.port,
+                                                         conn.inNodeId, conn.inPortIndex});
+            }
+        }
 
-    for (NodeId nodeId : nodeIds) {
-        if (!visited.contains(nodeId)) {
-            if (!dfs(nodeId)) {
-                qWarning() << "发现循环依赖，无法确定执行顺序";
-                return QList<NodeId>();
+        m_nodeCounter += static_cast<int>(createdIds.size()) - 1;
+        qCDebug(lcGraph) << "展开完成 - 组节点:" << groupId << "恢复节点数:" << createdIds.size();
+
+    } catch (const std::exception& e) {
+        qCCritical(lcGraph) << "展开异常，正在回滚:" << e.what();
+        for (NodeId nodeId : createdIds) {
+            m_graphModel->deleteNode(nodeId);
+        }
+        if (!m_graphModel->nodeExists(groupId)) {
+            m_graphModel->loadNode(savedGroup);
+        }
+        for (const ConnectionId& conn : external) {
+            if (!m_graphModel->connectionExists(conn)
+                && m_graphModel->nodeExists(conn.outNodeId)
+                && m_graphModel->nodeExists(conn.inNodeId)) {
+                m_graphModel->addConnection(conn);
             }
         }
+        endBatch(false);
+        return {};
     }
 
-    return executionOrder;
+    endBatch(true);
+    return createdIds;
 }
 
-int NodeEditorCore::nodeCount() const
+QJsonObject NodeEditorCore::saveScene() const
 {
-    if (!m_graphModel) return 0;
-    auto nodes = m_graphModel->allNodeIds();
-    return static_cast<int>(nodes.size());
-}
+    if (!m_graphModel) {
+        return QJsonObject();
+    }
 
-int NodeEditorCore::connectionCount() const
-{
-    if (!m_graphModel) return 0;
+    try {
+        QJsonObject sceneData = m_graphModel->save();
+        if (!m_nodePriorities.isEmpty()) {
+            QJsonObject priorities;
+            for (auto it = m_nodePriorities.constBegin(); it != m_nodePriorities.constEnd(); ++it) {
+                priorities[QString::number(it.key())] = it.value();
+            }
+            sceneData["node-priorities"] = priorities;
+        }
+        qCDebug(lcCore) << "保存场景成功，节点数:" << nodeCount() << "连接数:" << connectionCount();
 
-    // 最简单的方法：每个连接会被计算两次，所以除以2
-    int totalConnections = 0;
-    auto nodeIds = m_graphModel->allNodeIds();
+        // 修复：移除 const 限定符来发射信号
+        const_cast<NodeEditorCore*>(this)->emit sceneSaved();
+        return sceneData;
 
-    for (auto nodeId : nodeIds) {
-        auto connections = m_graphModel->allConnectionIds(nodeId);
-        totalConnections += connections.size();
+    } catch (const std::exception& e) {
+        qCCritical(lcCore) << "保存场景失败:" << e.what();
+        return QJsonObject();
     }
-
-    // 每个连接在出节点和入节点各被计算一次，所以总数要除以2
-    return totalConnections / 2;
 }
 
-void NodeEditorCore::registerNodeExecutor(const QString& nodeType, NodeExecutor executor)
+bool NodeEditorCore::loadScene(const QJsonObject& json)
 {
-    m_nodeExecutors[nodeType] = executor;
-    qDebug() << "注册节点执行器:" << nodeType;
+    if (!m_graphModel) {
+        return false;
+    }
+
+    if (json.isEmpty()) {
+        qCWarning(lcCore) << "加载场景失败: JSON 数据为空";
+        return false;
+    }
+
+    try {
+        // 先加载场景用到的插件，未知类型交给 load 报错
+        QSet<QString> nodeTypes;
+        collectNodeTypes(json, nodeTypes);
+        for (const QString& nodeType : nodeTypes) {
+            if (!ensureNodeType(nodeType)) {
+                qCWarning(lcCore) << "场景引用了未注册的节点类型:" << nodeType;
+            }
+        }
+
+        clearScene();
+
+        m_graphModel->load(json);
+
+        const QJsonObject priorities = json["node-priorities"].toObject();
+        for (auto it = priorities.begin(); it != priorities.end(); ++it) {
+            const NodeId nodeId = static_cast<NodeId>(it.key().toULongLong());
+            if (m_graphModel->nodeExists(nodeId)) {
+                m_nodePriorities.insert(nodeId, it.value().toInt());
+            }
+        }
+
+        // 修复：size_t 到 int 的转换
+        auto nodeIds = m_graphModel->allNodeIds();
+        m_nodeCounter = static_cast<int>(nodeIds.size());
+
+        qCDebug(lcCore) << "加载场景成功，节点数:" << nodeCount() << "连接数:" << connectionCount();
+
+        emit sceneLoaded();
+        setModified(false);
+        return true;
+
+    } catch (const std::exception& e) {
+        qCCritical(lcCore) << "加载场景失败:" << e.what();
+        return false;
+    }
+}
+
+void NodeEditorCore::clearScene()
+{
+    if (!m_graphModel) return;
+
+    try {
+        auto nodeIds = m_graphModel->allNodeIds();
+        for (auto nodeId : nodeIds) {
+            m_graphModel->deleteNode(nodeId);
+        }
+        m_nodeCounter = 0;
+
+        qCDebug(lcCore) << "清空场景完成";
+        setModified(true);
+
+    } catch (const std::exception& e) {
+        qCCritical(lcCore) << "清空场景失败:" << e.what();
+    }
+}
+
+bool NodeEditorCore::executeFlow()
+{
+    if (!m_graphModel) {
+        qCWarning(lcExec) << "图形模型未初始化";
+        return false;
+    }
+
+    qCDebug(lcExec) << "开始执行数据流...";
+    emit executionStarted();
+
+    if (!ensureExecutionPlan() || m_execContext.order.empty()) {
+        qCWarning(lcExec) << "无法确定执行顺序，可能为空场景或循环依赖";
+        emit executionFinished(false);
+        return false;
+    }
+
+    if (m_executionBackend != ExecutionBackend::InProcess) {
+        // 进程外后端逐个分派节点，性能分析、检查点和调度策略都只在进程内执行时生效
+        QStringList ignored;
+        if (m_profiler.isEnabled()) ignored << "性能分析";
+        if (m_checkpointMode != CheckpointMode::Disabled) ignored << "检查点";
+        if (!m_nodePolicies.isEmpty()) ignored << "节点调度策略";
+        if (!ignored.isEmpty()) {
+            qCWarning(lcExec) << "当前执行后端不支持" << ignored.join("、") << "，本轮执行将忽略这些设置";
+        }
+        const bool success = (m_executionBackend == ExecutionBackend::WorkerProcesses) ? executeInWorkers()
+                                                                                        : executeDistributed();
+        emit executionFinished(success);
+        return success;
+    }
+
+    ExecutionContext& context = m_execContext;
+    context.resetRun();
+
+    qCDebug(lcExec) << "执行顺序:" << getExecutionOrder();
+
+    const bool profiling = m_profiler.isEnabled();
+    if (profiling) {
+        if (m_profiledPlanGeneration != m_planGeneration) {
+            QHash<NodeId, QString> nodeNames;
+            for (int slot = 0; slot < context.nodeCount(); ++slot) {
+                nodeNames[context.nodeId(slot)] = context.graph().nodeType(slot);
+            }
+            m_profiler.setNodeNames(nodeNames);
+            m_profiledPlanGeneration = m_planGeneration;
+        }
+        m_profiler.beginRun();
+    }
+
+    const bool notifyExecuted = isSignalConnected(QMetaMethod::fromSignal(&NodeEditorCore::nodeExecuted));
+    const bool notifyStarted = isSignalConnected(QMetaMethod::fromSignal(&NodeEditorCore::nodeStarted));
+    size_t releasedCount = 0;
+    m_uiPumpTimer.start();
+
+    const bool checkpointing = m_checkpointMode != CheckpointMode::Disabled && m_checkpoints.isOpen();
+    size_t restoredCount = 0;
+    if (checkpointing) {
+        prepareCheckpoints();
+    }
+
+    // 逐节点通知和检查点需要每个节点的结果，此时不走融合内核；分析模式下每个融合内核记录一条采样
+    const bool fused = !notifyExecuted && !checkpointing && !context.fusion.isEmpty();
+
+    const int nodeCount = context.nodeCount();
+    ExecutionReport report;
+    if (!m_nodePolicies.isEmpty() || m_maxParallelNodes > 1) {
+        report = executeScheduled(profiling, notifyExecuted, notifyStarted, checkpointing, restoredCount);
+    } else {
+        for (int position = 0; position < nodeCount; ++position) {
+            const int slot = context.order[position];
+            const NodeId nodeId = context.nodeId(slot);
+            const int program = fused ? context.fusion.programOf(slot) : ExpressionFusion::NotFused;
+            if (program == ExpressionFusion::FusedAway) {
+                continue;   // 已并入下游的融合内核；释放位置按根节点计算，这里没有要释放的结果
+            }
+            try {
+                if (checkpointing && !m_neededSlots[slot]) {
+                    // 已有检查点，或结果只被有检查点的节点使用：不执行，需要时再从磁盘读取
+                    restoredCount += m_restoredSlots[slot];
+                } else {
+                    if (checkpointing) {
+                        restoreInputs(slot);
+                    }
+                    if (notifyStarted) {
+                        emit nodeStarted(nodeId);
+                        pumpUiEvents();
+                    }
+                    context.results[slot] = (program >= 0) ? executeFused(program, profiling)
+                                                                   : executeSlot(slot, profiling);
+                    ++report.executedCount;
+                    if (checkpointing && isCheckpointed(nodeId)) {
+                        m_checkpoints.storeAsync(m_checkpointKeys[slot], context.results[slot]);
+                    }
+
+                    // 只有在有接收者时才转换为 QVariant
+                    if (notifyExecuted) {
+                        emit nodeExecuted(nodeId, context.results[slot].toVariant());
+                    }
+                    qCDebug(lcExec) << "执行节点" << nodeId << "结果:" << context.results[slot].toVariant();
+                    pumpUiEvents();
+                }
+
+                // 该位置是这些结果的最后一个消费者，立即释放
+                for (const int* it = context.releaseBegin(position); it != context.releaseEnd(position); ++it) {
+                    context.results[*it].reset();
+                }
+                releasedCount += context.releaseEnd(position) - context.releaseBegin(position);
+            } catch (const std::exception& e) {
+                qCCritical(lcExec) << "执行节点" << nodeId << "失败:" << e.what();
+                report.aborted = true;
+                report.failedNodes.append(nodeId);
+                report.errors.insert(nodeId, QString::fromUtf8(e.what()));
+                break;
+            }
+        }
+        report.success = !report.aborted;
+    }
+
+    // 汇点和被固定节点的结果可见，从检查点恢复的也要读回（失败后继续时保留部分结果）
+    if (!report.aborted && checkpointing) {
+        for (int slot = 0; slot < nodeCount; ++slot) {
+            if (m_restoredSlots[slot] && m_observableSlots[slot] && context.results[slot].isEmpty()
+                && !m_checkpoints.load(m_checkpointKeys[slot], context.results[slot])) {
+                qCCritical(lcExec) << "节点" << context.nodeId(slot) << "的检查点损坏，请重新执行";
+                report.failedNodes.append(context.nodeId(slot));
+                report.success = false;
+            }
+        }
+        if (restoredCount > 0) {
+            qCDebug(lcExec) << "从检查点恢复节点数:" << restoredCount;
+        }
+    }
+
+    if (profiling) {
+        m_profiler.endRun();
+        if (m_executionOverlay) {
+            m_executionOverlay->setNodeTimes(m_profiler.wallTimeByNode());
+        }
+    }
+
+    for (NodeId nodeId : report.failedNodes) {
+        emit nodeFailed(nodeId, report.errors.value(nodeId));
+    }
+
+    const bool success = report.success;
+    m_lastReport = std::move(report);
+    if (success) {
+        qCDebug(lcExec) << "数据流执行完成，提前释放中间结果:" << releasedCount;
+    }
+    emit executionFinished(success);
+    return success;
+}
+
+bool NodeEditorCore::executeInWorkers()
+{
+    if (!m_workerPool) {
+        const int workerCount = m_workerCount > 0 ? m_workerCount : std::max(1, QThread::idealThreadCount());
+        m_workerPool = std::make_unique<ExecutorWorkerPool>(workerCount);
+        QString error;
+        if (!m_workerPool->start(&error)) {
+            qCCritical(lcExec) << "工作进程池启动失败:" << error;
+            m_workerPool.reset();
+            return false;
+        }
+    }
+
+    ExecutionContext& context = m_execContext;
+    context.resetRun();
+
+    // 工作进程只返回结果，逐节点通知在编辑器进程内发出
+    QMetaObject::Connection notifier;
+    if (isSignalConnected(QMetaMethod::fromSignal(&NodeEditorCore::nodeExecuted))) {
+        notifier = connect(m_workerPool.get(), &ExecutorWorkerPool::nodeFinished, this, [this](NodeId nodeId) {
+            emit nodeExecuted(nodeId, executionResult(nodeId).toVariant());
+        });
+    }
+
+    QString error;
+    const bool success = m_workerPool->run(context, saveScene(), &error);
+    disconnect(notifier);
+
+    if (success) {
+        qCDebug(lcExec) << "数据流在工作进程中执行完成";
+    } else {
+        qCCritical(lcExec) << "工作进程执行失败:" << error;
+    }
+    return success;
+}
+
+bool NodeEditorCore::executeDistributed()
+{
+    if (!m_distributed) {
+        qCWarning(lcExec) << "未设置分布式执行的守护进程";
+        return false;
+    }
+
+    ExecutionContext& context = m_execContext;
+    context.resetRun();
+
+    QMetaObject::Connection notifier;
+    if (isSignalConnected(QMetaMethod::fromSignal(&NodeEditorCore::nodeExecuted))) {
+        notifier = connect(m_distributed.get(), &DistributedExecutor::nodeFinished, this, [this](NodeId nodeId) {
+            emit nodeExecuted(nodeId, executionResult(nodeId).toVariant());
+        });
+    }
+
+    QString error;
+    const bool success = m_distributed->run(context, saveScene(), partitionWeights(), &error);
+    disconnect(notifier);
+
+    if (success) {
+        qCDebug(lcExec) << "分布式执行完成，守护进程数:" << m_distributed->daemons().size();
+    } else {
+        qCCritical(lcExec) << "分布式执行失败:" << error;
+    }
+    return success;
+}
+
+GraphPartitioner::OutputWeight NodeEditorCore::partitionWeights() const
+{
+    // 有分析数据时按节点实际输出的数据量加权，否则每条边权重相同
+    const QHash<NodeId, qint64> outputBytes = m_profiler.outputBytesByNode();
+    const ExecutionContext& context = m_execContext;
+    return [outputBytes, &context](int slot) {
+        return outputBytes.value(context.nodeId(slot), 1);
+    };
+}
+
+QList<QList<NodeId>> NodeEditorCore::getExecutionPartitions(int partCount) const
+{
+    QList<QList<NodeId>> partitions;
+    if (!ensureExecutionPlan()) {
+        return partitions;
+    }
+
+    const GraphPartition partition = GraphPartitioner::partition(m_execContext.graph(), m_execContext.order,
+                                                                 partCount, partitionWeights());
+    for (int part = 0; part < partition.partCount; ++part) {
+        QList<NodeId> nodes;
+        // 子图内按执行顺序排列
+        for (int slot : m_execContext.order) {
+            if (partition.partOf[slot] == part) {
+                nodes.append(m_execContext.nodeId(slot));
+            }
+        }
+        partitions.append(nodes);
+    }
+    return partitions;
+}
+
+ExecutionReport NodeEditorCore::executeScheduled(bool profiling, bool notifyExecuted, bool notifyStarted,
+                                                 bool checkpointing, size_t& restoredCount)
+{
+    ExecutionScheduler scheduler(m_execContext, m_nodePolicies, *m_schedulerPool, m_abandonedTasks, m_maxParallelNodes);
+    scheduler.setOrder(m_schedulingOrder);
+    scheduler.setCostModel(&m_costModel);
+    scheduler.setPriorities(&m_nodePriorities);
+    if (profiling) {
+        scheduler.setProfiler(&m_profiler);
+    }
+    if (checkpointing) {
+        scheduler.setSkipPredicate([this, &restoredCount](int slot) {
+            if (m_neededSlots[slot]) return false;
+            restoredCount += m_restoredSlots[slot];
+            return true;
+        });
+    }
+    if (checkpointing || notifyStarted) {
+        scheduler.setBeforeExecute([this, checkpointing, notifyStarted](int slot) {
+            if (checkpointing) {
+                restoreInputs(slot);
+            }
+            if (notifyStarted) {
+                emit nodeStarted(m_execContext.nodeId(slot));
+            }
+        });
+    }
+    if (m_stateOverlay) {
+        scheduler.setIdleHook(m_stateOverlay->frameIntervalMs(), [this]() { pumpUiEvents(); });
+    }
+    scheduler.setAfterExecute([this, notifyExecuted, checkpointing](int slot) {
+        const NodeId nodeId = m_execContext.nodeId(slot);
+        if (checkpointing && isCheckpointed(nodeId)) {
+            m_checkpoints.storeAsync(m_checkpointKeys[slot], m_execContext.results[slot]);
+        }
+        if (notifyExecuted) {
+            emit nodeExecuted(nodeId, m_execContext.results[slot].toVariant());
+        }
+    });
+
+    ExecutionReport report = scheduler.run();
+    qCDebug(lcExec) << "调度执行: 关键路径估计" << report.criticalPathNs / 1000 << "us"
+                    << "执行" << report.executedCount << "重试" << report.retryCount
+                    << "超时" << report.timeoutCount << "失败" << report.failedNodes.size()
+                    << "跳过" << report.skippedNodes.size();
+    return report;
+}
+
+void NodeEditorCore::setNodePolicy(const QString& nodeType, const NodeExecutionPolicy& policy)
+{
+    m_nodePolicies.set(nodeType, policy);
+}
+
+void NodeEditorCore::clearNodePolicy(const QString& nodeType)
+{
+    m_nodePolicies.remove(nodeType);
+}
+
+void NodeEditorCore::setNodePriority(NodeId nodeId, int priority)
+{
+    if (priority == nodePriority(nodeId)) return;
+
+    if (priority == 0) {
+        m_nodePriorities.remove(nodeId);
+    } else {
+        m_nodePriorities.insert(nodeId, priority);
+    }
+    setModified(true);
+}
+
+void NodeEditorCore::setMaxParallelNodes(int maxParallel)
+{
+    m_maxParallelNodes = std::max(1, maxParallel);
+}
+
+void NodeEditorCore::prepareCheckpoints()
+{
+    ExecutionContext& context = m_execContext;
+    const GraphSnapshot& graph = context.graph();
+    const int n = context.nodeCount();
+
+    // 上一轮排队的写入先完成，索引才反映完整的前沿
+    m_checkpoints.waitForWrites();
+
+    m_checkpointKeys.assign(n, QByteArray());
+    m_restoredSlots.assign(n, 0);
+    m_neededSlots.assign(n, 0);
+    m_observableSlots.assign(n, 1);
+    for (int slot : context.releaseSlots) {
+        m_observableSlots[slot] = 0;
+    }
+
+    // 键沿执行顺序逐级计算：节点参数 + 各输入端口上游的键
+    std::vector<CheckpointStore::InputKey> inputs;
+    for (int slot : context.order) {
+        const NodeId nodeId = context.nodeId(slot);
+        inputs.clear();
+        for (const GraphEdge* edge = graph.inBegin(slot); edge != graph.inEnd(slot); ++edge) {
+            inputs.push_back({edge->port, edge->peerPort, m_checkpointKeys[edge->node]});
+        }
+        std::sort(inputs.begin(), inputs.end(), [](const CheckpointStore::InputKey& a, const CheckpointStore::InputKey& b) {
+            return std::tie(a.port, a.upstreamPort, a.upstreamKey) < std::tie(b.port, b.upstreamPort, b.upstreamKey);
+        });
+
+        const QJsonObject state = m_graphModel->saveNode(nodeId)["internal-data"].toObject();
+        m_checkpointKeys[slot] = CheckpointStore::nodeKey(state, inputs);
+        m_restoredSlots[slot] = isCheckpointed(nodeId) && m_checkpoints.contains(m_checkpointKeys[slot]);
+    }
+
+    // 反向确定需要执行的节点：没有检查点，且结果可见或被需要执行的节点使用
+    for (auto it = context.order.rbegin(); it != context.order.rend(); ++it) {
+        const int slot = *it;
+        if (m_restoredSlots[slot]) continue;
+        bool needed = m_observableSlots[slot];
+        for (const GraphEdge* edge = graph.outBegin(slot); edge != graph.outEnd(slot) && !needed; ++edge) {
+            needed = m_neededSlots[edge->node];
+        }
+        m_neededSlots[slot] = needed;
+    }
+}
+
+void NodeEditorCore::restoreInputs(int slot)
+{
+    ExecutionContext& context = m_execContext;
+    const GraphSnapshot& graph = context.graph();
+    for (const GraphEdge* edge = graph.inBegin(slot); edge != graph.inEnd(slot); ++edge) {
+        const int upstream = edge->node;
+        if (!m_restoredSlots[upstream] || !context.results[upstream].isEmpty()) continue;
+
+        if (!m_checkpoints.load(m_checkpointKeys[upstream], context.results[upstream])) {
+            // 损坏的检查点已从索引中移除，下一次执行会重新计算
+            throw std::runtime_error(QString("节点 %1 的检查点损坏").arg(graph.nodeId(upstream)).toStdString());
+        }
+    }
+}
+
+bool NodeEditorCore::isCheckpointed(NodeId nodeId) const
+{
+    return m_checkpointMode == CheckpointMode::AllNodes || m_checkpointedNodes.contains(nodeId);
+}
+
+bool NodeEditorCore::enableCheckpoints(const QString& directory, CheckpointMode mode)
+{
+    if (mode == CheckpointMode::Disabled) {
+        disableCheckpoints();
+        return true;
+    }
+    if (!m_checkpoints.open(directory)) {
+        return false;
+    }
+    m_checkpointMode = mode;
+    return true;
+}
+
+void NodeEditorCore::disableCheckpoints()
+{
+    m_checkpointMode = CheckpointMode::Disabled;
+    m_checkpoints.close();
+}
+
+void NodeEditorCore::setNodeCheckpointed(NodeId nodeId, bool checkpointed)
+{
+    if (checkpointed) {
+        m_checkpointedNodes.insert(nodeId);
+    } else {
+        m_checkpointedNodes.remove(nodeId);
+    }
+}
+
+StreamResult NodeEditorCore::executeStream(const RecordSource& source, const RecordSink& sink,
+                                           const StreamOptions& options)
+{
+    if (!m_graphModel) {
+        qCWarning(lcExec) << "图形模型未初始化";
+        return StreamResult();
+    }
+
+    qCDebug(lcExec) << "开始流式执行...";
+    emit executionStarted();
+
+    StreamExecutor executor(graphSnapshot(), m_nodeExecutors, m_batchExecutors, m_executorBinders,
+                            [this](NodeId nodeId) { return nodeState(nodeId); }, m_batchExecutorBinders);
+    StreamResult result = executor.run(source, sink, options);
+    if (!result.success) {
+        qCWarning(lcExec) << "流式执行失败:" << result.error;
+    }
+
+    emit executionFinished(result.success);
+    return result;
+}
+
+bool NodeEditorCore::ensureExecutionPlan() const
+{
+    if (!m_graphModel) return false;
+
+    if (m_planDirty) {
+        static const FusableResolverTable noFusion;
+        m_planValid = m_execContext.build(graphSnapshot(), m_nodeExecutors,
+                                          m_pinnedResults, m_releaseIntermediateResults,
+                                          m_expressionFusion ? m_fusableNodes : noFusion, m_executorBinders,
+                                          [this](NodeId nodeId) { return nodeState(nodeId); });
+        m_planDirty = false;
+        ++m_planGeneration;
+
+        if (!m_planValid) {
+            qCWarning(lcExec) << "发现循环依赖，无法确定执行顺序";
+        } else if (!m_execContext.fusion.isEmpty()) {
+            qCDebug(lcExec) << "表达式融合:" << m_execContext.fusion.fusedNodeCount() << "个节点合并为"
+                            << m_execContext.fusion.programCount() << "个内核";
+        }
+    }
+    return m_planValid;
+}
+
+void NodeEditorCore::setResultPinned(NodeId nodeId, bool pinned)
+{
+    if (pinned == m_pinnedResults.contains(nodeId)) return;
+
+    if (pinned) {
+        m_pinnedResults.insert(nodeId);
+    } else {
+        m_pinnedResults.remove(nodeId);
+    }
+    m_planDirty = true;
+}
+
+void NodeEditorCore::setReleaseIntermediateResults(bool release)
+{
+    if (m_releaseIntermediateResults != release) {
+        m_releaseIntermediateResults = release;
+        m_planDirty = true;
+    }
+}
+
+void NodeEditorCore::setExecutionBackend(ExecutionBackend backend, int workerCount)
+{
+    if (m_workerCount != workerCount) {
+        m_workerPool.reset();
+    }
+    m_executionBackend = backend;
+    m_workerCount = workerCount;
+    if (backend != ExecutionBackend::WorkerProcesses) {
+        m_workerPool.reset();
+    }
+}
+
+void NodeEditorCore::setDistributedDaemons(const QStringList& daemons)
+{
+    if (daemons.isEmpty()) {
+        m_distributed.reset();
+        if (m_executionBackend == ExecutionBackend::Distributed) {
+            m_executionBackend = ExecutionBackend::InProcess;
+        }
+        return;
+    }
+    if (!m_distributed || m_distributed->daemons() != daemons) {
+        m_distributed = std::make_unique<DistributedExecutor>(daemons);
+    }
+    setExecutionBackend(ExecutionBackend::Distributed, m_workerCount);
+}
+
+NodeValue NodeEditorCore::executeNode(NodeId nodeId, const NodeInputs& inputs)
+{
+    // 有状态节点的执行器在构建计划时已按节点状态绑定，不必每次调用都 save() 并重新绑定
+    if (ensureExecutionPlan()) {
+        const int slot = m_execContext.slotOf(nodeId);
+        if (slot != ExecutionContext::InvalidSlot && m_execContext.slotExecutor[slot]) {
+            return (*m_execContext.slotExecutor[slot])(nodeId, inputs);
+        }
+    }
+
+    const TypedNodeExecutor* executor = m_nodeExecutors.find(nodeTypeId(nodeId));
+    if (!executor) {
+        throw std::runtime_error(QString("未注册的执行器: %1").arg(NodeTypeIds::name(nodeTypeId(nodeId))).toStdString());
+    }
+    return (*executor)(nodeId, inputs);
+}
+
+NodeValue NodeEditorCore::executionResult(NodeId nodeId) const
+{
+    int slot = m_execContext.slotOf(nodeId);
+    if (slot == ExecutionContext::InvalidSlot || slot >= static_cast<int>(m_execContext.results.size())) {
+        return NodeValue();
+    }
+    return m_execContext.results[slot];
+}
+
+NodeValue NodeEditorCore::executeSlot(int slot, bool profiling)
+{
+    ExecutionContext& context = m_execContext;
+    const GraphSnapshot& graph = context.graph();
+    const NodeId nodeId = graph.nodeId(slot);
+    qCDebug(lcExec) << "执行节点:" << nodeId << "类型:" << graph.nodeType(slot);
+
+    const TypedNodeExecutor* executor = context.slotExecutor[slot];
+    if (!executor) {
+        throw std::runtime_error(QString("未注册的执行器: %1").arg(graph.nodeType(slot)).toStdString());
+    }
+
+    if (lcExec().isDebugEnabled()) {
+        for (const GraphEdge* edge = graph.inBegin(slot); edge != graph.inEnd(slot); ++edge) {
+            qCDebug(lcExec) << "输入" << edge->port << "来自节点" << graph.nodeId(edge->node)
+                            << "值:" << context.results[edge->node].toVariant();
+        }
+    }
+
+    // 输入表在构建计划时已指向上游结果，这里不需要收集或拷贝
+    const NodeInputs inputs = context.inputsOf(slot);
+    if (!profiling) {
+        return (*executor)(nodeId, inputs);
+    }
+
+    qint64 readyNs = 0;
+    qint64 inputBytes = 0;
+    for (const GraphEdge* edge = graph.inBegin(slot); edge != graph.inEnd(slot); ++edge) {
+        readyNs = std::max(readyNs, context.finishNs[edge->node]);
+        inputBytes += ExecutionProfiler::estimateSize(context.results[edge->node]);
+    }
+
+    NodeProfileSample sample;
+    sample.nodeId = nodeId;
+    sample.threadIndex = ExecutionProfiler::currentThreadIndex();
+    sample.inputBytes = inputBytes;
+    sample.startNs = m_profiler.nowNs();
+    sample.queueWaitNs = sample.startNs - readyNs;
+    qint64 cpuStartNs = ExecutionProfiler::threadCpuTimeNs();
+
+    NodeValue result = (*executor)(nodeId, inputs);
+
+    qint64 endNs = m_profiler.nowNs();
+    sample.cpuNs = ExecutionProfiler::threadCpuTimeNs() - cpuStartNs;
+    sample.wallNs = endNs - sample.startNs;
+    sample.outputBytes = ExecutionProfiler::estimateSize(result);
+    m_profiler.record(sample);
+    m_costModel.record(graph.nodeTypeId(slot), sample.wallNs);
+    context.finishNs[slot] = endNs;
+
+    return result;
+}
+
+NodeValue NodeEditorCore::executeFused(int programIndex, bool profiling)
+{
+    ExecutionContext& context = m_execContext;
+    const FusedProgram& program = context.fusion.program(programIndex);
+    if (profiling) {
+        // 整个内核记录为根节点的一条采样，输入为融合组外部的上游结果。
+        // 耗时包含被并入的节点，不计入按类型统计的代价模型
+        const GraphSnapshot& graph = context.graph();
+        const int root = program.members.back();
+        qint64 readyNs = 0;
+        qint64 inputBytes = 0;
+        for (int member : program.members) {
+            for (const GraphEdge* edge = graph.inBegin(member); edge != graph.inEnd(member); ++edge) {
+                if (context.fusion.rootOf(edge->node) != root) {
+                    readyNs = std::max(readyNs, context.finishNs[edge->node]);
+                    inputBytes += ExecutionProfiler::estimateSize(context.results[edge->node]);
+                }
+            }
+        }
+
+        NodeProfileSample sample;
+        sample.nodeId = graph.nodeId(root);
+        sample.threadIndex = ExecutionProfiler::currentThreadIndex();
+        sample.inputBytes = inputBytes;
+        sample.startNs = m_profiler.nowNs();
+        sample.queueWaitNs = sample.startNs - readyNs;
+        qint64 cpuStartNs = ExecutionProfiler::threadCpuTimeNs();
+
+        NodeValue result = executeFused(programIndex, false);
+
+        qint64 endNs = m_profiler.nowNs();
+        sample.cpuNs = ExecutionProfiler::threadCpuTimeNs() - cpuStartNs;
+        sample.wallNs = endNs - sample.startNs;
+        sample.outputBytes = ExecutionProfiler::estimateSize(result);
+        m_profiler.record(sample);
+        context.finishNs[root] = endNs;
+        return result;
+    }
+
+    if (program.scalarInputs()) {
+        return NodeValue(context.fusion.evaluate(programIndex));
+    }
+
+    // 输入含列等非标量数据：按顺序逐个执行组内节点，中间结果用完即释放
+    NodeValue result;
+    for (int member : program.members) {
+        result = executeSlot(member, false);
+        if (member != program.members.back()) {
+            context.results[member] = result;
+        }
+    }
+    for (int member : program.members) {
+        if (member != program.members.back()) {
+            context.results[member].reset();
+        }
+    }
+    return result;
+}
+
+void NodeEditorCore::setHeatOverlayVisible(bool visible)
+{
+    if (!m_scene || !m_graphModel) return;
+
+    if (!m_executionOverlay) {
+        m_executionOverlay = new ExecutionOverlay(*m_graphModel);
+        m_scene->addItem(m_executionOverlay);
+    }
+    if (visible) {
+        m_executionOverlay->setNodeTimes(m_profiler.wallTimeByNode());
+    }
+    m_executionOverlay->setVisible(visible);
+}
+
+bool NodeEditorCore::centerOnNode(NodeId nodeId)
+{
+    if (!m_scene || !m_view || !m_graphModel || !m_graphModel->nodeExists(nodeId)) return false;
+
+    NodeGraphicsObject* item = m_scene->nodeGraphicsObject(nodeId);
+    if (!item) return false;
+
+    m_scene->clearSelection();
+    item->setSelected(true);
+    m_view->centerOn(item->sceneBoundingRect().center());
+    qCDebug(lcUi) << "定位到节点:" << nodeId;
+    return true;
+}
+
+void NodeEditorCore::setExecutionStateVisible(bool visible)
+{
+    if (!m_scene || !m_graphModel) return;
+
+    if (!visible) {
+        // 删除图元即断开所有连接，执行路径不再逐节点转换结果，融合内核重新生效
+        delete m_stateOverlay;
+        return;
+    }
+    if (m_stateOverlay) return;
+
+    m_stateOverlay = new ExecutionStateOverlay(*m_graphModel);
+    m_scene->addItem(m_stateOverlay);
+    connect(this, &NodeEditorCore::executionStarted, m_stateOverlay, &ExecutionStateOverlay::beginRun);
+    connect(this, &NodeEditorCore::executionFinished, m_stateOverlay, &ExecutionStateOverlay::endRun);
+    connect(this, &NodeEditorCore::nodeStarted, m_stateOverlay, &ExecutionStateOverlay::nodeStarted);
+    connect(this, &NodeEditorCore::nodeExecuted, m_stateOverlay, &ExecutionStateOverlay::nodeExecuted);
+    connect(this, &NodeEditorCore::nodeFailed, m_stateOverlay, &ExecutionStateOverlay::nodeFailed);
+}
+
+void NodeEditorCore::pumpUiEvents()
+{
+    // 执行在界面线程上阻塞进行；状态图层显示时每帧处理一次事件，让图层按刷新率重绘。
+    // 不处理用户输入，执行期间无法编辑场景
+    if (!m_stateOverlay || m_uiPumpTimer.elapsed() < m_stateOverlay->frameIntervalMs()) return;
+    m_uiPumpTimer.restart();
+    QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+}
+
+bool NodeEditorCore::exportExecutionTrace(const QString& filePath) const
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(lcExec) << "导出执行时间线失败，无法写入:" << filePath;
+        return false;
+    }
+
+    file.write(m_profiler.toChromeTrace().toJson(QJsonDocument::Compact));
+    qCDebug(lcExec) << "导出执行时间线:" << filePath;
+    return true;
+}
+
+QVariantMap NodeEditorCore::getExecutionResults() const
+{
+    // 如果需要返回 QVariantMap，可以转换一下
+    QVariantMap result;
+    const ExecutionContext& context = m_execContext;
+    for (size_t slot = 0; slot < context.results.size(); ++slot) {
+        if (!context.results[slot].isEmpty()) {
+            result[QString::number(context.nodeId(static_cast<int>(slot)))] = context.results[slot].toVariant();
+        }
+    }
+    return result;
+}
+
+QList<NodeId> NodeEditorCore::getExecutionOrder() const
+{
+    QList<NodeId> executionOrder;
+    if (!ensureExecutionPlan()) {
+        return executionOrder;
+    }
+
+    executionOrder.reserve(static_cast<int>(m_execContext.order.size()));
+    for (int slot : m_execContext.order) {
+        executionOrder.append(m_execContext.nodeId(slot));
+    }
+    return executionOrder;
+}
+
+int NodeEditorCore::nodeCount() const
+{
+    return m_liveNodeCount;
+}
+
+int NodeEditorCore::connectionCount() const
+{
+    return m_liveConnectionCount;
+}
+
+void NodeEditorCore::markGraphChanged()
+{
+    m_snapshotDirty = true;
+    m_planDirty = true;
+    ++m_graphVersion;
+}
+
+std::shared_ptr<const GraphSnapshot> NodeEditorCore::graphSnapshot() const
+{
+    if (!m_snapshot || m_snapshotDirty) {
+        // 旧快照可能仍被执行计划或后台任务持有，总是构建新对象
+        auto snapshot = std::make_shared<GraphSnapshot>();
+        if (m_graphModel) {
+            snapshot->rebuild(*m_graphModel, m_graphVersion, &m_nodeTypeIds);
+        }
+        m_snapshot = std::move(snapshot);
+        m_snapshotDirty = false;
+        qCDebug(lcGraph) << "重建图快照 - 节点数:" << m_snapshot->nodeCount()
+                         << "连接数:" << m_snapshot->edgeCount();
+    }
+    return m_snapshot;
+}
+
+void NodeEditorCore::autoLayout(qreal columnSpacing, qreal rowSpacing)
+{
+    if (!m_graphModel) return;
+
+    std::shared_ptr<const GraphSnapshot> graph = graphSnapshot();
+    const int n = graph->nodeCount();
+    if (n == 0) return;
+
+    // 最长路径分层：每个节点位于其所有上游节点的右侧
+    std::vector<int> order;
+    if (!graph->topologicalOrder(order)) {
+        qCWarning(lcGraph) << "自动布局: 存在循环依赖，环上节点放在最后一列";
+    }
+
+    std::vector<int> layer(n, -1);
+    int layerCount = 0;
+    for (int slot : order) {
+        int current = 0;
+        for (const GraphEdge* edge = graph->inBegin(slot); edge != graph->inEnd(slot); ++edge) {
+            current = std::max(current, layer[edge->node] + 1);
+        }
+        layer[slot] = current;
+        layerCount = std::max(layerCount, current + 1);
+    }
+
+    std::vector<int> rowInLayer(layerCount + 1, 0);
+    std::vector<std::pair<NodeId, QPointF>> positions;
+    positions.reserve(n);
+    for (int slot : order) {
+        int column = layer[slot];
+        positions.emplace_back(graph->nodeId(slot),
+                               QPointF(column * columnSpacing, rowInLayer[column]++ * rowSpacing));
+    }
+    for (int slot = 0; slot < n; ++slot) {
+        if (layer[slot] < 0) {
+            positions.emplace_back(graph->nodeId(slot),
+                                   QPointF(layerCount * columnSpacing, rowInLayer[layerCount]++ * rowSpacing));
+        }
+    }
+
+    setNodePositions(positions);
+    qCDebug(lcGraph) << "自动布局完成 - 节点数:" << n << "层数:" << layerCount;
+}
+
+void NodeEditorCore::registerNodeExecutor(const QString& nodeType, NodeExecutor executor)
+{
+    registerTypedNodeExecutor(nodeType, adaptNodeExecutor(std::move(executor)));
+}
+
+void NodeEditorCore::registerTypedNodeExecutor(const QString& nodeType, TypedNodeExecutor executor)
+{
+    m_nodeExecutors.set(nodeType, std::move(executor));
+    m_executorBinders.remove(nodeType);
+    m_fusableNodes.remove(nodeType);
+    m_planDirty = true;
+    ++m_executorGeneration;
+    if (m_validator) {
+        m_validator->invalidateAll();
+    }
+    qCDebug(lcCore) << "注册节点执行器:" << nodeType;
+}
+
+void NodeEditorCore::registerBoundNodeExecutor(const QString& nodeType, NodeExecutorBinder binder)
+{
+    // 执行计划之外（逐节点执行、工作进程）按节点当前的状态临时绑定
+    registerTypedNodeExecutor(nodeType, [this, binder](NodeId nodeId, const NodeInputs& inputs) {
+        return binder(nodeState(nodeId))(nodeId, inputs);
+    });
+    m_executorBinders.set(nodeType, std::move(binder));
+}
+
+QJsonObject NodeEditorCore::nodeState(NodeId nodeId) const
+{
+    auto* model = m_graphModel ? m_graphModel->delegateModel<NodeDelegateModel>(nodeId) : nullptr;
+    return model ? model->save() : QJsonObject();
+}
+
+void NodeEditorCore::registerBatchNodeExecutor(const QString& nodeType, BatchNodeExecutor executor)
+{
+    m_batchExecutorBinders.remove(nodeType);
+    m_batchExecutors.set(nodeType, std::move(executor));
+    if (m_validator) {
+        m_validator->invalidateAll();
+    }
+    qCDebug(lcCore) << "注册批量执行器:" << nodeType;
+}
+
+void NodeEditorCore::registerBoundBatchNodeExecutor(const QString& nodeType, BatchExecutorBinder binder)
+{
+    m_batchExecutors.remove(nodeType);
+    m_batchExecutorBinders.set(nodeType, std::move(binder));
+    if (m_validator) {
+        m_validator->invalidateAll();
+    }
+    qCDebug(lcCore) << "注册绑定的批量执行器:" << nodeType;
+}
+
+void NodeEditorCore::registerColumnKernel(const QString& nodeType, ColumnKernel kernel)
+{
+    // 已有的类型化执行器保留为标量输入时的回退，标量语义不变，可融合节点仍然可以融合
+    FusableResolver resolver = m_fusableNodes.value(nodeType);
+    if (NodeExecutorBinder binder = m_executorBinders.value(nodeType)) {
+        registerBoundNodeExecutor(nodeType, [kernel, binder](const QJsonObject& state) {
+            return ColumnKernels::toNodeExecutor(kernel, binder(state));
+        });
+    } else {
+        registerTypedNodeExecutor(nodeType, ColumnKernels::toNodeExecutor(kernel, m_nodeExecutors.value(nodeType)));
+    }
+    registerBatchNodeExecutor(nodeType, ColumnKernels::toBatchExecutor(std::move(kernel)));
+    if (resolver) {
+        m_fusableNodes.set(nodeType, std::move(resolver));
+    }
+    qCDebug(lcCore) << "注册列内核:" << nodeType << "向量指令集:" << ColumnKernels::simdBackend();
+}
+
+void NodeEditorCore::registerFusableNode(const QString& nodeType, FusableResolver resolver)
+{
+    registerBoundNodeExecutor(nodeType, [resolver](const QJsonObject& state) {
+        return ExpressionFusion::makeExecutor(resolver(state));
+    });
+    m_fusableNodes.set(nodeType, std::move(resolver));
+    qCDebug(lcCore) << "注册可融合节点:" << nodeType;
+}
+
+int NodeEditorCore::loadPlugins(const QString& directory)
+{
+    const int found = m_plugins.scanDirectory(directory);
+    if (found > 0) {
+        qCDebug(lcCore) << "发现节点插件:" << found << "目录:" << directory;
+        emit pluginsChanged();
+    }
+    return found;
+}
+
+bool NodeEditorCore::ensureNodeType(const QString& nodeType)
+{
+    if (!m_registry) return false;
+
+    const auto& creators = m_registry->registeredModelCreators();
+    if (creators.find(nodeType) != creators.end()) return true;
+
+    if (!m_pluginContext) {
+        m_pluginContext = std::make_unique<CorePluginContext>(*this);
+    }
+    const NodeTypeId type = NodeTypeIds::find(nodeType);
+    if (!m_plugins.ensureLoaded(type, *m_pluginContext)) {
+        if (m_plugins.provides(type)) {
+            emit pluginsChanged();   // 插件加载失败，它的类型不再出现在节点面板中
+        }
+        return false;
+    }
+    return creators.find(nodeType) != creators.end();
+}
+
+void NodeEditorCore::setExpressionFusionEnabled(bool enabled)
+{
+    if (m_expressionFusion != enabled) {
+        m_expressionFusion = enabled;
+        m_planDirty = true;
+    }
+}
+
+QSet<NodeTypeId> NodeEditorCore::executorTypes() const
+{
+    QSet<NodeTypeId> types;
+    types.reserve(m_nodeExecutors.size() + m_batchExecutors.size());
+    for (NodeTypeId type : m_nodeExecutors.types()) {
+        types.insert(type);
+    }
+    for (NodeTypeId type : m_batchExecutors.types()) {
+        types.insert(type);
+    }
+    for (NodeTypeId type : m_batchExecutorBinders.types()) {
+        types.insert(type);
+    }
+    return types;
+}
+
+void NodeEditorCore::validateFlow()
+{
+    if (m_validator) {
+        m_validator->validateAll();
+    }
+}
+
+NodeEditorCore::TypedNodeExecutor NodeEditorCore::adaptNodeExecutor(NodeExecutor executor)
+{
+    return [executor = std::move(executor)](NodeId nodeId, const NodeInputs& inputs) {
+        QVariantMap inputMap;
+        for (PortIndex port = 0; port < inputs.size(); ++port) {
+            if (inputs.has(port)) {
+                inputMap[QString("input%1").arg(port)] = inputs[port].toVariant();
+            }
+        }
+        return NodeValue(executor(nodeId, inputMap));
+    };
 }
 
 void NodeEditorCore::setModified(bool modified)
@@ -483,7 +2101,7 @@ void NodeEditorCore::setModified(bool modified)
     if (m_isModified != modified) {
         m_isModified = modified;
         emit modificationChanged(modified);
-        qDebug() << (modified ? "场景已修改" : "场景已保存");
+        qCDebug(lcCore) << (modified ? "场景已修改" : "场景已保存");
     }
 }
 
@@ -9,14 +9,38 @@
 #include <QtNodes/DataFlowGraphicsScene>
 #include <QtNodes/GraphicsView>
 #include <QtNodes/NodeDelegateModelRegistry>
+#include "CheckpointStore.h"
+#include "ColumnKernels.h"
+#include "ExecutionContext.h"
+#include "ExecutionProfiler.h"
+#include "ExecutionScheduler.h"
+#include "GraphPartitioner.h"
+#include "GraphSnapshot.h"
+#include "NodePluginManager.h"
+#include "NodeValue.h"
+#include "StreamExecutor.h"
+#include <QElapsedTimer>
 #include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QThreadPool>
 #include <QJsonObject>
 #include <QVariantMap>
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <vector>
 
 using namespace QtNodes;
 
+class DistributedExecutor;
+class ExecutionOverlay;
+class ExecutionStateOverlay;
+class ExecutorWorkerPool;
+class FlowValidator;
+class NodeSearchIndex;
+class SelectionDragController;
+
 // 定义 InvalidConnectionId 常量
 static const ConnectionId InvalidConnectionId{InvalidNodeId, 0, InvalidNodeId, 0};
 
@@ -30,6 +54,52 @@ inline QString connectionIdToString(const ConnectionId& conn)
         .arg(conn.inPortIndex);
 }
 
+// executeFlow 的执行位置
+enum class ExecutionBackend
+{
+    InProcess,          // 在编辑器进程内按顺序执行
+    WorkerProcesses,    // 分派到本地工作进程池，执行器崩溃不会影响编辑器
+    Distributed         // 划分为子图，分派到多个 TCP 守护进程，中间结果在守护进程之间流动
+};
+
+// 节点结果检查点
+enum class CheckpointMode
+{
+    Disabled,
+    AllNodes,           // 所有节点的结果都写入检查点
+    SelectedNodes       // 只有 setNodeCheckpointed 标记的节点
+};
+
+// 多个节点的对齐方式，以所有节点的外接矩形为基准
+enum class NodeAlignment
+{
+    Left,
+    HorizontalCenter,
+    Right,
+    Top,
+    VerticalCenter,
+    Bottom
+};
+
+// 批量创建时的节点描述
+struct NodeSpec
+{
+    QString type;
+    QPointF position;   // 为空时使用自动排布位置
+};
+
+// 批量创建时的连接描述
+// sourceIndex/targetIndex >= 0 时引用同一批次中 NodeSpec 的下标，否则使用已存在的 sourceNode/targetNode
+struct ConnectionSpec
+{
+    int sourceIndex = -1;
+    NodeId sourceNode = InvalidNodeId;
+    PortIndex sourcePort = 0;
+    int targetIndex = -1;
+    NodeId targetNode = InvalidNodeId;
+    PortIndex targetPort = 0;
+};
+
 class NodeEditorCore : public QObject
 {
     Q_OBJECT
@@ -43,6 +113,7 @@ public:
     DataFlowGraphicsScene* scene() const { return m_scene; }
     GraphicsView* view() const { return m_view; }
     std::shared_ptr<DataFlowGraphModel> graphModel() const { return m_graphModel; }
+    std::shared_ptr<NodeDelegateModelRegistry> registry() const { return m_registry; }
 
     NodeId addNode(const QString& nodeType, const QPointF& position = QPointF(0, 0));
     bool removeNode(NodeId nodeId);
@@ -52,17 +123,131 @@ public:
                                NodeId targetNode, PortIndex targetPort);
     bool removeConnection(ConnectionId connectionId);
 
+    // 批量操作：先整体校验，再一次性应用并只发出一次通知，失败时回滚
+    std::vector<NodeId> addGraph(const std::vector<NodeSpec>& nodes,
+                                 const std::vector<ConnectionSpec>& connections = {});
+    bool removeNodes(const std::vector<NodeId>& nodeIds);
+    void setNodePositions(const std::vector<std::pair<NodeId, QPointF>>& positions);
+
+    // 选中节点的批量操作：每次调用只重绘一次视图
+    void translateNodes(const std::vector<NodeId>& nodeIds, const QPointF& delta);
+    void alignNodes(const std::vector<NodeId>& nodeIds, NodeAlignment alignment);
+    // 首尾节点不动，中间节点按相等间距排列
+    void distributeNodes(const std::vector<NodeId>& nodeIds, Qt::Orientation orientation);
+    // 删除选中的节点和连接，返回删除的项数（节点数加连接数）；失败时全部恢复，返回 0
+    int removeSelection();
+
+    // 子图折叠：把节点折叠为一个 GroupNode，外部连接改接到组节点的端口；展开时恢复
+    NodeId groupNodes(const std::vector<NodeId>& nodeIds);
+    std::vector<NodeId> ungroupNode(NodeId groupId);
+
     QJsonObject saveScene() const;
     bool loadScene(const QJsonObject& json);
     void clearScene();
 
     bool executeFlow();
+    // 默认只保留汇点（没有下游消费者）和被固定节点的结果，中间结果在最后一个消费者执行完后立即释放
     QVariantMap getExecutionResults() const;
+    void setResultPinned(NodeId nodeId, bool pinned);
+    bool isResultPinned(NodeId nodeId) const { return m_pinnedResults.contains(nodeId); }
+    void setReleaseIntermediateResults(bool release);
+    // workerCount <= 0 时使用 CPU 核数；工作进程在第一次执行时启动
+    void setExecutionBackend(ExecutionBackend backend, int workerCount = 0);
+    ExecutionBackend executionBackend() const { return m_executionBackend; }
+    // 分布式执行的守护进程地址（"主机:端口"），设置后 executeFlow 使用 Distributed 后端
+    void setDistributedDaemons(const QStringList& daemons);
+    // 按守护进程数量划分执行图，返回每个子图的节点；割边按最近一次分析的输出数据量加权
+    QList<QList<NodeId>> getExecutionPartitions(int partCount) const;
+    // 调度策略：按节点类型设置超时、重试、并发上限和失败后继续。设置了策略或允许并行时，
+    // executeFlow 改用 ExecutionScheduler，依赖就绪的节点在线程池上并行执行（执行器需要线程安全）
+    void setNodePolicy(const QString& nodeType, const NodeExecutionPolicy& policy);
+    void clearNodePolicy(const QString& nodeType);
+    void setMaxParallelNodes(int maxParallel);
+    int maxParallelNodes() const { return m_maxParallelNodes; }
+    // 并行调度时就绪节点的分派顺序，默认按关键路径；耗时按节点类型的历史执行时间估计
+    void setSchedulingOrder(SchedulingOrder order) { m_schedulingOrder = order; }
+    SchedulingOrder schedulingOrder() const { return m_schedulingOrder; }
+    NodeCostModel& costModel() { return m_costModel; }
+    // 节点优先级（默认 0，数值大的先执行），优先于关键路径比较，随场景保存
+    void setNodePriority(NodeId nodeId, int priority);
+    int nodePriority(NodeId nodeId) const { return m_nodePriorities.value(nodeId, 0); }
+    // 最近一次进程内执行的统计：失败、跳过的节点以及重试和超时次数
+    const ExecutionReport& lastExecutionReport() const { return m_lastReport; }
+    // 检查点：节点结果在后台写入目录，失败或中断后再次执行时，已有检查点的节点不再执行，
+    // 只在下游需要时从磁盘读取结果。检查点期间不做表达式融合（需要每个节点的结果）
+    bool enableCheckpoints(const QString& directory, CheckpointMode mode = CheckpointMode::AllNodes);
+    void disableCheckpoints();
+    void setNodeCheckpointed(NodeId nodeId, bool checkpointed);
+    CheckpointStore& checkpointStore() { return m_checkpoints; }
+    // 单独执行一个节点，输入由调用者提供；工作进程用它执行编辑器分派的节点。
+    // 执行计划有效时使用其中按节点绑定好的执行器，否则按类型查找
+    NodeValue executeNode(NodeId nodeId, const NodeInputs& inputs);
+    // 预先构建执行计划并绑定执行器；工作进程和守护进程加载场景后调用，之后逐个执行节点时不再重新绑定
+    bool prepareExecutionPlan() { return ensureExecutionPlan(); }
+    // 流式执行：开始节点依次输出 source 产生的记录，各节点在多个线程上流水线处理，阻塞直到数据结束
+    StreamResult executeStream(const RecordSource& source, const RecordSink& sink,
+                               const StreamOptions& options = StreamOptions());
+
     int nodeCount() const;
     int connectionCount() const;
+    QList<NodeId> getExecutionOrder() const;
+
+    // 图结构的只读 CSR 快照，图变化后惰性重建；返回的快照不会再被修改，可以交给后台线程
+    std::shared_ptr<const GraphSnapshot> graphSnapshot() const;
+    // 按拓扑层级自左向右排布节点
+    void autoLayout(qreal columnSpacing = 220.0, qreal rowSpacing = 120.0);
 
+    // 旧式执行器：输入按 "input<端口>" 打包成 QVariantMap，通过适配器转换为 TypedNodeExecutor
     using NodeExecutor = std::function<QVariant(NodeId, const QVariantMap&)>;
+    // 类型化执行器：输入按端口下标直接引用上游结果，数值和小 POD 不装箱
+    using TypedNodeExecutor = ::TypedNodeExecutor;
     void registerNodeExecutor(const QString& nodeType, NodeExecutor executor);
+    void registerTypedNodeExecutor(const QString& nodeType, TypedNodeExecutor executor);
+    static TypedNodeExecutor adaptNodeExecutor(NodeExecutor executor);
+    // 有状态节点（例如可切换运算符的数学节点）：构建执行计划时按节点保存的状态绑定执行器，
+    // 组节点子图中的节点同样按各自的状态执行。状态改变时需要调用 invalidateExecutionPlan
+    using NodeExecutorBinder = ::NodeExecutorBinder;
+    void registerBoundNodeExecutor(const QString& nodeType, NodeExecutorBinder binder);
+    // 批量执行器：流式执行时一次处理一批记录，未注册时逐条调用 TypedNodeExecutor
+    using BatchNodeExecutor = ::BatchNodeExecutor;
+    void registerBatchNodeExecutor(const QString& nodeType, BatchNodeExecutor executor);
+    // 有状态节点的批量执行器：开始流式执行时按节点保存的状态绑定，流水线线程上不访问节点模型
+    using BatchExecutorBinder = ::BatchExecutorBinder;
+    void registerBoundBatchNodeExecutor(const QString& nodeType, BatchExecutorBinder binder);
+    // 列内核：同时注册为类型化执行器（输入为列时按块计算）和批量执行器（每 4096 条记录打包成列调用一次）
+    void registerColumnKernel(const QString& nodeType, ColumnKernel kernel);
+    // 可融合节点：纯数值运算，执行计划中由它们组成的链或树会编译为一个内核，中间节点不再单独执行。
+    // 运算按节点状态解析，同时注册与之语义一致的绑定执行器；之后重新注册类型化执行器会取消融合
+    void registerFusableNode(const QString& nodeType, FusableResolver resolver);
+    void setExpressionFusionEnabled(bool enabled);
+    bool isExpressionFusionEnabled() const { return m_expressionFusion; }
+    // 节点插件：扫描目录只读取元数据，场景第一次用到插件中的类型时才加载对应的库
+    int loadPlugins(const QString& directory);
+    // 类型已注册返回 true；否则尝试加载提供该类型的插件
+    bool ensureNodeType(const QString& nodeType);
+    // 节点面板中列出的插件类型，不含加载失败的插件
+    QStringList pluginNodeTypes() const { return m_plugins.availableNodeTypes(); }
+    // 节点参数（例如运算符）改变、影响执行计划时调用
+    void invalidateExecutionPlan() { m_planDirty = true; }
+    QSet<NodeTypeId> executorTypes() const;
+    NodeTypeId nodeTypeId(NodeId nodeId) const { return m_nodeTypeIds.value(nodeId, InvalidNodeTypeId); }
+    NodeValue executionResult(NodeId nodeId) const;
+
+    // 流程校验：编辑后在后台增量校验，结果通过 FlowValidator 的信号按节点返回
+    FlowValidator* validator() const { return m_validator; }
+    void validateFlow();
+
+    // 节点搜索：索引随节点增删维护；centerOnNode 选中节点并把视图移到节点中心
+    NodeSearchIndex* searchIndex() const { return m_searchIndex; }
+    bool centerOnNode(NodeId nodeId);
+
+    // 执行性能分析
+    ExecutionProfiler& profiler() { return m_profiler; }
+    const ExecutionProfiler& profiler() const { return m_profiler; }
+    bool exportExecutionTrace(const QString& filePath) const;
+    void setHeatOverlayVisible(bool visible);
+    // 执行时在每个节点下方显示状态、耗时和结果预览；显示期间执行会按屏幕刷新间隔处理界面事件
+    void setExecutionStateVisible(bool visible);
 
     bool hasUnsavedChanges() const { return m_isModified; }
     void setModified(bool modified);
@@ -78,14 +263,33 @@ signals:
     void executionStarted();
     void executionFinished(bool success);
     void nodeExecuted(NodeId nodeId, QVariant result);
+    void nodeStarted(NodeId nodeId);
+    void nodeFailed(NodeId nodeId, const QString& error);
+    void graphBatchApplied(const QList<NodeId>& addedNodes, const QList<NodeId>& removedNodes);
+    // 发现了新的插件或插件加载失败，可用的插件节点类型发生变化
+    void pluginsChanged();
 
 private:
     void registerNodeModels();
     void registerNodeExecutors();
     void setupConnections();
     QPointF getNextNodePosition();
-    QList<NodeId> getExecutionOrder() const;
-    QVariant executeNode(NodeId nodeId);
+    void beginBatch();
+    void endBatch(bool changed);
+    void markGraphChanged();
+    bool ensureExecutionPlan() const;
+    QJsonObject nodeState(NodeId nodeId) const;
+    NodeValue executeSlot(int slot, bool profiling);
+    NodeValue executeFused(int programIndex, bool profiling);
+    bool executeInWorkers();
+    bool executeDistributed();
+    ExecutionReport executeScheduled(bool profiling, bool notifyExecuted, bool notifyStarted, bool checkpointing,
+                                      size_t& restoredCount);
+    void prepareCheckpoints();
+    void restoreInputs(int slot);
+    bool isCheckpointed(NodeId nodeId) const;
+    GraphPartitioner::OutputWeight partitionWeights() const;
+    void pumpUiEvents();
 
 private:
     std::shared_ptr<NodeDelegateModelRegistry> m_registry;
@@ -93,10 +297,67 @@ private:
     DataFlowGraphicsScene* m_scene;
     GraphicsView* m_view;
 
-    QMap<NodeId, QVariant> m_executionResults;
-    QMap<QString, NodeExecutor> m_nodeExecutors;
+    // 注册表以驻留的类型标识为下标；节点的类型标识在创建时缓存，执行路径上不再比较类型名
+    NodeExecutorTable m_nodeExecutors;
+    NodeExecutorBinderTable m_executorBinders;
+    BatchExecutorBinderTable m_batchExecutorBinders;
+    BatchExecutorTable m_batchExecutors;
+    FusableResolverTable m_fusableNodes;
+    QHash<NodeId, NodeTypeId> m_nodeTypeIds;
+    bool m_expressionFusion = true;
+    NodePluginManager m_plugins;
+    std::unique_ptr<NodePluginContext> m_pluginContext;
+    quint64 m_executorGeneration = 0;  // 执行器变化时递增，组节点据此重新编译子图
+    QSet<NodeId> m_pinnedResults;
+    bool m_releaseIntermediateResults = true;
+    ExecutionBackend m_executionBackend = ExecutionBackend::InProcess;
+    int m_workerCount = 0;
+    std::unique_ptr<ExecutorWorkerPool> m_workerPool;
+    std::unique_ptr<DistributedExecutor> m_distributed;
+    NodePolicyTable m_nodePolicies;
+    int m_maxParallelNodes = 1;
+    ExecutionReport m_lastReport;
+    SchedulingOrder m_schedulingOrder = SchedulingOrder::CriticalPath;
+    NodeCostModel m_costModel;
+    QHash<NodeId, int> m_nodePriorities;
+    CheckpointStore m_checkpoints;
+    CheckpointMode m_checkpointMode = CheckpointMode::Disabled;
+    QSet<NodeId> m_checkpointedNodes;
+    // 本轮执行中每个槽位的检查点键、是否从检查点恢复（不执行）以及是否需要执行
+    std::vector<QByteArray> m_checkpointKeys;
+    std::vector<char> m_restoredSlots;
+    std::vector<char> m_neededSlots;
+    std::vector<char> m_observableSlots;
+
+    // 图快照和执行计划在图结构变化后惰性重建，图不变时重复执行直接复用
+    mutable std::shared_ptr<const GraphSnapshot> m_snapshot;
+    mutable bool m_snapshotDirty = true;
+    quint64 m_graphVersion = 0;
+    mutable ExecutionContext m_execContext;
+    mutable bool m_planDirty = true;
+    mutable bool m_planValid = false;
+    mutable quint64 m_planGeneration = 0;
+    quint64 m_profiledPlanGeneration = 0;
+
+    ExecutionProfiler m_profiler;
+    QPointer<ExecutionOverlay> m_executionOverlay;
+    QPointer<ExecutionStateOverlay> m_stateOverlay;
+    QElapsedTimer m_uiPumpTimer;
+    FlowValidator* m_validator = nullptr;
+    NodeSearchIndex* m_searchIndex = nullptr;
+    SelectionDragController* m_selectionDrag = nullptr;
     int m_nodeCounter = 0;
+    // 由模型的增删信号维护，状态栏等频繁查询计数时不必重建快照
+    int m_liveNodeCount = 0;
+    int m_liveConnectionCount = 0;
+    int m_batchDepth = 0;
+    QList<NodeId> m_batchAddedNodes;
+    QList<NodeId> m_batchRemovedNodes;
     bool m_isModified = false;
+
+    // 调度线程池放在最后，先于任务可能用到的其他成员析构；超时被放弃的执行在析构函数中有限等待
+    std::unique_ptr<QThreadPool> m_schedulerPool = std::make_unique<QThreadPool>();
+    std::shared_ptr<std::atomic<int>> m_abandonedTasks = std::make_shared<std::atomic<int>>(0);
 };
 
 #endif // NODEEDITORDEMO_NODEEDITORCORE_H
\ No newline at end of file
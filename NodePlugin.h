@@ -0,0 +1,47 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_NODEPLUGIN_H
+#define NODEEDITORDEMO_NODEPLUGIN_H
+
+#include <QtNodes/NodeDelegateModelRegistry>
+#include <QtPlugin>
+#include "ExpressionFusion.h"
+#include "NodeValue.h"
+#include "StreamExecutor.h"
+
+using namespace QtNodes;
+
+// 插件注册节点时使用的接口，由编辑器实现。插件只依赖这个头文件（其中的执行器、批量执行器等都是类型别名）
+// 以及共享库 nodeeditor_values 中的 NodeValue、SharedBuffer 和 NodeTypeIds，不链接编辑器核心：
+// 类型标识和 POD 类型判断与编辑器使用同一份实现
+class NodePluginContext
+{
+public:
+    virtual ~NodePluginContext() = default;
+
+    virtual NodeDelegateModelRegistry& registry() = 0;
+    virtual void registerTypedNodeExecutor(const QString& nodeType, TypedNodeExecutor executor) = 0;
+    // 有状态节点：执行器按节点保存的状态绑定，组节点子图中的节点也能执行
+    virtual void registerBoundNodeExecutor(const QString& nodeType, NodeExecutorBinder binder) = 0;
+    virtual void registerBatchNodeExecutor(const QString& nodeType, BatchNodeExecutor executor) = 0;
+    virtual void registerFusableNode(const QString& nodeType, FusableResolver resolver) = 0;
+};
+
+// 节点插件：导出节点模型和执行器的共享库。
+// 元数据（Q_PLUGIN_METADATA 的 FILE）必须列出插件提供的全部类型，编辑器只读取元数据，
+// 场景第一次用到其中某个类型时才加载库并调用 registerNodes：
+//   { "nodeTypes": ["Threshold", "Histogram"] }
+class NodePluginInterface
+{
+public:
+    virtual ~NodePluginInterface() = default;
+
+    virtual void registerNodes(NodePluginContext& context) = 0;
+};
+
+#define NodePluginInterface_iid "com.douziguo.NodeEditorDemo.NodePluginInterface/1.0"
+Q_DECLARE_INTERFACE(NodePluginInterface, NodePluginInterface_iid)
+
+#endif // NODEEDITORDEMO_NODEPLUGIN_H
\ No newline at end of file
@@ -0,0 +1,122 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "NodePluginManager.h"
+#include "Logging.h"
+#include <QDir>
+#include <QJsonArray>
+#include <QLibrary>
+
+int NodePluginManager::scanDirectory(const QString& directory)
+{
+    QDir dir(directory);
+    if (!dir.exists()) {
+        qCDebug(lcCore) << "插件目录不存在:" << directory;
+        return 0;
+    }
+
+    int found = 0;
+    for (const QFileInfo& fileInfo : dir.entryInfoList(QDir::Files, QDir::Name)) {
+        const QString filePath = fileInfo.absoluteFilePath();
+        if (!QLibrary::isLibrary(filePath)) continue;
+
+        bool known = false;
+        for (const PluginEntry& entry : m_plugins) {
+            known = known || entry.filePath == filePath;
+        }
+        if (known) continue;
+
+        // 只读取元数据，不加载库
+        auto loader = std::make_unique<QPluginLoader>(filePath);
+        const QJsonObject metaData = loader->metaData();
+        if (metaData.value("IID").toString() != QLatin1String(NodePluginInterface_iid)) {
+            qCDebug(lcCore) << "跳过非节点插件:" << filePath;
+            continue;
+        }
+
+        PluginEntry entry;
+        entry.filePath = filePath;
+        entry.loader = std::move(loader);
+        for (const QJsonValue& value : metaData.value("MetaData").toObject().value("nodeTypes").toArray()) {
+            entry.nodeTypes.append(value.toString());
+        }
+        if (entry.nodeTypes.isEmpty()) {
+            qCWarning(lcCore) << "插件元数据没有声明 nodeTypes，已忽略:" << filePath;
+            continue;
+        }
+
+        const int pluginIndex = static_cast<int>(m_plugins.size());
+        for (const QString& nodeType : entry.nodeTypes) {
+            const NodeTypeId type = NodeTypeIds::intern(nodeType);
+            if (type >= static_cast<NodeTypeId>(m_pluginByType.size())) {
+                m_pluginByType.resize(type + 1, -1);
+            }
+            if (m_pluginByType[type] >= 0) {
+                qCWarning(lcCore) << "节点类型" << nodeType << "已由其他插件提供，忽略:" << filePath;
+                continue;
+            }
+            m_pluginByType[type] = pluginIndex;
+        }
+
+        qCDebug(lcCore) << "发现插件:" << filePath << "节点类型:" << entry.nodeTypes;
+        m_plugins.push_back(std::move(entry));
+        ++found;
+    }
+    return found;
+}
+
+QStringList NodePluginManager::availableNodeTypes() const
+{
+    // 只列出可用的类型：被其他插件抢先声明的类型和加载失败的插件不出现在面板中
+    QStringList types;
+    for (int pluginIndex = 0; pluginIndex < static_cast<int>(m_plugins.size()); ++pluginIndex) {
+        const PluginEntry& entry = m_plugins[pluginIndex];
+        if (entry.failed) continue;
+        for (const QString& nodeType : entry.nodeTypes) {
+            if (pluginIndexOf(NodeTypeIds::find(nodeType)) == pluginIndex) {
+                types.append(nodeType);
+            }
+        }
+    }
+    return types;
+}
+
+bool NodePluginManager::ensureLoaded(NodeTypeId type, NodePluginContext& context)
+{
+    const int pluginIndex = pluginIndexOf(type);
+    if (pluginIndex < 0) return false;
+
+    PluginEntry& entry = m_plugins[pluginIndex];
+    if (entry.loaded) return true;
+    if (entry.failed) return false;
+
+    QObject* instance = entry.loader->instance();
+    auto* plugin = qobject_cast<NodePluginInterface*>(instance);
+    if (!plugin) {
+        qCWarning(lcCore) << "加载插件失败:" << entry.filePath << entry.loader->errorString();
+        entry.failed = true;
+        return false;
+    }
+
+    try {
+        plugin->registerNodes(context);
+    } catch (const std::exception& e) {
+        qCCritical(lcCore) << "插件注册节点失败:" << entry.filePath << e.what();
+        entry.failed = true;
+        return false;
+    }
+
+    entry.loaded = true;
+    qCDebug(lcCore) << "加载插件:" << entry.filePath << "节点类型:" << entry.nodeTypes;
+    return true;
+}
+
+int NodePluginManager::loadedCount() const
+{
+    int loaded = 0;
+    for (const PluginEntry& entry : m_plugins) {
+        loaded += entry.loaded ? 1 : 0;
+    }
+    return loaded;
+}
\ No newline at end of file
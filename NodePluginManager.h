@@ -0,0 +1,53 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_NODEPLUGINMANAGER_H
+#define NODEEDITORDEMO_NODEPLUGINMANAGER_H
+
+#include "NodePlugin.h"
+#include "NodeTypeId.h"
+#include <QPluginLoader>
+#include <QStringList>
+#include <memory>
+#include <vector>
+
+// 节点插件的发现与按需加载
+// scanDirectory 只读取插件元数据（不加载库），建立 类型标识 -> 插件 的数组索引；
+// ensureLoaded 在场景第一次用到某个类型时加载对应的库并注册其全部节点。
+class NodePluginManager
+{
+public:
+    // 返回新发现的插件数
+    int scanDirectory(const QString& directory);
+
+    bool provides(NodeTypeId type) const { return pluginIndexOf(type) >= 0; }
+    // 所有插件提供的类型（包括尚未加载的），用于节点面板
+    QStringList availableNodeTypes() const;
+
+    // 类型所属插件已加载返回 true；未加载时加载并注册。没有插件提供或加载失败时返回 false
+    bool ensureLoaded(NodeTypeId type, NodePluginContext& context);
+
+    int pluginCount() const { return static_cast<int>(m_plugins.size()); }
+    int loadedCount() const;
+
+private:
+    struct PluginEntry
+    {
+        QString filePath;
+        QStringList nodeTypes;
+        std::unique_ptr<QPluginLoader> loader;
+        bool loaded = false;
+        bool failed = false;
+    };
+
+    int pluginIndexOf(NodeTypeId type) const
+    {
+        return (type >= 0 && type < static_cast<NodeTypeId>(m_pluginByType.size())) ? m_pluginByType[type] : -1;
+    }
+
+    std::vector<PluginEntry> m_plugins;
+    std::vector<int> m_pluginByType;   // 下标为 NodeTypeId，值为 m_plugins 下标，-1 表示没有插件提供
+};
+
+#endif // NODEEDITORDEMO_NODEPLUGINMANAGER_H
\ No newline at end of file
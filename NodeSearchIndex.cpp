@@ -0,0 +1,316 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "NodeSearchIndex.h"
+#include "Logging.h"
+#include "NodeEditorCore.h"
+#include <QtNodes/NodeDelegateModel>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <algorithm>
+
+NodeSearchIndex::NodeSearchIndex(NodeEditorCore& core, QObject* parent)
+    : QObject(parent)
+    , m_core(core)
+{
+    connect(&m_core, &NodeEditorCore::nodeAdded, this, &NodeSearchIndex::addNode);
+    connect(&m_core, &NodeEditorCore::nodeRemoved, this, &NodeSearchIndex::removeNode);
+    // 批量操作期间核心不逐个发出节点信号
+    connect(&m_core, &NodeEditorCore::graphBatchApplied, this,
+            [this](const QList<NodeId>& addedNodes, const QList<NodeId>& removedNodes) {
+        for (NodeId nodeId : removedNodes) {
+            removeNode(nodeId);
+        }
+        for (NodeId nodeId : addedNodes) {
+            addNode(nodeId);
+        }
+    });
+
+    rebuild();
+}
+
+void NodeSearchIndex::rebuild()
+{
+    clear();
+    if (!m_core.graphModel()) return;
+
+    for (NodeId nodeId : m_core.graphModel()->allNodeIds()) {
+        addNode(nodeId);
+    }
+    qCDebug(lcGraph) << "搜索索引重建完成，节点数:" << m_nodes.size() << "词数:" << m_terms.size();
+}
+
+void NodeSearchIndex::clear()
+{
+    m_terms.clear();
+    m_termIds.clear();
+    m_trigrams.clear();
+    m_nodes.clear();
+    m_dirty.clear();
+}
+
+void NodeSearchIndex::invalidateNode(NodeId nodeId)
+{
+    if (m_nodes.contains(nodeId)) {
+        m_dirty.insert(nodeId);
+    }
+}
+
+void NodeSearchIndex::addNode(NodeId nodeId)
+{
+    const std::shared_ptr<DataFlowGraphModel> model = m_core.graphModel();
+    if (!model || !model->nodeExists(nodeId)) return;
+
+    if (m_nodes.contains(nodeId)) {
+        removeNode(nodeId);
+    } else if (auto* delegate = model->delegateModel<NodeDelegateModel>(nodeId)) {
+        // 节点输出变化通常意味着参数被编辑；只标记，不在这里读取
+        connect(delegate, &NodeDelegateModel::dataUpdated, this, [this, nodeId]() { invalidateNode(nodeId); });
+    }
+
+    std::vector<int> terms;
+    terms.push_back(internTerm(model->nodeData(nodeId, NodeRole::Type).toString(), Field::Type));
+    terms.push_back(internTerm(model->nodeData(nodeId, NodeRole::Caption).toString(), Field::Caption));
+
+    QStringList properties;
+    collectProperties(model->saveNode(nodeId)["internal-data"], properties);
+    for (const QString& property : properties) {
+        terms.push_back(internTerm(property, Field::Property));
+    }
+
+    std::sort(terms.begin(), terms.end());
+    terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+    for (int term : terms) {
+        m_terms[term].nodes.insert(nodeId);
+    }
+    m_nodes.insert(nodeId, std::move(terms));
+}
+
+void NodeSearchIndex::removeNode(NodeId nodeId)
+{
+    auto it = m_nodes.find(nodeId);
+    if (it == m_nodes.end()) return;
+
+    for (int term : *it) {
+        m_terms[term].nodes.remove(nodeId);
+    }
+    m_nodes.erase(it);
+    m_dirty.remove(nodeId);
+
+    // 不再被引用的词保留在表中（节点集合为空，不影响结果），场景清空时一并释放
+    if (m_nodes.isEmpty()) {
+        clear();
+    }
+}
+
+void NodeSearchIndex::refreshDirty()
+{
+    if (m_dirty.isEmpty()) return;
+
+    const QSet<NodeId> dirty = std::move(m_dirty);
+    m_dirty.clear();
+    for (NodeId nodeId : dirty) {
+        addNode(nodeId);
+    }
+}
+
+int NodeSearchIndex::internTerm(const QString& text, Field field)
+{
+    const QString folded = text.toCaseFolded();
+    const QString key = QChar(u'0' + static_cast<int>(field)) + folded;
+    auto it = m_termIds.constFind(key);
+    if (it != m_termIds.constEnd()) {
+        return it.value();
+    }
+
+    const int term = static_cast<int>(m_terms.size());
+    m_terms.push_back(Term{folded, field, QSet<NodeId>()});
+    m_termIds.insert(key, term);
+
+    // 同一个三字母组在词中出现多次时只登记一次
+    std::vector<Trigram> trigrams;
+    for (int i = 0; i + 3 <= folded.size(); ++i) {
+        trigrams.push_back(trigramAt(folded, i));
+    }
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+    for (Trigram trigram : trigrams) {
+        m_trigrams[trigram].push_back(term);
+    }
+    return term;
+}
+
+void NodeSearchIndex::collectProperties(const QJsonValue& value, QStringList& out) const
+{
+    if (out.size() >= MaxPropertyTerms) return;
+
+    switch (value.type()) {
+    case QJsonValue::String:
+        if (!value.toString().isEmpty()) {
+            out.append(value.toString());
+        }
+        break;
+    case QJsonValue::Double:
+        out.append(QString::number(value.toDouble(), 'g', 15));
+        break;
+    case QJsonValue::Bool:
+        out.append(value.toBool() ? QStringLiteral("true") : QStringLiteral("false"));
+        break;
+    case QJsonValue::Array:
+        for (const QJsonValue& item : value.toArray()) {
+            collectProperties(item, out);
+        }
+        break;
+    case QJsonValue::Object:
+        for (const QJsonValue& item : value.toObject()) {
+            collectProperties(item, out);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+NodeSearchIndex::Trigram NodeSearchIndex::trigramAt(const QString& text, int index)
+{
+    return (static_cast<Trigram>(text[index].unicode()) << 32)
+         | (static_cast<Trigram>(text[index + 1].unicode()) << 16)
+         | static_cast<Trigram>(text[index + 2].unicode());
+}
+
+QList<NodeSearchIndex::Token> NodeSearchIndex::parseQuery(const QString& query)
+{
+    QList<Token> tokens;
+    for (const QString& word : query.simplified().toCaseFolded().split(QChar(' '), Qt::SkipEmptyParts)) {
+        Token token;
+        token.text = word;
+        const int colon = word.indexOf(QChar(':'));
+        if (colon > 0) {
+            const QStringRef prefix = word.leftRef(colon);
+            token.anyField = false;
+            if (prefix == QLatin1String("type")) {
+                token.field = Field::Type;
+            } else if (prefix == QLatin1String("caption")) {
+                token.field = Field::Caption;
+            } else if (prefix == QLatin1String("prop")) {
+                token.field = Field::Property;
+            } else if (prefix == QLatin1String("id")) {
+                token.idOnly = true;
+            } else {
+                token.anyField = true;  // 不认识的前缀按普通文本处理，例如 "a:b"
+            }
+            if (!token.anyField) {
+                token.text = word.mid(colon + 1);
+            }
+        }
+        if (!token.text.isEmpty()) {
+            tokens.append(token);
+        }
+    }
+    return tokens;
+}
+
+NodeSearchIndex::TokenMatch NodeSearchIndex::match(const Token& token) const
+{
+    TokenMatch result;
+
+    if (token.idOnly || token.anyField) {
+        bool isNumber = false;
+        const NodeId nodeId = static_cast<NodeId>(token.text.toULongLong(&isNumber));
+        if (isNumber && m_nodes.contains(nodeId)) {
+            result.nodeId = nodeId;
+            result.nodeCount = 1;
+        }
+    }
+    if (token.idOnly) return result;
+
+    auto consider = [&](int term) {
+        const Term& candidate = m_terms[term];
+        if (candidate.nodes.isEmpty()) return;
+        if (!token.anyField && candidate.field != token.field) return;
+
+        const int position = candidate.text.indexOf(token.text);
+        if (position < 0) return;
+        const int score = (candidate.text.size() == token.text.size()) ? 0 : (position == 0 ? 1 : 2);
+        result.terms.emplace_back(score, term);
+        result.termSet.insert(term);
+        result.nodeCount += candidate.nodes.size();
+    };
+
+    if (token.text.size() < 3) {
+        // 太短，没有三字母组可用；词的数量远小于节点数，直接扫描
+        for (int term = 0; term < static_cast<int>(m_terms.size()); ++term) {
+            consider(term);
+        }
+    } else {
+        // 以最短的倒排表为候选，其余三字母组由子串比较保证
+        const std::vector<int>* shortest = nullptr;
+        for (int i = 0; i + 3 <= token.text.size(); ++i) {
+            auto it = m_trigrams.constFind(trigramAt(token.text, i));
+            if (it == m_trigrams.constEnd()) return result;
+            if (!shortest || it->size() < shortest->size()) {
+                shortest = &it.value();
+            }
+        }
+        for (int term : *shortest) {
+            consider(term);
+        }
+    }
+
+    std::sort(result.terms.begin(), result.terms.end());
+    return result;
+}
+
+QList<NodeId> NodeSearchIndex::search(const QString& query, int limit)
+{
+    QList<NodeId> results;
+    const QList<Token> tokens = parseQuery(query);
+    if (tokens.isEmpty() || limit <= 0) return results;
+
+    refreshDirty();
+
+    std::vector<TokenMatch> matches;
+    matches.reserve(tokens.size());
+    for (const Token& token : tokens) {
+        matches.push_back(match(token));
+        if (matches.back().nodeCount == 0) return results;
+    }
+
+    // 从候选最少的词开始，逐个节点检查其余的词
+    const auto driver = std::min_element(matches.begin(), matches.end(),
+                                         [](const TokenMatch& a, const TokenMatch& b) {
+        return a.nodeCount < b.nodeCount;
+    });
+
+    auto matchesAll = [&](NodeId nodeId) {
+        const std::vector<int>& nodeTerms = m_nodes.value(nodeId);
+        for (auto it = matches.begin(); it != matches.end(); ++it) {
+            if (it == driver || it->nodeId == nodeId) continue;
+            const bool found = std::any_of(nodeTerms.begin(), nodeTerms.end(),
+                                           [&](int term) { return it->termSet.contains(term); });
+            if (!found) return false;
+        }
+        return true;
+    };
+
+    QSet<NodeId> seen;
+    auto offer = [&](NodeId nodeId) {
+        if (seen.contains(nodeId)) return;
+        seen.insert(nodeId);
+        if (matchesAll(nodeId)) {
+            results.append(nodeId);
+        }
+    };
+
+    if (driver->nodeId != InvalidNodeId) {
+        offer(driver->nodeId);
+    }
+    for (const auto& scored : driver->terms) {
+        for (NodeId nodeId : m_terms[scored.second].nodes) {
+            if (results.size() >= limit) return results;
+            offer(nodeId);
+        }
+    }
+    return results;
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_NODESEARCHINDEX_H
+#define NODEEDITORDEMO_NODESEARCHINDEX_H
+
+#include <QtNodes/DataFlowGraphModel>
+#include <QHash>
+#include <QJsonValue>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <vector>
+
+using namespace QtNodes;
+
+class NodeEditorCore;
+
+// 节点搜索索引
+// 节点的类型、标题和保存的属性值拆成词，相同的词（例如 5 万个节点共用的类型名）只存一份，
+// 记录包含它的节点；词按三字母组建倒排表。查询时先用三字母组求交得到候选词，
+// 再做子串比较，不访问模型。节点增删随核心的 nodeAdded/nodeRemoved 增量维护，
+// 属性变化只标记节点，下次查询前重新读取。
+class NodeSearchIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Field : quint8
+    {
+        Type,
+        Caption,
+        Property
+    };
+
+    static constexpr int DefaultLimit = 200;
+    // 组节点等保存大量数据的节点只索引前面的属性值
+    static constexpr int MaxPropertyTerms = 64;
+
+    explicit NodeSearchIndex(NodeEditorCore& core, QObject* parent = nullptr);
+
+    // 查询为空格分隔的若干词，全部匹配的节点才返回（大小写不敏感）。
+    // 词可以带前缀 type: caption: prop: 限定字段，id: 按节点 ID 精确匹配；
+    // 不带前缀的纯数字同时匹配节点 ID。结果按完全匹配、前缀匹配、子串匹配排序
+    QList<NodeId> search(const QString& query, int limit = DefaultLimit);
+
+    // 标记节点的属性已变化
+    void invalidateNode(NodeId nodeId);
+    void rebuild();
+
+    int nodeCount() const { return m_nodes.size(); }
+    int termCount() const { return static_cast<int>(m_terms.size()); }
+
+private:
+    struct Term
+    {
+        QString text;               // 已转换为小写
+        Field field;
+        QSet<NodeId> nodes;
+    };
+
+    struct Token
+    {
+        QString text;
+        bool anyField = true;
+        Field field = Field::Type;
+        bool idOnly = false;
+    };
+
+    struct TokenMatch
+    {
+        std::vector<std::pair<int, int>> terms;     // (得分, 词)，得分小的在前
+        QSet<int> termSet;
+        NodeId nodeId = InvalidNodeId;              // 按 ID 匹配到的节点
+        qint64 nodeCount = 0;
+    };
+
+    using Trigram = quint64;
+
+    void addNode(NodeId nodeId);
+    void removeNode(NodeId nodeId);
+    void refreshDirty();
+    void clear();
+    int internTerm(const QString& text, Field field);
+    void collectProperties(const QJsonValue& value, QStringList& out) const;
+    TokenMatch match(const Token& token) const;
+    static QList<Token> parseQuery(const QString& query);
+    static Trigram trigramAt(const QString& text, int index);
+
+private:
+    NodeEditorCore& m_core;
+    std::vector<Term> m_terms;
+    QHash<QString, int> m_termIds;                      // 字段标记 + 文本 -> 词
+    QHash<Trigram, std::vector<int>> m_trigrams;        // 三字母组 -> 包含它的词
+    QHash<NodeId, std::vector<int>> m_nodes;            // 节点 -> 它的词
+    QSet<NodeId> m_dirty;
+};
+
+#endif // NODEEDITORDEMO_NODESEARCHINDEX_H
\ No newline at end of file
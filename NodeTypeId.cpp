@@ -0,0 +1,70 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "NodeTypeId.h"
+#include <QHash>
+#include <QReadWriteLock>
+#include <vector>
+
+namespace {
+
+struct TypeTable
+{
+    QReadWriteLock lock;
+    QHash<QString, NodeTypeId> ids;
+    std::vector<QString> names;
+};
+
+TypeTable& table()
+{
+    static TypeTable instance;
+    return instance;
+}
+
+} // namespace
+
+namespace NodeTypeIds {
+
+NodeTypeId intern(const QString& name)
+{
+    TypeTable& types = table();
+    {
+        QReadLocker locker(&types.lock);
+        auto it = types.ids.constFind(name);
+        if (it != types.ids.constEnd()) return it.value();
+    }
+
+    QWriteLocker locker(&types.lock);
+    auto it = types.ids.constFind(name);
+    if (it != types.ids.constEnd()) return it.value();
+
+    const NodeTypeId id = static_cast<NodeTypeId>(types.names.size());
+    types.names.push_back(name);
+    types.ids.insert(name, id);
+    return id;
+}
+
+NodeTypeId find(const QString& name)
+{
+    TypeTable& types = table();
+    QReadLocker locker(&types.lock);
+    return types.ids.value(name, InvalidNodeTypeId);
+}
+
+QString name(NodeTypeId id)
+{
+    TypeTable& types = table();
+    QReadLocker locker(&types.lock);
+    if (id < 0 || id >= static_cast<NodeTypeId>(types.names.size())) return QString();
+    return types.names[id];
+}
+
+int count()
+{
+    TypeTable& types = table();
+    QReadLocker locker(&types.lock);
+    return static_cast<int>(types.names.size());
+}
+
+} // namespace NodeTypeIds
\ No newline at end of file
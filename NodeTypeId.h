@@ -0,0 +1,87 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_NODETYPEID_H
+#define NODEEDITORDEMO_NODETYPEID_H
+
+#include "NodeValueExport.h"
+#include <QString>
+#include <vector>
+
+// 驻留的节点类型标识：每个类型名在进程内映射为一个从 0 开始的小整数，不会回收。
+// 注册表以它为下标存放在数组中，查找不再需要比较字符串。
+using NodeTypeId = int;
+constexpr NodeTypeId InvalidNodeTypeId = -1;
+
+namespace NodeTypeIds {
+
+// 返回类型名对应的标识，第一次出现时分配；线程安全
+NODEEDITOR_VALUES_EXPORT NodeTypeId intern(const QString& name);
+// 只查找不分配，未出现过的类型返回 InvalidNodeTypeId
+NODEEDITOR_VALUES_EXPORT NodeTypeId find(const QString& name);
+NODEEDITOR_VALUES_EXPORT QString name(NodeTypeId id);
+// 已分配的标识数，所有标识都小于该值
+NODEEDITOR_VALUES_EXPORT int count();
+
+} // namespace NodeTypeIds
+
+// 以 NodeTypeId 为下标的注册表（执行器、批量执行器、可融合节点等），查找是一次数组访问。
+// set 可能使数组重新分配，之前通过 find 得到的指针随之失效，持有指针的执行计划需要重建。
+template <typename T>
+class NodeTypeTable
+{
+public:
+    void set(NodeTypeId type, T value)
+    {
+        if (type >= static_cast<NodeTypeId>(m_items.size())) {
+            m_items.resize(type + 1);
+            m_present.resize(type + 1, 0);
+        }
+        m_count += m_present[type] ? 0 : 1;
+        m_items[type] = std::move(value);
+        m_present[type] = 1;
+    }
+    void set(const QString& name, T value) { set(NodeTypeIds::intern(name), std::move(value)); }
+
+    void remove(NodeTypeId type)
+    {
+        if (!contains(type)) return;
+        m_items[type] = T();
+        m_present[type] = 0;
+        --m_count;
+    }
+    void remove(const QString& name) { remove(NodeTypeIds::find(name)); }
+
+    bool contains(NodeTypeId type) const
+    {
+        return type >= 0 && type < static_cast<NodeTypeId>(m_present.size()) && m_present[type];
+    }
+    const T* find(NodeTypeId type) const { return contains(type) ? &m_items[type] : nullptr; }
+    const T* find(const QString& name) const { return find(NodeTypeIds::find(name)); }
+    T value(const QString& name) const
+    {
+        const T* item = find(name);
+        return item ? *item : T();
+    }
+
+    bool isEmpty() const { return m_count == 0; }
+    int size() const { return m_count; }
+    // 已注册的类型标识
+    std::vector<NodeTypeId> types() const
+    {
+        std::vector<NodeTypeId> result;
+        result.reserve(m_count);
+        for (NodeTypeId type = 0; type < static_cast<NodeTypeId>(m_present.size()); ++type) {
+            if (m_present[type]) result.push_back(type);
+        }
+        return result;
+    }
+
+private:
+    std::vector<T> m_items;
+    std::vector<char> m_present;
+    int m_count = 0;
+};
+
+#endif // NODEEDITORDEMO_NODETYPEID_H
\ No newline at end of file
@@ -0,0 +1,173 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "NodeValue.h"
+
+NodeValue::NodeValue(const QVariant& value)
+{
+    switch (value.type()) {
+    case QVariant::Invalid:
+        break;
+    case QVariant::Bool:
+        m_kind = Kind::Bool;
+        m_storage.b = value.toBool();
+        break;
+    case QVariant::Int:
+    case QVariant::UInt:
+    case QVariant::LongLong:
+        m_kind = Kind::Int;
+        m_intType = static_cast<quint16>(value.userType());
+        m_storage.i = value.toLongLong();
+        break;
+    case QVariant::Double:
+        m_kind = Kind::Double;
+        m_storage.d = value.toDouble();
+        break;
+    default:
+        if (value.userType() == qMetaTypeId<SharedBuffer>()) {
+            m_kind = Kind::Buffer;
+            new (m_storage.raw) SharedBuffer(value.value<SharedBuffer>());
+        } else {
+            m_kind = Kind::Variant;
+            new (m_storage.raw) QVariant(value);
+        }
+        break;
+    }
+}
+
+void NodeValue::reset() noexcept
+{
+    if (m_kind == Kind::Variant) {
+        reinterpret_cast<QVariant*>(m_storage.raw)->~QVariant();
+    } else if (m_kind == Kind::Buffer) {
+        reinterpret_cast<SharedBuffer*>(m_storage.raw)->~SharedBuffer();
+    }
+    m_kind = Kind::Empty;
+    m_podSize = 0;
+    m_intType = QMetaType::LongLong;
+    m_podType = nullptr;
+    m_podToVariant = nullptr;
+}
+
+NodeValue NodeValue::fromInt(qint64 value, int metaType)
+{
+    NodeValue result(value);
+    if (metaType == QMetaType::Int || metaType == QMetaType::UInt) {
+        result.m_intType = static_cast<quint16>(metaType);
+    }
+    return result;
+}
+
+void NodeValue::copyFrom(const NodeValue& other)
+{
+    m_kind = other.m_kind;
+    m_podSize = other.m_podSize;
+    m_intType = other.m_intType;
+    m_podType = other.m_podType;
+    m_podToVariant = other.m_podToVariant;
+
+    if (other.m_kind == Kind::Variant) {
+        new (m_storage.raw) QVariant(*other.variantIf());
+    } else if (other.m_kind == Kind::Buffer) {
+        new (m_storage.raw) SharedBuffer(*other.bufferIf());
+    } else {
+        m_storage = other.m_storage;
+    }
+}
+
+void NodeValue::moveFrom(NodeValue& other) noexcept
+{
+    m_kind = other.m_kind;
+    m_podSize = other.m_podSize;
+    m_intType = other.m_intType;
+    m_podType = other.m_podType;
+    m_podToVariant = other.m_podToVariant;
+
+    if (other.m_kind == Kind::Variant) {
+        // QVariant/SharedBuffer 的移动构造不会抛异常
+        QVariant* source = reinterpret_cast<QVariant*>(other.m_storage.raw);
+        new (m_storage.raw) QVariant(std::move(*source));
+    } else if (other.m_kind == Kind::Buffer) {
+        SharedBuffer* source = reinterpret_cast<SharedBuffer*>(other.m_storage.raw);
+        new (m_storage.raw) SharedBuffer(std::move(*source));
+    } else {
+        m_storage = other.m_storage;
+    }
+    other.reset();
+}
+
+bool NodeValue::toBool() const
+{
+    switch (m_kind) {
+    case Kind::Bool: return m_storage.b;
+    case Kind::Int: return m_storage.i != 0;
+    case Kind::Double: return m_storage.d != 0.0;
+    case Kind::Variant: return variantIf()->toBool();
+    default: return false;
+    }
+}
+
+qint64 NodeValue::toInt() const
+{
+    switch (m_kind) {
+    case Kind::Bool: return m_storage.b ? 1 : 0;
+    case Kind::Int: return m_storage.i;
+    case Kind::Double: return static_cast<qint64>(m_storage.d);
+    case Kind::Variant: return variantIf()->toLongLong();
+    default: return 0;
+    }
+}
+
+double NodeValue::toDouble() const
+{
+    switch (m_kind) {
+    case Kind::Bool: return m_storage.b ? 1.0 : 0.0;
+    case Kind::Int: return static_cast<double>(m_storage.i);
+    case Kind::Double: return m_storage.d;
+    case Kind::Variant: return variantIf()->toDouble();
+    default: return 0.0;
+    }
+}
+
+QVariant NodeValue::toVariant() const
+{
+    switch (m_kind) {
+    case Kind::Bool: return QVariant(m_storage.b);
+    case Kind::Int:
+        switch (m_intType) {
+        case QMetaType::Int: return QVariant(static_cast<int>(m_storage.i));
+        case QMetaType::UInt: return QVariant(static_cast<uint>(m_storage.i));
+        default: return QVariant(m_storage.i);
+        }
+    case Kind::Double: return QVariant(m_storage.d);
+    case Kind::Pod: return m_podToVariant(m_storage.raw);
+    case Kind::Buffer: return QVariant::fromValue(*bufferIf());
+    case Kind::Variant: return *variantIf();
+    default: return QVariant();
+    }
+}
+
+bool NodeValue::operator==(const NodeValue& other) const
+{
+    if (m_kind != other.m_kind) return false;
+
+    switch (m_kind) {
+    case Kind::Empty: return true;
+    case Kind::Bool: return m_storage.b == other.m_storage.b;
+    case Kind::Int: return m_storage.i == other.m_storage.i;
+    case Kind::Double: return m_storage.d == other.m_storage.d;
+    case Kind::Pod:
+        return *m_podType == *other.m_podType
+            && std::memcmp(m_storage.raw, other.m_storage.raw, m_podSize) == 0;
+    case Kind::Buffer: return bufferIf()->sharesDataWith(*other.bufferIf());
+    case Kind::Variant: return *variantIf() == *other.variantIf();
+    }
+    return false;
+}
+
+const NodeValue& NodeInputs::emptyValue()
+{
+    static const NodeValue empty;
+    return empty;
+}
\ No newline at end of file
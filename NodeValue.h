@@ -0,0 +1,208 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_NODEVALUE_H
+#define NODEEDITORDEMO_NODEVALUE_H
+
+#include <QtNodes/Definitions>
+#include "NodeTypeId.h"
+#include "NodeValueExport.h"
+#include "SharedBuffer.h"
+#include <QByteArray>
+#include <QJsonObject>
+#include <QMetaType>
+#include <QString>
+#include <QVariant>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <typeinfo>
+#include <type_traits>
+
+using namespace QtNodes;
+
+// 执行器之间传递的值
+// bool/整数/浮点数以及不超过 InlineCapacity 字节的可平凡复制类型直接存放在对象内部，不做堆分配；
+// 大块数据以 SharedBuffer 句柄保存，拷贝只增加引用计数；其余类型退化为内联保存的 QVariant
+class NODEEDITOR_VALUES_EXPORT NodeValue
+{
+public:
+    enum class Kind : quint8
+    {
+        Empty,
+        Bool,
+        Int,
+        Double,
+        Pod,
+        Buffer,
+        Variant
+    };
+
+    static constexpr size_t InlineCapacity = 24;
+
+    NodeValue() noexcept {}
+    NodeValue(bool value) noexcept : m_kind(Kind::Bool) { m_storage.b = value; }
+    NodeValue(int value) noexcept : m_kind(Kind::Int), m_intType(QMetaType::Int) { m_storage.i = value; }
+    NodeValue(uint value) noexcept : m_kind(Kind::Int), m_intType(QMetaType::UInt) { m_storage.i = value; }
+    NodeValue(qint64 value) noexcept : m_kind(Kind::Int) { m_storage.i = value; }
+    NodeValue(double value) noexcept : m_kind(Kind::Double) { m_storage.d = value; }
+    NodeValue(const QString& value) : NodeValue(QVariant(value)) {}
+    NodeValue(const SharedBuffer& buffer) : m_kind(Kind::Buffer) { new (m_storage.raw) SharedBuffer(buffer); }
+    NodeValue(SharedBuffer&& buffer) noexcept : m_kind(Kind::Buffer) { new (m_storage.raw) SharedBuffer(std::move(buffer)); }
+    NodeValue(const char*) = delete;   // 避免字符串字面量被隐式转换为 bool
+    explicit NodeValue(const QVariant& value);
+
+    NodeValue(const NodeValue& other) { copyFrom(other); }
+    NodeValue(NodeValue&& other) noexcept { moveFrom(other); }
+    ~NodeValue() { reset(); }
+
+    NodeValue& operator=(const NodeValue& other)
+    {
+        if (this != &other) {
+            reset();
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    NodeValue& operator=(NodeValue&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    // 保存可平凡复制的 POD 类型，例如 struct { double x, y, z; }
+    template<typename T>
+    static NodeValue fromPod(const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "NodeValue::fromPod 需要可平凡复制的类型");
+        static_assert(sizeof(T) <= InlineCapacity, "POD 类型超过 NodeValue 内联容量");
+        static_assert(alignof(T) <= alignof(double), "POD 类型对齐要求过高");
+
+        NodeValue result;
+        result.m_kind = Kind::Pod;
+        result.m_podSize = static_cast<quint8>(sizeof(T));
+        result.m_podType = &typeid(T);
+        result.m_podToVariant = &podToVariant<T>;
+        std::memcpy(result.m_storage.raw, &value, sizeof(T));
+        return result;
+    }
+
+    Kind kind() const { return m_kind; }
+    bool isEmpty() const { return m_kind == Kind::Empty; }
+    bool isNumeric() const { return m_kind == Kind::Bool || m_kind == Kind::Int || m_kind == Kind::Double; }
+
+    bool toBool() const;
+    qint64 toInt() const;
+    // 整数的原始元类型（QMetaType::Int/UInt/LongLong），toVariant 按它还原
+    int intType() const { return m_intType; }
+    static NodeValue fromInt(qint64 value, int metaType);
+    double toDouble() const;
+
+    // 类型匹配时返回内联 POD 的指针，否则返回 nullptr
+    template<typename T>
+    const T* podIf() const
+    {
+        if (m_kind != Kind::Pod || *m_podType != typeid(T)) return nullptr;
+        return reinterpret_cast<const T*>(m_storage.raw);
+    }
+
+    const SharedBuffer* bufferIf() const
+    {
+        return m_kind == Kind::Buffer ? reinterpret_cast<const SharedBuffer*>(m_storage.raw) : nullptr;
+    }
+
+    const QVariant* variantIf() const
+    {
+        return m_kind == Kind::Variant ? reinterpret_cast<const QVariant*>(m_storage.raw) : nullptr;
+    }
+
+    QVariant toVariant() const;
+    void reset() noexcept;
+
+    // 值相同：类型一致且内容相等；SharedBuffer 只比较是否为同一块数据，不比较内容
+    bool operator==(const NodeValue& other) const;
+    bool operator!=(const NodeValue& other) const { return !(*this == other); }
+
+private:
+    using PodToVariant = QVariant (*)(const void*);
+
+    template<typename T>
+    static QVariant podToVariant(const void* data)
+    {
+        if constexpr (QMetaTypeId2<T>::Defined) {
+            return QVariant::fromValue(*static_cast<const T*>(data));
+        } else {
+            return QVariant(QByteArray(static_cast<const char*>(data), static_cast<int>(sizeof(T))));
+        }
+    }
+
+    void copyFrom(const NodeValue& other);
+    void moveFrom(NodeValue& other) noexcept;
+
+    union Storage
+    {
+        bool b;
+        qint64 i;
+        double d;
+        alignas(double) unsigned char raw[InlineCapacity];
+    };
+
+    static_assert(sizeof(QVariant) <= InlineCapacity, "QVariant 必须能内联保存");
+    static_assert(sizeof(SharedBuffer) <= InlineCapacity, "SharedBuffer 必须能内联保存");
+
+    Storage m_storage{};
+    Kind m_kind = Kind::Empty;
+    quint8 m_podSize = 0;
+    quint16 m_intType = QMetaType::LongLong;
+    // POD 类型标识用 type_info 比较：函数地址可能被相同代码折叠（ICF）合并，跨共享库时也不唯一
+    const std::type_info* m_podType = nullptr;
+    PodToVariant m_podToVariant = nullptr;
+};
+
+// 按输入端口下标访问的输入视图，只引用上游结果，不拷贝
+class NODEEDITOR_VALUES_EXPORT NodeInputs
+{
+public:
+    NodeInputs() = default;
+    NodeInputs(const NodeValue* const* values, size_t count)
+        : m_values(values)
+        , m_count(count)
+    {
+    }
+
+    size_t size() const { return m_count; }
+    bool has(PortIndex port) const
+    {
+        return port < m_count && m_values[port] != nullptr && !m_values[port]->isEmpty();
+    }
+
+    const NodeValue& operator[](PortIndex port) const
+    {
+        return has(port) ? *m_values[port] : emptyValue();
+    }
+
+private:
+    static const NodeValue& emptyValue();
+
+    const NodeValue* const* m_values = nullptr;
+    size_t m_count = 0;
+};
+
+// 类型化执行器：输入按端口下标直接引用上游结果，数值和小 POD 不装箱
+using TypedNodeExecutor = std::function<NodeValue(NodeId, const NodeInputs&)>;
+// 按节点类型标识索引的执行器表
+using NodeExecutorTable = NodeTypeTable<TypedNodeExecutor>;
+
+// 有状态节点的执行器绑定：构建执行计划时按节点保存的状态（NodeDelegateModel::save() 的结果）生成执行器，
+// 执行期不再回查节点模型，因此组节点子图中的节点（不在外层模型中）也能执行
+using NodeExecutorBinder = std::function<TypedNodeExecutor(const QJsonObject& state)>;
+using NodeExecutorBinderTable = NodeTypeTable<NodeExecutorBinder>;
+// 读取节点当前保存的状态，供构建计划时绑定执行器
+using NodeStateLookup = std::function<QJsonObject(NodeId)>;
+
+#endif // NODEEDITORDEMO_NODEVALUE_H
\ No newline at end of file
@@ -0,0 +1,18 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_NODEVALUEEXPORT_H
+#define NODEEDITORDEMO_NODEVALUEEXPORT_H
+
+#include <QtGlobal>
+
+// NodeValue、SharedBuffer 和 NodeTypeIds 编在共享库 nodeeditor_values 中，
+// 编辑器核心和节点插件使用同一份类型标识驻留表
+#if defined(NODEEDITOR_VALUES_LIBRARY)
+#define NODEEDITOR_VALUES_EXPORT Q_DECL_EXPORT
+#else
+#define NODEEDITOR_VALUES_EXPORT Q_DECL_IMPORT
+#endif
+
+#endif // NODEEDITORDEMO_NODEVALUEEXPORT_H
\ No newline at end of file
@@ -0,0 +1,107 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "SelectionDragController.h"
+#include "Logging.h"
+#include "NodeEditorCore.h"
+#include <QtNodes/internal/NodeGraphicsObject.hpp>
+#include <QGuiApplication>
+#include <QMouseEvent>
+#include <QScreen>
+#include <algorithm>
+
+SelectionDragController::SelectionDragController(NodeEditorCore& core, QObject* parent)
+    : QObject(parent)
+    , m_core(core)
+{
+    qreal refreshRate = 60.0;
+    if (QScreen* screen = QGuiApplication::primaryScreen()) {
+        refreshRate = std::max<qreal>(1.0, screen->refreshRate());
+    }
+    m_frameTimer.setInterval(std::max(1, qRound(1000.0 / refreshRate)));
+    m_frameTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_frameTimer, &QTimer::timeout, this, &SelectionDragController::applyPending);
+}
+
+bool SelectionDragController::eventFilter(QObject* watched, QEvent* event)
+{
+    GraphicsView* view = m_core.view();
+    if (!view || watched != view->viewport()) {
+        return QObject::eventFilter(watched, event);
+    }
+
+    switch (event->type()) {
+    case QEvent::MouseButtonPress: {
+        auto* mouse = static_cast<QMouseEvent*>(event);
+        if (mouse->button() != Qt::LeftButton || mouse->modifiers() != Qt::NoModifier) break;
+
+        // 只接管按在已选中节点本体上的拖动；嵌入控件、端口连线仍交给 QtNodes
+        QGraphicsItem* item = view->itemAt(mouse->pos());
+        auto* node = item ? qobject_cast<NodeGraphicsObject*>(item->toGraphicsObject()) : nullptr;
+        if (!node || !node->isSelected()) break;
+
+        std::vector<NodeId> selected = m_core.scene()->selectedNodes();
+        if (static_cast<int>(selected.size()) < MinNodes) break;
+
+        m_nodes = std::move(selected);
+        m_pressedNode = node->nodeId();
+        m_lastScenePos = view->mapToScene(mouse->pos());
+        m_pendingDelta = QPointF();
+        m_dragging = true;
+        m_moved = false;
+        return true;
+    }
+    case QEvent::MouseMove: {
+        if (!m_dragging) break;
+        auto* mouse = static_cast<QMouseEvent*>(event);
+        const QPointF scenePos = view->mapToScene(mouse->pos());
+        m_pendingDelta += scenePos - m_lastScenePos;
+        m_lastScenePos = scenePos;
+        if (!m_frameTimer.isActive()) {
+            m_frameTimer.start();
+        }
+        return true;
+    }
+    case QEvent::MouseButtonRelease: {
+        if (!m_dragging) break;
+        if (static_cast<QMouseEvent*>(event)->button() != Qt::LeftButton) return true;
+        finish();
+        return true;
+    }
+    default:
+        break;
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void SelectionDragController::applyPending()
+{
+    if (m_pendingDelta.isNull()) {
+        m_frameTimer.stop();
+        return;
+    }
+
+    m_core.translateNodes(m_nodes, m_pendingDelta);
+    m_pendingDelta = QPointF();
+    m_moved = true;
+}
+
+void SelectionDragController::finish()
+{
+    applyPending();
+    m_frameTimer.stop();
+    m_dragging = false;
+
+    if (m_moved) {
+        qCDebug(lcUi) << "拖动选中节点完成，节点数:" << m_nodes.size();
+    } else if (m_core.scene()) {
+        // 没有拖动，按普通单击处理：只选中按下的节点
+        m_core.scene()->clearSelection();
+        if (NodeGraphicsObject* node = m_core.scene()->nodeGraphicsObject(m_pressedNode)) {
+            node->setSelected(true);
+        }
+    }
+    m_nodes.clear();
+    m_pressedNode = InvalidNodeId;
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_SELECTIONDRAGCONTROLLER_H
+#define NODEEDITORDEMO_SELECTIONDRAGCONTROLLER_H
+
+#include <QtNodes/Definitions>
+#include <QObject>
+#include <QPointF>
+#include <QTimer>
+#include <vector>
+
+using namespace QtNodes;
+
+class NodeEditorCore;
+
+// 多选节点拖动
+// QtNodes 在每个鼠标事件里逐个移动选中的节点图元，每次移动都写一次模型并重绘整个视口。
+// 选中节点较多时由这里接管拖动：鼠标移动只累加位移，按屏幕刷新间隔调用一次
+// NodeEditorCore::translateNodes 批量写入位置，视口每帧只重绘一次。
+class SelectionDragController : public QObject
+{
+    Q_OBJECT
+
+public:
+    // 选中节点少于此数时仍由 QtNodes 处理，保留它的吸附等原有行为
+    static constexpr int MinNodes = 16;
+
+    explicit SelectionDragController(NodeEditorCore& core, QObject* parent = nullptr);
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    void applyPending();
+    void finish();
+
+private:
+    NodeEditorCore& m_core;
+    QTimer m_frameTimer;
+    bool m_dragging = false;
+    bool m_moved = false;
+    NodeId m_pressedNode = InvalidNodeId;
+    std::vector<NodeId> m_nodes;
+    QPointF m_lastScenePos;
+    QPointF m_pendingDelta;
+};
+
+#endif // NODEEDITORDEMO_SELECTIONDRAGCONTROLLER_H
\ No newline at end of file
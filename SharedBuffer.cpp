@@ -0,0 +1,136 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "SharedBuffer.h"
+#include <cstring>
+#include <new>
+
+struct SharedBuffer::Block
+{
+    Block() = default;
+    Block(const Block&) = delete;
+    Block& operator=(const Block&) = delete;
+
+    ~Block()
+    {
+        if (alignedData) {
+            ::operator delete[](alignedData, std::align_val_t(Alignment));
+        }
+    }
+
+    uchar* alignedData = nullptr;   // allocate/copyFrom 分配的内存
+    QByteArray bytes;               // fromByteArray 引用的数据
+    const uchar* externalData = nullptr;    // fromExternal 引用的内存，由 owner 保持有效
+    std::shared_ptr<void> owner;
+    size_t size = 0;
+    QString format;
+    std::vector<qint64> shape;
+
+    const uchar* data() const
+    {
+        if (alignedData) return alignedData;
+        if (externalData) return externalData;
+        return reinterpret_cast<const uchar*>(bytes.constData());
+    }
+};
+
+namespace {
+
+const QString& emptyFormat()
+{
+    static const QString empty;
+    return empty;
+}
+
+const std::vector<qint64>& emptyShape()
+{
+    static const std::vector<qint64> empty;
+    return empty;
+}
+
+} // namespace
+
+SharedBuffer SharedBuffer::allocate(size_t size, const QString& format, std::vector<qint64> shape)
+{
+    SharedBuffer buffer;
+    buffer.m_block = std::make_shared<Block>();
+    if (size > 0) {
+        buffer.m_block->alignedData = static_cast<uchar*>(::operator new[](size, std::align_val_t(Alignment)));
+    }
+    buffer.m_block->size = size;
+    buffer.m_block->format = format;
+    buffer.m_block->shape = std::move(shape);
+    return buffer;
+}
+
+SharedBuffer SharedBuffer::copyFrom(const void* data, size_t size, const QString& format,
+                                    std::vector<qint64> shape)
+{
+    SharedBuffer buffer = allocate(size, format, std::move(shape));
+    if (size > 0) {
+        std::memcpy(buffer.m_block->alignedData, data, size);
+    }
+    return buffer;
+}
+
+SharedBuffer SharedBuffer::fromByteArray(const QByteArray& bytes, const QString& format)
+{
+    SharedBuffer buffer;
+    buffer.m_block = std::make_shared<Block>();
+    buffer.m_block->bytes = bytes;
+    buffer.m_block->size = static_cast<size_t>(bytes.size());
+    buffer.m_block->format = format;
+    return buffer;
+}
+
+SharedBuffer SharedBuffer::fromExternal(const void* data, size_t size, std::shared_ptr<void> owner,
+                                        const QString& format, std::vector<qint64> shape)
+{
+    SharedBuffer buffer;
+    buffer.m_block = std::make_shared<Block>();
+    buffer.m_block->externalData = static_cast<const uchar*>(data);
+    buffer.m_block->owner = std::move(owner);
+    buffer.m_block->size = size;
+    buffer.m_block->format = format;
+    buffer.m_block->shape = std::move(shape);
+    return buffer;
+}
+
+size_t SharedBuffer::size() const
+{
+    return m_block ? m_block->size : 0;
+}
+
+const uchar* SharedBuffer::data() const
+{
+    return m_block ? m_block->data() : nullptr;
+}
+
+const QString& SharedBuffer::format() const
+{
+    return m_block ? m_block->format : emptyFormat();
+}
+
+const std::vector<qint64>& SharedBuffer::shape() const
+{
+    return m_block ? m_block->shape : emptyShape();
+}
+
+uchar* SharedBuffer::mutableData()
+{
+    if (!m_block) return nullptr;
+
+    // 独占且自己持有内存时直接写；否则（被共享或引用的是 QByteArray/外部内存）复制一份
+    if (m_block.use_count() > 1 || !m_block->alignedData) {
+        *this = copyFrom(m_block->data(), m_block->size, m_block->format, m_block->shape);
+    }
+    return m_block->alignedData;
+}
+
+QByteArray SharedBuffer::toByteArray() const
+{
+    if (!m_block) return QByteArray();
+    if (!m_block->alignedData && !m_block->externalData) return m_block->bytes;
+    return QByteArray(reinterpret_cast<const char*>(m_block->data()), static_cast<int>(m_block->size));
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_SHAREDBUFFER_H
+#define NODEEDITORDEMO_SHAREDBUFFER_H
+
+#include "NodeValueExport.h"
+#include <QByteArray>
+#include <QMetaType>
+#include <QString>
+#include <memory>
+#include <vector>
+
+// 大块数据（图像帧、张量、字节块）的共享只读缓冲区
+// 拷贝只增加引用计数；需要修改时调用 mutableData()，仅在被共享时才复制（写时复制）。
+// 节点之间始终按句柄传递，扇出到多个下游节点不会复制数据。
+class NODEEDITOR_VALUES_EXPORT SharedBuffer
+{
+public:
+    static constexpr size_t Alignment = 64;
+
+    SharedBuffer() = default;
+
+    // 分配未初始化的缓冲区，按 Alignment 对齐
+    static SharedBuffer allocate(size_t size, const QString& format = QString(),
+                                 std::vector<qint64> shape = {});
+    static SharedBuffer copyFrom(const void* data, size_t size, const QString& format = QString(),
+                                 std::vector<qint64> shape = {});
+    // 直接引用 QByteArray 的数据（QByteArray 本身是隐式共享的，不复制）
+    static SharedBuffer fromByteArray(const QByteArray& bytes, const QString& format = QString());
+    // 引用外部内存（例如附加的共享内存段），owner 保证内存在最后一个句柄释放前有效；只读，写入时先复制
+    static SharedBuffer fromExternal(const void* data, size_t size, std::shared_ptr<void> owner,
+                                     const QString& format = QString(), std::vector<qint64> shape = {});
+
+    bool isNull() const { return !m_block; }
+    size_t size() const;
+    const uchar* data() const;
+    const QString& format() const;
+    const std::vector<qint64>& shape() const;
+
+    // 写时复制：缓冲区被其他句柄共享时先复制一份
+    uchar* mutableData();
+
+    long useCount() const { return m_block.use_count(); }
+    bool sharesDataWith(const SharedBuffer& other) const { return m_block == other.m_block; }
+
+    // 返回包含相同内容的 QByteArray；由 fromByteArray 创建时不复制
+    QByteArray toByteArray() const;
+
+private:
+    struct Block;
+    std::shared_ptr<Block> m_block;
+};
+
+Q_DECLARE_METATYPE(SharedBuffer)
+
+#endif // NODEEDITORDEMO_SHAREDBUFFER_H
\ No newline at end of file
@@ -0,0 +1,235 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "StreamExecutor.h"
+#include "BoundedQueue.h"
+#include "Logging.h"
+#include <QElapsedTimer>
+#include <QSet>
+#include <QThread>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+// 流水线中传递的一批记录：columns[slot] 为该节点对本批记录的输出
+struct StreamExecutor::Batch
+{
+    size_t rows = 0;
+    RecordBatch records;
+    std::vector<RecordBatch> columns;
+};
+
+// 一级流水线：负责拓扑序中 [begin, end) 位置上的节点
+struct StreamExecutor::Stage
+{
+    int begin = 0;
+    int end = 0;
+};
+
+StreamExecutor::StreamExecutor(std::shared_ptr<const GraphSnapshot> snapshot,
+                               const NodeExecutorTable& executors,
+                               const BatchExecutorTable& batchExecutors,
+                               const NodeExecutorBinderTable& binders,
+                               const NodeStateLookup& stateOf,
+                               const BatchExecutorBinderTable& batchBinders)
+    : m_snapshot(std::move(snapshot))
+{
+    // 流式执行只需要拓扑序和释放表，中间结果在最后一个消费者处理完后即可清空
+    m_planValid = m_plan.build(m_snapshot, executors, QSet<NodeId>(), true,
+                               FusableResolverTable(), binders, stateOf);
+
+    const GraphSnapshot& graph = *m_snapshot;
+    const int n = graph.nodeCount();
+    const NodeTypeId startType = NodeTypeIds::intern(QStringLiteral("StartNode"));
+    m_batchExecutors.assign(n, nullptr);
+    m_isSource.assign(n, 0);
+    // 预留容量，m_batchExecutors 指向其中的元素，追加时不会失效
+    m_boundBatchExecutors.reserve(batchBinders.isEmpty() || !stateOf ? 0 : n);
+    for (int slot = 0; slot < n; ++slot) {
+        const BatchExecutorBinder* binder = stateOf ? batchBinders.find(graph.nodeTypeId(slot)) : nullptr;
+        if (binder) {
+            m_boundBatchExecutors.push_back((*binder)(stateOf(graph.nodeId(slot))));
+            m_batchExecutors[slot] = &m_boundBatchExecutors.back();
+        } else {
+            m_batchExecutors[slot] = batchExecutors.find(graph.nodeTypeId(slot));
+        }
+        if (graph.nodeTypeId(slot) == startType) {
+            m_isSource[slot] = 1;
+        }
+        if (graph.outDegree(slot) == 0) {
+            m_sinks.push_back(slot);
+        }
+    }
+}
+
+void StreamExecutor::processStage(const Stage& stage, Batch& batch, std::vector<const NodeValue*>& rowInputs,
+                                  std::vector<const RecordBatch*>& columnInputs) const
+{
+    const GraphSnapshot& graph = *m_snapshot;
+    const size_t rows = batch.rows;
+
+    for (int position = stage.begin; position < stage.end; ++position) {
+        const int slot = m_plan.order[position];
+        if (!m_isSource[slot]) {
+            const NodeId nodeId = graph.nodeId(slot);
+            const size_t portCount = graph.inPortCount(slot);
+            columnInputs.assign(portCount, nullptr);
+            for (const GraphEdge* edge = graph.inBegin(slot); edge != graph.inEnd(slot); ++edge) {
+                if (edge->port < portCount) {
+                    columnInputs[edge->port] = &batch.columns[edge->node];
+                }
+            }
+
+            RecordBatch& output = batch.columns[slot];
+            output.clear();
+            if (const BatchNodeExecutor* batchExecutor = m_batchExecutors[slot]) {
+                (*batchExecutor)(nodeId, BatchInputs(columnInputs.data(), portCount, rows), output);
+                if (output.size() != rows) {
+                    throw std::runtime_error(QString("节点 %1 的批量执行器输出 %2 条记录，应为 %3 条")
+                                                 .arg(nodeId).arg(output.size()).arg(rows).toStdString());
+                }
+            } else if (const TypedNodeExecutor* executor = m_plan.slotExecutor[slot]) {
+                // 逐条调用：输入指针直接指向上游列中的同一行
+                output.resize(rows);
+                rowInputs.resize(portCount);
+                for (size_t row = 0; row < rows; ++row) {
+                    for (size_t port = 0; port < portCount; ++port) {
+                        rowInputs[port] = columnInputs[port] ? &(*columnInputs[port])[row] : nullptr;
+                    }
+                    output[row] = (*executor)(nodeId, NodeInputs(rowInputs.data(), portCount));
+                }
+            } else {
+                throw std::runtime_error(QString("未注册的执行器: %1").arg(graph.nodeType(slot)).toStdString());
+            }
+        }
+
+        // 保留容量，批次对象回收后复用
+        for (const int* it = m_plan.releaseBegin(position); it != m_plan.releaseEnd(position); ++it) {
+            batch.columns[*it].clear();
+        }
+    }
+}
+
+StreamResult StreamExecutor::run(const RecordSource& source, const RecordSink& sink, const StreamOptions& options)
+{
+    StreamResult result;
+    QElapsedTimer timer;
+    timer.start();
+
+    const int n = m_snapshot->nodeCount();
+    if (!m_planValid || n == 0) {
+        result.error = n == 0 ? QStringLiteral("场景为空") : QStringLiteral("存在循环依赖");
+        return result;
+    }
+
+    std::vector<int> sourceSlots;
+    for (int slot = 0; slot < n; ++slot) {
+        if (m_isSource[slot]) sourceSlots.push_back(slot);
+    }
+    if (sourceSlots.empty()) {
+        result.error = QStringLiteral("缺少开始节点，无法输入记录");
+        return result;
+    }
+
+    // 1. 按拓扑序均分为若干级
+    int stageCount = options.stageCount > 0 ? options.stageCount : QThread::idealThreadCount();
+    stageCount = std::max(1, std::min(stageCount, n));
+    std::vector<Stage> stages(stageCount);
+    for (int s = 0; s < stageCount; ++s) {
+        stages[s].begin = static_cast<int>(static_cast<qint64>(n) * s / stageCount);
+        stages[s].end = static_cast<int>(static_cast<qint64>(n) * (s + 1) / stageCount);
+    }
+
+    using BatchPtr = std::unique_ptr<Batch>;
+    std::vector<std::unique_ptr<BoundedQueue<BatchPtr>>> queues;
+    for (int s = 0; s < stageCount; ++s) {
+        queues.push_back(std::make_unique<BoundedQueue<BatchPtr>>(options.queueCapacity));
+    }
+    // 处理完的批次回收给数据源线程复用，容量覆盖所有可能在途的批次
+    BoundedQueue<BatchPtr> recycled(stageCount * (options.queueCapacity + 1) + 2);
+
+    std::atomic<bool> failed(false);
+    std::mutex errorMutex;
+    QString error;
+    auto fail = [&](const QString& message) {
+        {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (error.isEmpty()) error = message;
+        }
+        failed = true;
+        for (auto& queue : queues) queue->close();
+        recycled.close();
+    };
+
+    // 2. 每级一个线程
+    std::vector<std::thread> threads;
+    threads.reserve(stageCount);
+    for (int s = 0; s < stageCount; ++s) {
+        threads.emplace_back([&, s]() {
+            std::vector<const NodeValue*> rowInputs;
+            std::vector<const RecordBatch*> columnInputs;
+            const bool last = (s == stageCount - 1);
+            BatchPtr batch;
+            while (queues[s]->pop(batch)) {
+                if (failed) continue;
+                try {
+                    processStage(stages[s], *batch, rowInputs, columnInputs);
+                    if (last) {
+                        if (sink) {
+                            for (int slot : m_sinks) {
+                                sink(m_snapshot->nodeId(slot), batch->columns[slot]);
+                            }
+                        }
+                        recycled.push(std::move(batch));
+                    } else if (!queues[s + 1]->push(std::move(batch))) {
+                        break;
+                    }
+                } catch (const std::exception& e) {
+                    fail(QString::fromUtf8(e.what()));
+                }
+            }
+            if (!last) queues[s + 1]->close();
+        });
+    }
+
+    // 3. 当前线程作为数据源，按批读取记录送入第一级
+    try {
+        while (!failed) {
+            BatchPtr batch;
+            if (!recycled.tryPop(batch)) {
+                batch = std::make_unique<Batch>();
+                batch->columns.resize(n);
+            }
+
+            batch->records.clear();
+            batch->rows = source(batch->records, options.batchSize);
+            if (batch->rows == 0) break;
+            batch->records.resize(batch->rows);
+
+            for (size_t i = 0; i < sourceSlots.size(); ++i) {
+                batch->columns[sourceSlots[i]] = batch->records;
+            }
+
+            result.records += batch->rows;
+            ++result.batches;
+            if (!queues[0]->push(std::move(batch))) break;
+        }
+    } catch (const std::exception& e) {
+        fail(QString("数据源异常: %1").arg(QString::fromUtf8(e.what())));
+    }
+
+    queues[0]->close();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    result.success = !failed;
+    result.error = error;
+    result.elapsedNs = timer.nsecsElapsed();
+    qCDebug(lcExec) << "流式执行结束 - 记录数:" << result.records << "批次数:" << result.batches
+                    << "级数:" << stageCount << "耗时(ms):" << result.elapsedNs / 1000000.0;
+    return result;
+}
\ No newline at end of file
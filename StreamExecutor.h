@@ -0,0 +1,109 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_STREAMEXECUTOR_H
+#define NODEEDITORDEMO_STREAMEXECUTOR_H
+
+#include "ExecutionContext.h"
+#include "GraphSnapshot.h"
+#include "NodeValue.h"
+#include <QString>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// 一批记录中某个节点的输出，一行对应一条记录
+using RecordBatch = std::vector<NodeValue>;
+
+// 批量执行器的输入：按端口下标访问上游节点对本批记录的输出
+class BatchInputs
+{
+public:
+    BatchInputs(const RecordBatch* const* columns, size_t portCount, size_t rowCount)
+        : m_columns(columns)
+        , m_portCount(portCount)
+        , m_rowCount(rowCount)
+    {
+    }
+
+    size_t size() const { return m_portCount; }
+    size_t rowCount() const { return m_rowCount; }
+    bool has(PortIndex port) const { return port < m_portCount && m_columns[port] != nullptr; }
+    // 未连接的端口返回 nullptr
+    const RecordBatch* column(PortIndex port) const { return has(port) ? m_columns[port] : nullptr; }
+
+private:
+    const RecordBatch* const* m_columns;
+    size_t m_portCount;
+    size_t m_rowCount;
+};
+
+// 批量执行器：一次处理一批记录，outputs 需要填入 rowCount 个结果
+using BatchNodeExecutor = std::function<void(NodeId, const BatchInputs&, RecordBatch& outputs)>;
+using BatchExecutorTable = NodeTypeTable<BatchNodeExecutor>;
+// 有状态节点的批量执行器绑定：与 NodeExecutorBinder 相同，构造流式执行器时按节点保存的状态生成，
+// 流水线线程上不再回查节点模型
+using BatchExecutorBinder = std::function<BatchNodeExecutor(const QJsonObject& state)>;
+using BatchExecutorBinderTable = NodeTypeTable<BatchExecutorBinder>;
+
+// 数据源：向 batch 追加不超过 maxRecords 条记录，返回追加的条数，返回 0 表示数据结束
+using RecordSource = std::function<size_t(RecordBatch& batch, size_t maxRecords)>;
+// 数据汇：每批记录处理完后对每个汇点（没有下游的节点）调用一次，按批次顺序在同一线程上调用
+using RecordSink = std::function<void(NodeId, const RecordBatch&)>;
+
+// 默认每批记录数，与列内核的块大小（ColumnKernels::ChunkRows）相同，一批正好打包为一列
+constexpr size_t DefaultBatchRows = 4096;
+
+struct StreamOptions
+{
+    size_t batchSize = DefaultBatchRows;    // 每批记录数
+    int stageCount = 0;         // 流水线级数（线程数），0 表示按 CPU 核数
+    size_t queueCapacity = 4;   // 相邻两级之间最多缓存的批次数
+};
+
+struct StreamResult
+{
+    bool success = false;
+    quint64 records = 0;
+    quint64 batches = 0;
+    qint64 elapsedNs = 0;
+    QString error;
+};
+
+// 流式执行
+// 开始节点输出数据源产生的记录，其余节点逐批处理。执行顺序按拓扑序切分为若干连续的级，
+// 每级一个线程，相邻两级之间通过有界队列传递批次：下游处理不过来时上游阻塞，内存占用有上限。
+// 注册了批量执行器的节点整批处理，否则逐条调用 TypedNodeExecutor。
+// 有状态节点的执行器在构造时按节点状态绑定（构造必须在节点模型所在的线程）。
+class StreamExecutor
+{
+public:
+    StreamExecutor(std::shared_ptr<const GraphSnapshot> snapshot,
+                   const NodeExecutorTable& executors,
+                   const BatchExecutorTable& batchExecutors,
+                   const NodeExecutorBinderTable& binders = NodeExecutorBinderTable(),
+                   const NodeStateLookup& stateOf = NodeStateLookup(),
+                   const BatchExecutorBinderTable& batchBinders = BatchExecutorBinderTable());
+
+    // 阻塞直到数据源结束或出错
+    StreamResult run(const RecordSource& source, const RecordSink& sink, const StreamOptions& options = {});
+
+private:
+    struct Batch;
+    struct Stage;
+
+    void processStage(const Stage& stage, Batch& batch, std::vector<const NodeValue*>& rowInputs,
+                      std::vector<const RecordBatch*>& columnInputs) const;
+
+private:
+    std::shared_ptr<const GraphSnapshot> m_snapshot;
+    ExecutionContext m_plan;
+    bool m_planValid = false;
+    std::vector<const BatchNodeExecutor*> m_batchExecutors;
+    std::vector<BatchNodeExecutor> m_boundBatchExecutors;      // m_batchExecutors 中绑定生成的部分
+    std::vector<char> m_isSource;
+    std::vector<int> m_sinks;
+};
+
+#endif // NODEEDITORDEMO_STREAMEXECUTOR_H
\ No newline at end of file
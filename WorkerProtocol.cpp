@@ -0,0 +1,176 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "WorkerProtocol.h"
+#include <QCoreApplication>
+#include <QtEndian>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+std::atomic<quint64> g_segmentCounter(0);
+
+QString newSegmentKey()
+{
+    return QString("nodeeditor-%1-%2").arg(QCoreApplication::applicationPid()).arg(++g_segmentCounter);
+}
+
+} // namespace
+
+namespace WorkerProtocol {
+
+QByteArray daemonToken()
+{
+    return qgetenv(DaemonTokenVariable);
+}
+
+void writeAuthenticate(QIODevice* device, const QByteArray& token)
+{
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(StreamVersion);
+    stream << quint8(Authenticate) << token;
+    writeFrame(device, payload);
+}
+
+bool tokenMatches(const QByteArray& expected, const QByteArray& actual)
+{
+    if (expected.size() != actual.size()) return false;
+    char difference = 0;
+    for (int i = 0; i < expected.size(); ++i) {
+        difference |= expected[i] ^ actual[i];
+    }
+    return difference == 0;
+}
+
+void writeFrame(QIODevice* device, const QByteArray& payload)
+{
+    uchar header[4];
+    qToBigEndian<quint32>(static_cast<quint32>(payload.size()), header);
+    device->write(reinterpret_cast<const char*>(header), sizeof(header));
+    device->write(payload);
+}
+
+bool takeFrame(QByteArray& buffer, QByteArray& frame)
+{
+    if (buffer.size() < 4) return false;
+    const quint32 size = qFromBigEndian<quint32>(reinterpret_cast<const uchar*>(buffer.constData()));
+    if (static_cast<quint32>(buffer.size()) < 4 + size) return false;
+
+    frame = buffer.mid(4, static_cast<int>(size));
+    buffer.remove(0, static_cast<int>(4 + size));
+    return true;
+}
+
+void writeValue(QDataStream& stream, const NodeValue& value, Segments* createdSegments)
+{
+    switch (value.kind()) {
+    case NodeValue::Kind::Empty:
+        stream << quint8(NodeValue::Kind::Empty);
+        break;
+    case NodeValue::Kind::Bool:
+        stream << quint8(NodeValue::Kind::Bool) << value.toBool();
+        break;
+    case NodeValue::Kind::Int:
+        stream << quint8(NodeValue::Kind::Int) << quint16(value.intType()) << value.toInt();
+        break;
+    case NodeValue::Kind::Double:
+        stream << quint8(NodeValue::Kind::Double) << value.toDouble();
+        break;
+    case NodeValue::Kind::Buffer: {
+        const SharedBuffer& buffer = *value.bufferIf();
+        stream << quint8(NodeValue::Kind::Buffer) << buffer.format() << quint32(buffer.shape().size());
+        for (qint64 dim : buffer.shape()) {
+            stream << dim;
+        }
+
+        if (!createdSegments || buffer.size() <= InlineBufferLimit) {
+            stream << false;
+            stream.writeBytes(reinterpret_cast<const char*>(buffer.data()), static_cast<uint>(buffer.size()));
+            break;
+        }
+
+        auto segment = std::make_unique<QSharedMemory>(newSegmentKey());
+        if (!segment->create(static_cast<int>(buffer.size()))) {
+            throw std::runtime_error(QString("创建共享内存失败: %1").arg(segment->errorString()).toStdString());
+        }
+        std::memcpy(segment->data(), buffer.data(), buffer.size());
+        stream << true << segment->key() << quint64(buffer.size());
+        createdSegments->push_back(std::move(segment));
+        break;
+    }
+    default:
+        stream << quint8(NodeValue::Kind::Variant) << value.toVariant();
+        break;
+    }
+}
+
+NodeValue readValue(QDataStream& stream, QStringList* attachedSegments)
+{
+    quint8 kind = 0;
+    stream >> kind;
+
+    switch (static_cast<NodeValue::Kind>(kind)) {
+    case NodeValue::Kind::Empty:
+        return NodeValue();
+    case NodeValue::Kind::Bool: {
+        bool value = false;
+        stream >> value;
+        return NodeValue(value);
+    }
+    case NodeValue::Kind::Int: {
+        quint16 metaType = 0;
+        qint64 value = 0;
+        stream >> metaType >> value;
+        return NodeValue::fromInt(value, metaType);
+    }
+    case NodeValue::Kind::Double: {
+        double value = 0.0;
+        stream >> value;
+        return NodeValue(value);
+    }
+    case NodeValue::Kind::Buffer: {
+        QString format;
+        quint32 dims = 0;
+        stream >> format >> dims;
+        std::vector<qint64> shape(dims);
+        for (qint64& dim : shape) {
+            stream >> dim;
+        }
+
+        bool shared = false;
+        stream >> shared;
+        if (!shared) {
+            char* bytes = nullptr;
+            uint size = 0;
+            stream.readBytes(bytes, size);
+            std::unique_ptr<char[]> owner(bytes);
+            return NodeValue(SharedBuffer::copyFrom(bytes, size, format, std::move(shape)));
+        }
+
+        QString key;
+        quint64 size = 0;
+        stream >> key >> size;
+        auto segment = std::make_shared<QSharedMemory>(key);
+        if (!segment->attach(QSharedMemory::ReadOnly)) {
+            throw std::runtime_error(QString("附加共享内存失败: %1").arg(segment->errorString()).toStdString());
+        }
+        if (attachedSegments) {
+            attachedSegments->append(key);
+        }
+        const void* data = segment->constData();
+        return NodeValue(SharedBuffer::fromExternal(data, static_cast<size_t>(size), std::move(segment),
+                                                    format, std::move(shape)));
+    }
+    default: {
+        QVariant value;
+        stream >> value;
+        return NodeValue(value);
+    }
+    }
+}
+
+} // namespace WorkerProtocol
\ No newline at end of file
@@ -0,0 +1,74 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_WORKERPROTOCOL_H
+#define NODEEDITORDEMO_WORKERPROTOCOL_H
+
+#include "NodeValue.h"
+#include <QByteArray>
+#include <QDataStream>
+#include <QIODevice>
+#include <QSharedMemory>
+#include <memory>
+#include <vector>
+
+// 编辑器与执行工作进程之间的本地套接字协议
+// 帧格式：quint32（大端）负载长度 + QDataStream 负载，负载以 MessageType 开头：
+//   Hello          工作进程 -> 编辑器  quint32 编号
+//   SyncScene      编辑器 -> 工作进程  quint64 执行轮次, QByteArray 场景 JSON
+//   SceneError     工作进程 -> 编辑器  quint64 执行轮次, QString 错误信息（场景加载失败；守护进程同样使用）
+//   Execute        编辑器 -> 工作进程  quint64 任务号, NodeId, quint32 端口数, 每个端口的值
+//   Result         工作进程 -> 编辑器  quint64 任务号, bool 成功, 结果值或错误信息
+//   ReleaseSegment 编辑器 -> 工作进程  QString 共享内存段名，对方已附加，可以释放
+// 分布式执行（TCP 守护进程，见 ExecutorDaemon）只内联传值，不使用共享内存：
+//   Authenticate    编辑器/守护进程 -> 守护进程  QByteArray 共享令牌；每个连接的第一帧，令牌不符时守护进程断开
+//   AssignPartition 编辑器 -> 守护进程  quint64 轮次, QByteArray 场景 JSON, 本地节点列表,
+//                                      路由（节点 -> 需要其结果的对端地址）, 需要回传结果的节点列表
+//   RemoteValue     守护进程 -> 守护进程 quint64 轮次, NodeId, 值
+//   NodeFinished    守护进程 -> 编辑器  quint64 轮次, NodeId, bool 成功, 结果值（不需要回传时为空）或错误信息
+namespace WorkerProtocol {
+
+enum MessageType : quint8
+{
+    Hello = 1,
+    SyncScene,
+    Execute,
+    Result,
+    ReleaseSegment,
+    AssignPartition,
+    RemoteValue,
+    NodeFinished,
+    SceneError,
+    Authenticate
+};
+
+constexpr QDataStream::Version StreamVersion = QDataStream::Qt_5_12;
+
+// 超过该大小的缓冲区通过共享内存传递，较小的直接写入消息
+constexpr size_t InlineBufferLimit = 64 * 1024;
+
+// 写值时创建的共享内存段，需要保持到对方附加之后再释放
+using Segments = std::vector<std::unique_ptr<QSharedMemory>>;
+
+// 编辑器和所有守护进程从同一个环境变量读取共享令牌
+constexpr const char* DaemonTokenVariable = "NODEEDITOR_DAEMON_TOKEN";
+QByteArray daemonToken();
+// 连接守护进程后首先发送的认证帧
+void writeAuthenticate(QIODevice* device, const QByteArray& token);
+// 按固定时间比较令牌，不因前缀相同而提前返回
+bool tokenMatches(const QByteArray& expected, const QByteArray& actual);
+
+void writeFrame(QIODevice* device, const QByteArray& payload);
+// 从接收缓冲中取出一个完整的帧；数据不足一帧时返回 false
+bool takeFrame(QByteArray& buffer, QByteArray& frame);
+
+// 缓冲区按大小内联或放入新建的共享内存段；createdSegments 为空时总是内联（跨主机传输）。
+// POD 和其他类型按 QVariant 写入
+void writeValue(QDataStream& stream, const NodeValue& value, Segments* createdSegments);
+// 共享内存中的缓冲区附加后直接引用，不复制；附加失败时抛出异常
+NodeValue readValue(QDataStream& stream, QStringList* attachedSegments = nullptr);
+
+} // namespace WorkerProtocol
+
+#endif // NODEEDITORDEMO_WORKERPROTOCOL_H
\ No newline at end of file
@@ -0,0 +1,87 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "BenchFixture.h"
+#include "FlowValidator.h"
+#include <random>
+
+QString graphShapeName(GraphShape shape)
+{
+    switch (shape) {
+    case GraphShape::Chain: return "chain";
+    case GraphShape::FanOut: return "fanout";
+    case GraphShape::RandomDag: return "dag";
+    }
+    return "unknown";
+}
+
+GraphSpec makeGraph(GraphShape shape, int nodeCount, unsigned int seed)
+{
+    GraphSpec graph;
+    graph.nodes.reserve(nodeCount);
+    for (int i = 0; i < nodeCount; ++i) {
+        // 位置避开 (0,0)，否则会走自动排布
+        graph.nodes.push_back(NodeSpec{"BenchNode", QPointF(1 + (i % 100) * 200, (i / 100) * 150)});
+    }
+
+    std::mt19937 random(seed);
+    switch (shape) {
+    case GraphShape::Chain:
+        graph.connections.reserve(nodeCount);
+        for (int i = 1; i < nodeCount; ++i) {
+            ConnectionSpec conn;
+            conn.sourceIndex = i - 1;
+            conn.targetIndex = i;
+            graph.connections.push_back(conn);
+        }
+        break;
+
+    case GraphShape::FanOut:
+        graph.connections.reserve(nodeCount);
+        for (int i = 1; i < nodeCount; ++i) {
+            ConnectionSpec conn;
+            conn.sourceIndex = 0;
+            conn.targetIndex = i;
+            graph.connections.push_back(conn);
+        }
+        break;
+
+    case GraphShape::RandomDag:
+        graph.connections.reserve(nodeCount * 2);
+        for (int i = 1; i < nodeCount; ++i) {
+            int first = std::uniform_int_distribution<int>(0, i - 1)(random);
+            ConnectionSpec conn;
+            conn.sourceIndex = first;
+            conn.targetIndex = i;
+            graph.connections.push_back(conn);
+
+            if (i >= 2) {
+                int second = std::uniform_int_distribution<int>(0, i - 2)(random);
+                if (second >= first) ++second;
+                conn.sourceIndex = second;
+                conn.targetPort = 1;
+                graph.connections.push_back(conn);
+            }
+        }
+        break;
+    }
+    return graph;
+}
+
+BenchEditor::BenchEditor()
+    : m_core(new NodeEditorCore)
+{
+    m_core->initialize();
+    m_core->registry()->registerModel<BenchNodeModel>("Bench");
+    m_core->registerNodeExecutor("BenchNode", [](NodeId nodeId, const QVariantMap& inputs) {
+        return QVariant(static_cast<int>(nodeId) + inputs.size());
+    });
+    m_core->profiler().setEnabled(false);
+    m_core->validator()->setAutoValidate(false);
+}
+
+std::vector<NodeId> BenchEditor::build(const GraphSpec& graph)
+{
+    return m_core->addGraph(graph.nodes, graph.connections);
+}
@@ -0,0 +1,64 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_BENCHFIXTURE_H
+#define NODEEDITORDEMO_BENCHFIXTURE_H
+
+#include "NodeEditorCore.h"
+#include "BasicNodes.h"
+#include <memory>
+#include <vector>
+
+// 基准测试专用节点：2 个输入、1 个输出，无嵌入控件，用来搭建任意形状的图
+class BenchNodeModel : public NodeDelegateModel
+{
+    Q_OBJECT
+public:
+    QString caption() const override { return "Bench"; }
+    QString name() const override { return "BenchNode"; }
+
+    unsigned int nPorts(PortType portType) const override
+    {
+        return (portType == PortType::In) ? 2 : 1;
+    }
+
+    NodeDataType dataType(PortType, PortIndex) const override { return FlowData().type(); }
+    std::shared_ptr<NodeData> outData(PortIndex) override { return m_data; }
+    void setInData(std::shared_ptr<NodeData>, PortIndex) override {}
+    QWidget* embeddedWidget() override { return nullptr; }
+
+private:
+    std::shared_ptr<NodeData> m_data = std::make_shared<FlowData>();
+};
+
+enum class GraphShape
+{
+    Chain,      // 0 -> 1 -> 2 -> ...
+    FanOut,     // 0 -> 1..N-1
+    RandomDag   // 每个节点最多从 2 个随机的前序节点接收输入
+};
+
+struct GraphSpec
+{
+    std::vector<NodeSpec> nodes;
+    std::vector<ConnectionSpec> connections;
+};
+
+QString graphShapeName(GraphShape shape);
+GraphSpec makeGraph(GraphShape shape, int nodeCount, unsigned int seed = 42);
+
+// 已初始化并注册 BenchNode 的编辑器，默认关闭性能分析
+class BenchEditor
+{
+public:
+    BenchEditor();
+
+    NodeEditorCore& core() { return *m_core; }
+    std::vector<NodeId> build(const GraphSpec& graph);
+
+private:
+    std::unique_ptr<NodeEditorCore> m_core;
+};
+
+#endif // NODEEDITORDEMO_BENCHFIXTURE_H
@@ -0,0 +1,158 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "BenchHarness.h"
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QSysInfo>
+#include <QThread>
+#include <algorithm>
+#include <cstdio>
+
+BenchRegistry& BenchRegistry::instance()
+{
+    static BenchRegistry registry;
+    return registry;
+}
+
+BenchCase& BenchRegistry::add(const QString& name, BenchFunction function)
+{
+    m_cases.push_back(BenchCase{name, std::move(function)});
+    return m_cases.back();
+}
+
+namespace {
+
+struct BenchResult
+{
+    QString name;
+    qint64 iterations = 0;
+    double nsPerIteration = 0.0;
+    double itemsPerSecond = 0.0;
+    QMap<QString, double> counters;
+};
+
+BenchResult runCase(const BenchCase& benchCase, qint64 minTimeNs)
+{
+    qint64 iterations = benchCase.fixedIterations > 0 ? benchCase.fixedIterations : 1;
+
+    for (;;) {
+        BenchState state(iterations);
+        benchCase.function(state);
+
+        bool enough = benchCase.fixedIterations > 0
+                      || state.elapsedNs() >= minTimeNs
+                      || iterations >= 1000000000LL;
+        if (enough) {
+            BenchResult result;
+            result.name = benchCase.name;
+            result.iterations = iterations;
+            result.nsPerIteration = static_cast<double>(state.elapsedNs()) / iterations;
+            if (state.itemsProcessed() > 0 && state.elapsedNs() > 0) {
+                result.itemsPerSecond = state.itemsProcessed() * 1e9 / state.elapsedNs();
+            }
+            result.counters = state.counters();
+            return result;
+        }
+
+        // 按已耗时估算下一轮迭代次数，每轮最多放大 10 倍
+        double scale = state.elapsedNs() > 0
+                       ? 1.4 * minTimeNs / state.elapsedNs()
+                       : 10.0;
+        scale = std::min(10.0, std::max(2.0, scale));
+        iterations = static_cast<qint64>(iterations * scale);
+    }
+}
+
+QJsonObject toJson(const BenchResult& result)
+{
+    QJsonObject json;
+    json["name"] = result.name;
+    json["iterations"] = result.iterations;
+    json["real_time"] = result.nsPerIteration;
+    json["time_unit"] = "ns";
+    if (result.itemsPerSecond > 0) {
+        json["items_per_second"] = result.itemsPerSecond;
+    }
+    for (auto it = result.counters.begin(); it != result.counters.end(); ++it) {
+        json[it.key()] = it.value();
+    }
+    return json;
+}
+
+} // namespace
+
+int runBenchmarks(const QStringList& arguments)
+{
+    QRegularExpression filter(".*");
+    qint64 minTimeNs = 200LL * 1000 * 1000;
+    QString jsonPath;
+    bool listOnly = false;
+
+    for (const QString& arg : arguments) {
+        if (arg.startsWith("--filter=")) {
+            filter.setPattern(arg.mid(9));
+        } else if (arg.startsWith("--min-time=")) {
+            minTimeNs = arg.mid(11).toLongLong() * 1000 * 1000;
+        } else if (arg.startsWith("--json=")) {
+            jsonPath = arg.mid(7);
+        } else if (arg == "--list") {
+            listOnly = true;
+        }
+    }
+
+    if (!filter.isValid()) {
+        std::fprintf(stderr, "无效的过滤表达式: %s\n", qPrintable(filter.pattern()));
+        return 1;
+    }
+
+    QJsonArray benchmarks;
+    std::printf("%-56s %14s %16s %16s\n", "Benchmark", "Iterations", "ns/iter", "items/s");
+
+    for (const BenchCase& benchCase : BenchRegistry::instance().cases()) {
+        if (!filter.match(benchCase.name).hasMatch()) continue;
+
+        if (listOnly) {
+            std::printf("%s\n", qPrintable(benchCase.name));
+            continue;
+        }
+
+        BenchResult result = runCase(benchCase, minTimeNs);
+        std::printf("%-56s %14lld %16.1f %16.0f\n", qPrintable(result.name),
+                    static_cast<long long>(result.iterations),
+                    result.nsPerIteration, result.itemsPerSecond);
+        std::fflush(stdout);
+        benchmarks.append(toJson(result));
+    }
+
+    if (!jsonPath.isEmpty()) {
+        QJsonObject context;
+        context["date"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+        context["host_name"] = QSysInfo::machineHostName();
+        context["num_cpus"] = QThread::idealThreadCount();
+        context["cpu_architecture"] = QSysInfo::currentCpuArchitecture();
+#ifdef QT_NO_DEBUG
+        context["library_build_type"] = "release";
+#else
+        context["library_build_type"] = "debug";
+#endif
+
+        QJsonObject root;
+        root["context"] = context;
+        root["benchmarks"] = benchmarks;
+
+        QFile file(jsonPath);
+        if (!file.open(QIODevice::WriteOnly)) {
+            std::fprintf(stderr, "无法写入结果文件: %s\n", qPrintable(jsonPath));
+            return 1;
+        }
+        file.write(QJsonDocument(root).toJson());
+    }
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_BENCHHARNESS_H
+#define NODEEDITORDEMO_BENCHHARNESS_H
+
+#include <QElapsedTimer>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <functional>
+#include <vector>
+
+// 轻量基准测试框架，用法与 Google Benchmark 类似：
+//   BenchRegistry::instance().add("Name", [](BenchState& state) {
+//       准备数据...
+//       while (state.keepRunning()) { 被测代码 }
+//   });
+// 命令行：--filter=<正则> --min-time=<毫秒> --json=<文件> --list
+class BenchState
+{
+public:
+    explicit BenchState(qint64 iterations)
+        : m_iterations(iterations)
+        , m_remaining(iterations)
+    {
+    }
+
+    bool keepRunning()
+    {
+        if (!m_started) {
+            m_started = true;
+            resumeTiming();
+        }
+        if (m_remaining > 0) {
+            --m_remaining;
+            return true;
+        }
+        pauseTiming();
+        return false;
+    }
+
+    // 暂停/恢复计时，用于排除每轮迭代中的准备工作
+    void pauseTiming()
+    {
+        if (m_running) {
+            m_elapsedNs += m_timer.nsecsElapsed();
+            m_running = false;
+        }
+    }
+
+    void resumeTiming()
+    {
+        if (!m_running) {
+            m_timer.restart();
+            m_running = true;
+        }
+    }
+
+    qint64 iterations() const { return m_iterations; }
+    qint64 elapsedNs() const { return m_elapsedNs; }
+
+    void setItemsProcessed(qint64 items) { m_itemsProcessed = items; }
+    qint64 itemsProcessed() const { return m_itemsProcessed; }
+
+    void setCounter(const QString& name, double value) { m_counters[name] = value; }
+    const QMap<QString, double>& counters() const { return m_counters; }
+
+private:
+    QElapsedTimer m_timer;
+    qint64 m_iterations;
+    qint64 m_remaining;
+    qint64 m_elapsedNs = 0;
+    qint64 m_itemsProcessed = 0;
+    bool m_started = false;
+    bool m_running = false;
+    QMap<QString, double> m_counters;
+};
+
+using BenchFunction = std::function<void(BenchState&)>;
+
+struct BenchCase
+{
+    QString name;
+    BenchFunction function;
+    qint64 fixedIterations = 0;   // 大于 0 时不做迭代次数校准（适合准备成本很高的用例）
+
+    BenchCase& iterations(qint64 count)
+    {
+        fixedIterations = count;
+        return *this;
+    }
+};
+
+class BenchRegistry
+{
+public:
+    static BenchRegistry& instance();
+
+    BenchCase& add(const QString& name, BenchFunction function);
+    const std::vector<BenchCase>& cases() const { return m_cases; }
+
+private:
+    std::vector<BenchCase> m_cases;
+};
+
+int runBenchmarks(const QStringList& arguments);
+
+#endif // NODEEDITORDEMO_BENCHHARNESS_H
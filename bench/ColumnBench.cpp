@@ -0,0 +1,97 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "BenchHarness.h"
+#include "ColumnKernels.h"
+#include "NodeEditorCore.h"
+
+// 列内核对比逐值执行：同样处理 Rows 个 double 的加法/比较
+// 名称格式：Column/<运算>/<legacy|typed|scalar|avx2|neon>，items 为处理的元素个数
+namespace {
+
+const size_t Rows = ColumnKernels::ChunkRows;
+
+SharedBuffer makeInput(double offset)
+{
+    SharedBuffer column = ColumnKernels::makeColumn(ColumnType::Float64, Rows);
+    double* data = reinterpret_cast<double*>(column.mutableData());
+    for (size_t i = 0; i < Rows; ++i) {
+        data[i] = offset + static_cast<double>(i % 97);
+    }
+    return column;
+}
+
+void runPerValue(BenchState& state, const NodeEditorCore::TypedNodeExecutor& executor)
+{
+    SharedBuffer lhs = makeInput(1.5);
+    SharedBuffer rhs = makeInput(2.25);
+    const double* a = reinterpret_cast<const double*>(lhs.data());
+    const double* b = reinterpret_cast<const double*>(rhs.data());
+
+    double sum = 0.0;
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < Rows; ++i) {
+            NodeValue x(a[i]);
+            NodeValue y(b[i]);
+            const NodeValue* values[] = {&x, &y};
+            sum += executor(1, NodeInputs(values, 2)).toDouble();
+        }
+    }
+    state.setItemsProcessed(state.iterations() * static_cast<qint64>(Rows));
+    state.setCounter("checksum", sum);
+}
+
+void runKernel(BenchState& state, ColumnOp op, bool simd)
+{
+    ColumnKernels::setSimdEnabled(simd);
+    ColumnKernel kernel = ColumnKernels::binary(op);
+    NodeValue lhs(makeInput(1.5));
+    NodeValue rhs(makeInput(2.25));
+    const NodeValue* values[] = {&lhs, &rhs};
+    NodeInputs inputs(values, 2);
+
+    double sum = 0.0;
+    while (state.keepRunning()) {
+        SharedBuffer result = kernel(1, inputs);
+        sum += ColumnKernels::columnType(result) == ColumnType::Int64
+            ? static_cast<double>(reinterpret_cast<const qint64*>(result.data())[Rows - 1])
+            : reinterpret_cast<const double*>(result.data())[Rows - 1];
+    }
+    state.setItemsProcessed(state.iterations() * static_cast<qint64>(Rows));
+    state.setCounter("checksum", sum);
+    ColumnKernels::setSimdEnabled(true);
+}
+
+const bool registered = [] {
+    auto& registry = BenchRegistry::instance();
+
+    registry.add("Column/add/legacy", [](BenchState& state) {
+        runPerValue(state, NodeEditorCore::adaptNodeExecutor([](NodeId, const QVariantMap& inputs) {
+            return QVariant(inputs.value("input0").toDouble() + inputs.value("input1").toDouble());
+        }));
+    });
+
+    registry.add("Column/add/typed", [](BenchState& state) {
+        runPerValue(state, [](NodeId, const NodeInputs& inputs) {
+            return NodeValue(inputs[0].toDouble() + inputs[1].toDouble());
+        });
+    });
+
+    // 向量实现以实际使用的指令集命名（avx2/neon），不支持时与 scalar 相同
+    const QString backend = ColumnKernels::simdBackend();
+    const std::pair<const char*, ColumnOp> ops[] = {{"add", ColumnOp::Add}, {"less", ColumnOp::Less}};
+    for (const auto& op : ops) {
+        ColumnOp kind = op.second;
+        registry.add(QString("Column/%1/scalar").arg(op.first), [kind](BenchState& state) {
+            runKernel(state, kind, false);
+        });
+        registry.add(QString("Column/%1/%2").arg(op.first, backend), [kind](BenchState& state) {
+            runKernel(state, kind, true);
+        });
+    }
+
+    return true;
+}();
+
+} // namespace
\ No newline at end of file
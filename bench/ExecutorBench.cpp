@@ -0,0 +1,54 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "BenchHarness.h"
+#include "NodeEditorCore.h"
+
+// 数值节点的执行器调用开销：旧式 QVariantMap 执行器（经适配器）对比类型化执行器
+namespace {
+
+const bool registered = [] {
+    auto& registry = BenchRegistry::instance();
+
+    registry.add("Executor/add/legacy", [](BenchState& state) {
+        NodeEditorCore::TypedNodeExecutor executor = NodeEditorCore::adaptNodeExecutor(
+            [](NodeId, const QVariantMap& inputs) {
+                return QVariant(inputs.value("input0").toDouble() + inputs.value("input1").toDouble());
+            });
+
+        NodeValue a(1.5);
+        NodeValue b(2.25);
+        const NodeValue* values[] = {&a, &b};
+        NodeInputs inputs(values, 2);
+
+        double sum = 0.0;
+        while (state.keepRunning()) {
+            sum += executor(1, inputs).toDouble();
+        }
+        state.setItemsProcessed(state.iterations());
+        state.setCounter("checksum", sum);
+    });
+
+    registry.add("Executor/add/typed", [](BenchState& state) {
+        NodeEditorCore::TypedNodeExecutor executor = [](NodeId, const NodeInputs& inputs) {
+            return NodeValue(inputs[0].toDouble() + inputs[1].toDouble());
+        };
+
+        NodeValue a(1.5);
+        NodeValue b(2.25);
+        const NodeValue* values[] = {&a, &b};
+        NodeInputs inputs(values, 2);
+
+        double sum = 0.0;
+        while (state.keepRunning()) {
+            sum += executor(1, inputs).toDouble();
+        }
+        state.setItemsProcessed(state.iterations());
+        state.setCounter("checksum", sum);
+    });
+
+    return true;
+}();
+
+} // namespace
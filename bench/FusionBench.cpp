@@ -0,0 +1,40 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "BenchFixture.h"
+#include "BenchHarness.h"
+
+// 表达式融合：BenchNode 注册为可融合的加法，链和随机 DAG 上对比融合前后的 executeFlow
+// 名称格式：Fusion/<fused|unfused>/<图形状>/<节点数>
+namespace {
+
+const int NodeCounts[] = {100, 10000};
+const GraphShape Shapes[] = {GraphShape::Chain, GraphShape::RandomDag};
+
+const bool registered = [] {
+    auto& registry = BenchRegistry::instance();
+
+    for (GraphShape shape : Shapes) {
+        for (int nodeCount : NodeCounts) {
+            for (bool fused : {true, false}) {
+                QString name = QString("Fusion/%1/%2/%3")
+                    .arg(fused ? "fused" : "unfused", graphShapeName(shape)).arg(nodeCount);
+                registry.add(name, [shape, nodeCount, fused](BenchState& state) {
+                    BenchEditor editor;
+                    editor.core().registerFusableNode("BenchNode", [](const QJsonObject&) { return FusableOp::Add; });
+                    editor.core().setExpressionFusionEnabled(fused);
+                    editor.build(makeGraph(shape, nodeCount));
+                    while (state.keepRunning()) {
+                        editor.core().executeFlow();
+                    }
+                    state.setItemsProcessed(state.iterations() * nodeCount);
+                });
+            }
+        }
+    }
+
+    return true;
+}();
+
+} // namespace
\ No newline at end of file
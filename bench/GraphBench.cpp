@@ -0,0 +1,197 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "BenchFixture.h"
+#include "BenchHarness.h"
+#include <QJsonObject>
+
+// 模型编辑、执行和序列化热路径的基准测试
+// 名称格式：<分组>/<操作>/<图形状>/<节点数>，可用 --filter 选择
+namespace {
+
+const int GraphSizes[] = {1000, 10000, 100000, 1000000};
+const GraphShape GraphShapes[] = {GraphShape::Chain, GraphShape::FanOut, GraphShape::RandomDag};
+
+// 大图的准备成本远高于被测操作，只跑固定次数
+qint64 fixedIterationsFor(int nodeCount)
+{
+    return nodeCount >= 100000 ? 1 : 0;
+}
+
+QString caseName(const QString& group, GraphShape shape, int nodeCount)
+{
+    return QString("%1/%2/%3").arg(group, graphShapeName(shape)).arg(nodeCount);
+}
+
+// 删除并重新添加第一条连接：图结构变化，快照和执行计划失效，下一次查询重新构建。
+// 在 pauseTiming 期间调用，被测的是缓存失效后的完整计算而不是缓存命中
+void touchGraph(BenchEditor& editor, const GraphSpec& graph, const std::vector<NodeId>& ids)
+{
+    if (graph.connections.empty()) return;
+    const ConnectionSpec& conn = graph.connections.front();
+    const ConnectionId connectionId{ids[conn.sourceIndex], conn.sourcePort, ids[conn.targetIndex], conn.targetPort};
+    editor.core().removeConnection(connectionId);
+    editor.core().addConnection(connectionId.outNodeId, connectionId.outPortIndex,
+                                connectionId.inNodeId, connectionId.inPortIndex);
+}
+
+void registerEditingCases(BenchRegistry& registry, int nodeCount)
+{
+    registry.add(QString("Model/addNode/%1").arg(nodeCount), [nodeCount](BenchState& state) {
+        BenchEditor editor;
+        while (state.keepRunning()) {
+            for (int i = 0; i < nodeCount; ++i) {
+                editor.core().addNode("BenchNode", QPointF(1 + i, 0));
+            }
+            state.pauseTiming();
+            editor.core().clearScene();
+            state.resumeTiming();
+        }
+        state.setItemsProcessed(state.iterations() * nodeCount);
+    }).iterations(fixedIterationsFor(nodeCount));
+
+    registry.add(QString("Model/clearScene/%1").arg(nodeCount), [nodeCount](BenchState& state) {
+        BenchEditor editor;
+        GraphSpec graph = makeGraph(GraphShape::Chain, nodeCount);
+        while (state.keepRunning()) {
+            state.pauseTiming();
+            editor.build(graph);
+            state.resumeTiming();
+            editor.core().clearScene();
+        }
+        state.setItemsProcessed(state.iterations() * nodeCount);
+    }).iterations(fixedIterationsFor(nodeCount));
+}
+
+void registerShapeCases(BenchRegistry& registry, GraphShape shape, int nodeCount)
+{
+    const qint64 fixed = fixedIterationsFor(nodeCount);
+
+    registry.add(caseName("Model/addConnection", shape, nodeCount), [shape, nodeCount](BenchState& state) {
+        BenchEditor editor;
+        GraphSpec graph = makeGraph(shape, nodeCount);
+        GraphSpec nodesOnly{graph.nodes, {}};
+        while (state.keepRunning()) {
+            state.pauseTiming();
+            editor.core().clearScene();
+            std::vector<NodeId> ids = editor.build(nodesOnly);
+            state.resumeTiming();
+            for (const ConnectionSpec& conn : graph.connections) {
+                editor.core().addConnection(ids[conn.sourceIndex], conn.sourcePort,
+                                            ids[conn.targetIndex], conn.targetPort);
+            }
+        }
+        state.setItemsProcessed(state.iterations() * static_cast<qint64>(graph.connections.size()));
+    }).iterations(fixed);
+
+    registry.add(caseName("Model/addGraph", shape, nodeCount), [shape, nodeCount](BenchState& state) {
+        BenchEditor editor;
+        GraphSpec graph = makeGraph(shape, nodeCount);
+        while (state.keepRunning()) {
+            state.pauseTiming();
+            editor.core().clearScene();
+            state.resumeTiming();
+            editor.build(graph);
+        }
+        state.setItemsProcessed(state.iterations() * nodeCount);
+    }).iterations(fixed);
+
+    registry.add(caseName("Model/connectionCount", shape, nodeCount), [shape, nodeCount](BenchState& state) {
+        BenchEditor editor;
+        GraphSpec graph = makeGraph(shape, nodeCount);
+        std::vector<NodeId> ids = editor.build(graph);
+        volatile int sink = 0;
+        while (state.keepRunning()) {
+            state.pauseTiming();
+            touchGraph(editor, graph, ids);
+            state.resumeTiming();
+            sink = editor.core().connectionCount();
+        }
+        state.setCounter("connections", sink);
+    }).iterations(fixed);
+
+    registry.add(caseName("Exec/getExecutionOrder", shape, nodeCount), [shape, nodeCount](BenchState& state) {
+        BenchEditor editor;
+        GraphSpec graph = makeGraph(shape, nodeCount);
+        std::vector<NodeId> ids = editor.build(graph);
+        while (state.keepRunning()) {
+            state.pauseTiming();
+            touchGraph(editor, graph, ids);
+            state.resumeTiming();
+            QList<NodeId> order = editor.core().getExecutionOrder();
+            if (order.size() != nodeCount) {
+                state.setCounter("error", 1);
+            }
+        }
+        state.setItemsProcessed(state.iterations() * nodeCount);
+    }).iterations(fixed);
+
+    registry.add(caseName("Exec/getExecutionOrderCached", shape, nodeCount), [shape, nodeCount](BenchState& state) {
+        BenchEditor editor;
+        editor.build(makeGraph(shape, nodeCount));
+        while (state.keepRunning()) {
+            QList<NodeId> order = editor.core().getExecutionOrder();
+            if (order.size() != nodeCount) {
+                state.setCounter("error", 1);
+            }
+        }
+        state.setItemsProcessed(state.iterations() * nodeCount);
+    }).iterations(fixed);
+
+    registry.add(caseName("Exec/executeFlow", shape, nodeCount), [shape, nodeCount](BenchState& state) {
+        BenchEditor editor;
+        editor.build(makeGraph(shape, nodeCount));
+        while (state.keepRunning()) {
+            editor.core().executeFlow();
+        }
+        state.setItemsProcessed(state.iterations() * nodeCount);
+    }).iterations(fixed);
+
+    registry.add(caseName("Exec/executeFlowProfiled", shape, nodeCount), [shape, nodeCount](BenchState& state) {
+        BenchEditor editor;
+        editor.build(makeGraph(shape, nodeCount));
+        editor.core().profiler().setEnabled(true);
+        while (state.keepRunning()) {
+            editor.core().executeFlow();
+        }
+        state.setItemsProcessed(state.iterations() * nodeCount);
+    }).iterations(fixed);
+
+    registry.add(caseName("IO/saveScene", shape, nodeCount), [shape, nodeCount](BenchState& state) {
+        BenchEditor editor;
+        editor.build(makeGraph(shape, nodeCount));
+        qint64 keys = 0;
+        while (state.keepRunning()) {
+            keys += editor.core().saveScene().size();
+        }
+        state.setItemsProcessed(state.iterations() * nodeCount);
+        state.setCounter("top_level_keys", static_cast<double>(keys) / state.iterations());
+    }).iterations(fixed);
+
+    registry.add(caseName("IO/loadScene", shape, nodeCount), [shape, nodeCount](BenchState& state) {
+        BenchEditor editor;
+        editor.build(makeGraph(shape, nodeCount));
+        QJsonObject json = editor.core().saveScene();
+        while (state.keepRunning()) {
+            state.pauseTiming();
+            editor.core().clearScene();
+            state.resumeTiming();
+            editor.core().loadScene(json);
+        }
+        state.setItemsProcessed(state.iterations() * nodeCount);
+    }).iterations(fixed);
+}
+
+const bool registered = [] {
+    auto& registry = BenchRegistry::instance();
+    for (int nodeCount : GraphSizes) {
+        registerEditingCases(registry, nodeCount);
+        for (GraphShape shape : GraphShapes) {
+            registerShapeCases(registry, shape, nodeCount);
+        }
+    }
+    return true;
+}();
+
+} // namespace
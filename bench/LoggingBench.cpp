@@ -0,0 +1,106 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "BenchHarness.h"
+#include <QDebug>
+#include <QLoggingCategory>
+#include <QPointF>
+#include <QVariantMap>
+
+// 模拟 executeNode 中逐个输入打印日志的写法，对比几种日志方式的开销
+void logInputsCompiledOut(const QVariantMap& inputs, unsigned int nodeId);
+
+namespace {
+
+Q_LOGGING_CATEGORY(lcBenchFiltered, "bench.filtered", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcBenchEnabled, "bench.enabled")
+
+void discardMessage(QtMsgType, const QMessageLogContext&, const QString&)
+{
+}
+
+QVariantMap makeInputs()
+{
+    QVariantMap inputs;
+    inputs["input0"] = QVariant("flow_started");
+    inputs["input1"] = QVariant(3.1415926);
+    inputs["input2"] = QVariant(QVariantList{1, 2, 3, 4});
+    inputs["input3"] = QVariant(QPointF(120.5, 80.25));
+    return inputs;
+}
+
+// 日志输出丢弃，只测格式化本身的开销
+class DiscardHandlerScope
+{
+public:
+    DiscardHandlerScope() : m_previous(qInstallMessageHandler(discardMessage)) {}
+    ~DiscardHandlerScope() { qInstallMessageHandler(m_previous); }
+
+private:
+    QtMessageHandler m_previous;
+};
+
+const bool registered = [] {
+    auto& registry = BenchRegistry::instance();
+
+    registry.add("Logging/executeNode/none", [](BenchState& state) {
+        const QVariantMap inputs = makeInputs();
+        volatile int sink = 0;
+        while (state.keepRunning()) {
+            for (auto it = inputs.begin(); it != inputs.end(); ++it) {
+                sink = sink + it.key().size();
+            }
+        }
+        state.setItemsProcessed(state.iterations() * inputs.size());
+    });
+
+    registry.add("Logging/executeNode/qDebug", [](BenchState& state) {
+        DiscardHandlerScope scope;
+        const QVariantMap inputs = makeInputs();
+        unsigned int nodeId = 42;
+        while (state.keepRunning()) {
+            for (auto it = inputs.begin(); it != inputs.end(); ++it) {
+                qDebug() << "输入" << it.key() << "来自节点" << nodeId << "值:" << it.value();
+            }
+        }
+        state.setItemsProcessed(state.iterations() * inputs.size());
+    });
+
+    registry.add("Logging/executeNode/qCDebug_enabled", [](BenchState& state) {
+        DiscardHandlerScope scope;
+        const QVariantMap inputs = makeInputs();
+        unsigned int nodeId = 42;
+        while (state.keepRunning()) {
+            for (auto it = inputs.begin(); it != inputs.end(); ++it) {
+                qCDebug(lcBenchEnabled) << "输入" << it.key() << "来自节点" << nodeId << "值:" << it.value();
+            }
+        }
+        state.setItemsProcessed(state.iterations() * inputs.size());
+    });
+
+    registry.add("Logging/executeNode/qCDebug_filtered", [](BenchState& state) {
+        DiscardHandlerScope scope;
+        const QVariantMap inputs = makeInputs();
+        unsigned int nodeId = 42;
+        while (state.keepRunning()) {
+            for (auto it = inputs.begin(); it != inputs.end(); ++it) {
+                qCDebug(lcBenchFiltered) << "输入" << it.key() << "来自节点" << nodeId << "值:" << it.value();
+            }
+        }
+        state.setItemsProcessed(state.iterations() * inputs.size());
+    });
+
+    registry.add("Logging/executeNode/compiled_out", [](BenchState& state) {
+        DiscardHandlerScope scope;
+        const QVariantMap inputs = makeInputs();
+        while (state.keepRunning()) {
+            logInputsCompiledOut(inputs, 42);
+        }
+        state.setItemsProcessed(state.iterations() * inputs.size());
+    });
+
+    return true;
+}();
+
+} // namespace
@@ -0,0 +1,19 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+// 本文件以 QT_NO_DEBUG_OUTPUT 编译（见 bench/CMakeLists.txt），对应 NODEEDITOR_DEBUG_LOG=OFF 的效果
+#include <QDebug>
+#include <QLoggingCategory>
+#include <QVariantMap>
+
+namespace {
+Q_LOGGING_CATEGORY(lcBenchCompiledOut, "bench.compiledout")
+}
+
+void logInputsCompiledOut(const QVariantMap& inputs, unsigned int nodeId)
+{
+    for (auto it = inputs.begin(); it != inputs.end(); ++it) {
+        qCDebug(lcBenchCompiledOut) << "输入" << it.key() << "来自节点" << nodeId << "值:" << it.value();
+    }
+}
@@ -0,0 +1,50 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "BenchFixture.h"
+#include "BenchHarness.h"
+#include "MathNodes.h"
+
+// 实时输入的事件驱动传播：改变 MathOperation 链头部的输入，变化沿链下传到 TextDisplay
+// 名称格式：Propagation/<changed|unchanged>/<链长>；unchanged 时输入不变，应在第一个节点处截止
+namespace {
+
+const int ChainLengths[] = {10, 100};
+
+const bool registered = [] {
+    auto& registry = BenchRegistry::instance();
+
+    for (int length : ChainLengths) {
+        for (bool changed : {true, false}) {
+            QString name = QString("Propagation/%1/%2").arg(changed ? "changed" : "unchanged").arg(length);
+            registry.add(name, [length, changed](BenchState& state) {
+                BenchEditor editor;
+                std::vector<NodeSpec> nodes;
+                std::vector<ConnectionSpec> connections;
+                for (int i = 0; i <= length; ++i) {
+                    nodes.push_back(NodeSpec{i < length ? "MathOperation" : "TextDisplay", QPointF(200.0 * i, 0)});
+                    if (i > 0) {
+                        ConnectionSpec conn;
+                        conn.sourceIndex = i - 1;
+                        conn.targetIndex = i;
+                        connections.push_back(conn);
+                    }
+                }
+                std::vector<NodeId> ids = editor.build(GraphSpec{nodes, connections});
+                auto* head = editor.core().graphModel()->delegateModel<MathOperationModel>(ids.front());
+
+                double value = 1.0;
+                while (state.keepRunning()) {
+                    if (changed) value += 1.0;
+                    head->setInData(std::make_shared<NumberData>(value), 0);
+                }
+                state.setItemsProcessed(state.iterations() * length);
+            });
+        }
+    }
+
+    return true;
+}();
+
+} // namespace
\ No newline at end of file
@@ -0,0 +1,64 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "BenchFixture.h"
+#include "BenchHarness.h"
+#include <QThread>
+
+// 调度顺序：不均衡的图（一条长链 + 大量互不依赖的短节点），每个节点耗时约 1 ms，
+// 对比按计划顺序（先就绪先执行）与按关键路径分派的完成时间
+// 名称格式：Scheduler/<plan|critical>/<线程数>
+namespace {
+
+const int ChainLength = 40;
+const int IndependentCount = 120;
+const int ThreadCounts[] = {2, 4};
+
+// 独立节点的 NodeId 较小，按计划顺序它们排在长链之前
+GraphSpec makeUnbalancedGraph()
+{
+    GraphSpec graph;
+    const int nodeCount = IndependentCount + ChainLength;
+    for (int i = 0; i < nodeCount; ++i) {
+        graph.nodes.push_back(NodeSpec{"BenchNode", QPointF(1 + (i % 100) * 200, (i / 100) * 150)});
+    }
+    for (int i = IndependentCount + 1; i < nodeCount; ++i) {
+        ConnectionSpec conn;
+        conn.sourceIndex = i - 1;
+        conn.targetIndex = i;
+        graph.connections.push_back(conn);
+    }
+    return graph;
+}
+
+const bool registered = [] {
+    auto& registry = BenchRegistry::instance();
+
+    for (int threads : ThreadCounts) {
+        for (SchedulingOrder order : {SchedulingOrder::PlanOrder, SchedulingOrder::CriticalPath}) {
+            QString name = QString("Scheduler/%1/%2")
+                .arg(order == SchedulingOrder::CriticalPath ? "critical" : "plan").arg(threads);
+            registry.add(name, [order, threads](BenchState& state) {
+                BenchEditor editor;
+                NodeEditorCore& core = editor.core();
+                core.registerTypedNodeExecutor("BenchNode", [](NodeId, const NodeInputs&) {
+                    QThread::usleep(1000);
+                    return NodeValue(1.0);
+                });
+                core.setMaxParallelNodes(threads);
+                core.setSchedulingOrder(order);
+                editor.build(makeUnbalancedGraph());
+                while (state.keepRunning()) {
+                    core.executeFlow();
+                }
+                state.setItemsProcessed(state.iterations() * (IndependentCount + ChainLength));
+                state.setCounter("criticalPathUs", core.lastExecutionReport().criticalPathNs / 1000.0);
+            });
+        }
+    }
+
+    return true;
+}();
+
+} // namespace
\ No newline at end of file
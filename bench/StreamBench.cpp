@@ -0,0 +1,91 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "BenchFixture.h"
+#include "BenchHarness.h"
+
+// 流式执行吞吐：开始节点后接一条 BenchNode 链，对比逐条执行器和批量执行器
+// 名称格式：Stream/<执行器>/<链长>，每轮处理 RecordCount 条记录
+namespace {
+
+const size_t RecordCount = 200000;
+const int ChainLengths[] = {4, 32};
+
+void buildStreamChain(BenchEditor& editor, int length)
+{
+    std::vector<NodeSpec> nodes;
+    std::vector<ConnectionSpec> connections;
+    nodes.push_back(NodeSpec{"StartNode", QPointF(0, 0)});
+    for (int i = 1; i <= length; ++i) {
+        nodes.push_back(NodeSpec{"BenchNode", QPointF(200.0 * i, 0)});
+        ConnectionSpec conn;
+        conn.sourceIndex = i - 1;
+        conn.targetIndex = i;
+        connections.push_back(conn);
+    }
+    editor.build(GraphSpec{nodes, connections});
+}
+
+RecordSource makeSource(size_t total)
+{
+    auto produced = std::make_shared<size_t>(0);
+    return [produced, total](RecordBatch& batch, size_t maxRecords) {
+        size_t count = std::min(maxRecords, total - *produced);
+        for (size_t i = 0; i < count; ++i) {
+            batch.emplace_back(static_cast<qint64>(*produced + i));
+        }
+        *produced += count;
+        return count;
+    };
+}
+
+void runStream(BenchState& state, BenchEditor& editor)
+{
+    qint64 checksum = 0;
+    while (state.keepRunning()) {
+        StreamResult result = editor.core().executeStream(makeSource(RecordCount),
+            [&checksum](NodeId, const RecordBatch& batch) {
+                if (!batch.empty()) checksum += batch.back().toInt();
+            });
+        if (!result.success) {
+            state.setCounter("failed", 1);
+            break;
+        }
+    }
+    state.setItemsProcessed(state.iterations() * static_cast<qint64>(RecordCount));
+    state.setCounter("checksum", static_cast<double>(checksum));
+}
+
+const bool registered = [] {
+    auto& registry = BenchRegistry::instance();
+
+    for (int length : ChainLengths) {
+        registry.add(QString("Stream/perRecord/%1").arg(length), [length](BenchState& state) {
+            BenchEditor editor;
+            editor.core().registerTypedNodeExecutor("BenchNode", [](NodeId, const NodeInputs& inputs) {
+                return NodeValue(inputs[0].toInt() + 1);
+            });
+            buildStreamChain(editor, length);
+            runStream(state, editor);
+        });
+
+        registry.add(QString("Stream/batch/%1").arg(length), [length](BenchState& state) {
+            BenchEditor editor;
+            editor.core().registerBatchNodeExecutor("BenchNode",
+                [](NodeId, const BatchInputs& inputs, RecordBatch& outputs) {
+                    const RecordBatch* input = inputs.column(0);
+                    outputs.reserve(inputs.rowCount());
+                    for (size_t row = 0; row < inputs.rowCount(); ++row) {
+                        outputs.emplace_back((input ? (*input)[row].toInt() : 0) + 1);
+                    }
+                });
+            buildStreamChain(editor, length);
+            runStream(state, editor);
+        });
+    }
+
+    return true;
+}();
+
+} // namespace
\ No newline at end of file
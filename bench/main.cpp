@@ -0,0 +1,20 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "BenchHarness.h"
+#include <QApplication>
+#include <QLoggingCategory>
+
+int main(int argc, char *argv[])
+{
+    // 基准测试不需要显示窗口，默认使用 offscreen 平台
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication app(argc, argv);
+    QLoggingCategory::setFilterRules("nodeeditor.*.debug=false");
+
+    return runBenchmarks(app.arguments().mid(1));
+}
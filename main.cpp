@@ -3,9 +3,22 @@
 #include <QDebug>
 
 #include "MainWindow.h"
+#include "ExecutorDaemon.h"
+#include "ExecutorWorker.h"
+#include "Logging.h"
 
 int main(int argc, char *argv[])
 {
+    // 执行工作进程、分布式守护进程与编辑器共用同一个可执行文件
+    for (int i = 1; i < argc; ++i) {
+        if (qstrcmp(argv[i], ExecutorWorker::CommandLineFlag) == 0) {
+            return ExecutorWorker::run(argc, argv);
+        }
+        if (qstrcmp(argv[i], ExecutorDaemon::CommandLineFlag) == 0) {
+            return ExecutorDaemon::run(argc, argv);
+        }
+    }
+
     QApplication app(argc, argv);
 
     // 设置应用程序信息
@@ -13,21 +26,21 @@ int main(int argc, char *argv[])
     app.setApplicationVersion("1.0");
     app.setOrganizationName("CustomNodeEditor");
 
-    qDebug() << "应用程序启动...";
+    qCDebug(lcUi) << "应用程序启动...";
 
     try {
         MainWindow window;
         window.show();
 
-        qDebug() << "主窗口创建成功";
+        qCDebug(lcUi) << "主窗口创建成功";
 
         return app.exec();
 
     } catch (const std::exception& e) {
-        qCritical() << "应用程序启动失败:" << e.what();
+        qCCritical(lcUi) << "应用程序启动失败:" << e.what();
         return 1;
     } catch (...) {
-        qCritical() << "应用程序启动失败: 未知异常";
+        qCCritical(lcUi) << "应用程序启动失败: 未知异常";
         return 1;
     }
 }
\ No newline at end of file
@@ -3,7 +3,9 @@
 //
 
 #include "mainwindow.h"
-#include "mainwindow.h"
+#include "Logging.h"
+#include "FlowValidator.h"
+#include "NodeSearchIndex.h"
 #include <QToolBar>
 #include <QMenuBar>
 #include <QAction>
@@ -19,10 +21,12 @@
 #include <QJsonDocument>
 #include <QFile>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QMimeData>
 #include <QDragEnterEvent>
 #include <QDropEvent>
 #include <QGraphicsView>
+#include <QVBoxLayout>
 
 MainWindow::MainWindow(QWidget* parent)
     : QMainWindow(parent)
@@ -32,14 +36,15 @@ MainWindow::MainWindow(QWidget* parent)
     , m_statusLabel(nullptr)
     , m_nodeCountLabel(nullptr)
     , m_connectionCountLabel(nullptr)
+    , m_diagnosticLabel(nullptr)
     , m_isModified(false)
 {
 
-    qDebug() << "MainWindow 构造函数开始";
+    qCDebug(lcUi) << "MainWindow 构造函数开始";
 
     // 启用拖拽接受
     setAcceptDrops(true);
-    qDebug() << "主窗口拖拽接受已启用";
+    qCDebug(lcUi) << "主窗口拖拽接受已启用";
 
     // 初始化核心组件
     if (m_editorCore->initialize()) {
@@ -57,7 +62,7 @@ MainWindow::MainWindow(QWidget* parent)
         setWindowTitle("QtNodes Editor - 拖拽式节点编辑器");
         resize(1400, 900);
 
-        qDebug() << "MainWindow 初始化完成";
+        qCDebug(lcUi) << "MainWindow 初始化完成";
     } else {
         QMessageBox::critical(this, "错误", "编辑器核心初始化失败");
         close();
@@ -70,43 +75,43 @@ MainWindow::MainWindow(QWidget* parent)
 # if 0
 void MainWindow::checkDragDropSettings()
 {
-    qDebug() << "=== 拖拽设置检查 ===";
-    qDebug() << "主窗口 acceptDrops:" << acceptDrops();
+    qCDebug(lcUi) << "=== 拖拽设置检查 ===";
+    qCDebug(lcUi) << "主窗口 acceptDrops:" << acceptDrops();
     if (m_editorCore && m_editorCore->view()) {
-        qDebug() << "视图 acceptDrops:" << m_editorCore->view()->acceptDrops();
-        qDebug() << "视图几何:" << m_editorCore->view()->geometry();
+        qCDebug(lcUi) << "视图 acceptDrops:" << m_editorCore->view()->acceptDrops();
+        qCDebug(lcUi) << "视图几何:" << m_editorCore->view()->geometry();
     }
     if (m_nodeList) {
-        qDebug() << "节点列表 acceptDrops:" << m_nodeList->acceptDrops();
-        qDebug() << "节点列表 dragEnabled:" << m_nodeList->dragEnabled();
+        qCDebug(lcUi) << "节点列表 acceptDrops:" << m_nodeList->acceptDrops();
+        qCDebug(lcUi) << "节点列表 dragEnabled:" << m_nodeList->dragEnabled();
     }
 }
 
 void MainWindow::testNodeAdding()
 {
-    qDebug() << "=== 测试节点添加功能 ===";
+    qCDebug(lcUi) << "=== 测试节点添加功能 ===";
 
     if (!m_editorCore) {
-        qDebug() << "❌ 编辑器核心为空";
+        qCDebug(lcUi) << "❌ 编辑器核心为空";
         return;
     }
 
     // 测试直接添加节点
     NodeId testNodeId = m_editorCore->addNode("StartNode");
     if (testNodeId != InvalidNodeId) {
-        qDebug() << "✅ 直接添加节点成功，ID:" << testNodeId;
+        qCDebug(lcUi) << "✅ 直接添加节点成功，ID:" << testNodeId;
 
         // 设置位置
         m_editorCore->setNodePosition(testNodeId, QPointF(100, 100));
-        qDebug() << "✅ 节点位置设置完成";
+        qCDebug(lcUi) << "✅ 节点位置设置完成";
 
         // 立即更新状态栏
         updateStatusBar();
     } else {
-        qDebug() << "❌ 直接添加节点失败";
+        qCDebug(lcUi) << "❌ 直接添加节点失败";
     }
 
-    qDebug() << "=== 测试完成 ===";
+    qCDebug(lcUi) << "=== 测试完成 ===";
 }
 #endif
 
@@ -126,24 +131,24 @@ void MainWindow::closeEvent(QCloseEvent *event)
 
 void MainWindow::dragEnterEvent(QDragEnterEvent *event)
 {
-    qDebug() << "=== dragEnterEvent ===";
-    qDebug() << "事件源:" << event->source();
-    qDebug() << "MIME格式:" << event->mimeData()->formats();
-    qDebug() << "事件对象:" << event;
+    qCDebug(lcUi) << "=== dragEnterEvent ===";
+    qCDebug(lcUi) << "事件源:" << event->source();
+    qCDebug(lcUi) << "MIME格式:" << event->mimeData()->formats();
+    qCDebug(lcUi) << "事件对象:" << event;
 
     // 正确的检查：使用 QListWidget 的标准格式
     if (event->mimeData()->hasFormat("application/x-qabstractitemmodeldatalist")) {
         event->acceptProposedAction();
-        qDebug() << "✅ 接受拖拽进入（QListWidget 标准格式）";
+        qCDebug(lcUi) << "✅ 接受拖拽进入（QListWidget 标准格式）";
     }
     // 备用检查：检查事件源
     else if (event->source() == m_nodeList) {
         event->acceptProposedAction();
-        qDebug() << "✅ 接受拖拽进入（来自节点列表）";
+        qCDebug(lcUi) << "✅ 接受拖拽进入（来自节点列表）";
     }
     else {
         event->ignore();
-        qDebug() << "❌ 忽略拖拽进入 - 无有效格式";
+        qCDebug(lcUi) << "❌ 忽略拖拽进入 - 无有效格式";
     }
 }
 
@@ -160,32 +165,32 @@ void MainWindow::dragMoveEvent(QDragMoveEvent *event)
 
 void MainWindow::dropEvent(QDropEvent *event)
 {
-    qDebug() << "=== dropEvent ===";
-    qDebug() << "释放位置:" << event->pos();
-    qDebug() << "事件源:" << event->source();
-    qDebug() << "MIME格式:" << event->mimeData()->formats();
+    qCDebug(lcUi) << "=== dropEvent ===";
+    qCDebug(lcUi) << "释放位置:" << event->pos();
+    qCDebug(lcUi) << "事件源:" << event->source();
+    qCDebug(lcUi) << "MIME格式:" << event->mimeData()->formats();
 
     if (event->source() == m_nodeList) {
         // 获取选中的节点类型
         QList<QListWidgetItem*> selectedItems = m_nodeList->selectedItems();
         if (!selectedItems.isEmpty()) {
             QString nodeType = selectedItems.first()->text();
-            qDebug() << "添加节点类型:" << nodeType;
+            qCDebug(lcUi) << "添加节点类型:" << nodeType;
 
             // 转换坐标
             QPointF scenePos = mapToScenePos(event->pos());
-            qDebug() << "窗口坐标:" << event->pos() << "-> 场景坐标:" << scenePos;
+            qCDebug(lcUi) << "窗口坐标:" << event->pos() << "-> 场景坐标:" << scenePos;
 
             // 添加节点
             addNodeFromDrag(nodeType, scenePos);
             event->acceptProposedAction();
-            qDebug() << "✅ 拖拽完成，添加节点:" << nodeType;
+            qCDebug(lcUi) << "✅ 拖拽完成，添加节点:" << nodeType;
         } else {
-            qDebug() << "❌ 没有选中的节点";
+            qCDebug(lcUi) << "❌ 没有选中的节点";
             event->ignore();
         }
     } else {
-        qDebug() << "❌ 事件源不是节点列表";
+        qCDebug(lcUi) << "❌ 事件源不是节点列表";
         event->ignore();
     }
 }
@@ -206,15 +211,15 @@ QPointF MainWindow::mapToScenePos(const QPoint &windowPos) const
 void MainWindow::addNodeFromDrag(const QString &nodeType, const QPointF &scenePos)
 {
     if (!m_editorCore) {
-        qDebug() << "❌ 编辑器核心未初始化";
+        qCDebug(lcUi) << "❌ 编辑器核心未初始化";
         return;
     }
 
-    qDebug() << "添加节点 - 类型:" << nodeType << "位置:" << scenePos;
+    qCDebug(lcUi) << "添加节点 - 类型:" << nodeType << "位置:" << scenePos;
 
     NodeId nodeId = m_editorCore->addNode(nodeType);
     if (nodeId != InvalidNodeId) {
-        qDebug() << "✅ 节点添加成功，ID:" << nodeId;
+        qCDebug(lcUi) << "✅ 节点添加成功，ID:" << nodeId;
 
         // 设置节点位置
         m_editorCore->setNodePosition(nodeId, scenePos);
@@ -226,7 +231,7 @@ void MainWindow::addNodeFromDrag(const QString &nodeType, const QPointF &scenePo
         statusBar()->showMessage(QString("已添加节点: %1").arg(nodeType), 2000);
     }
     else {
-        qDebug() << "❌ 节点添加失败，类型:" << nodeType;
+        qCDebug(lcUi) << "❌ 节点添加失败，类型:" << nodeType;
         statusBar()->showMessage(QString("添加节点失败: %1").arg(nodeType), 2000);
     }
 }
@@ -252,9 +257,9 @@ void MainWindow::setupUI()
 
         setCentralWidget(m_editorCore->view());
 
-        qDebug() << "UI设置完成，视图拖拽已启用";
+        qCDebug(lcUi) << "UI设置完成，视图拖拽已启用";
     } else {
-        qDebug() << "UI设置失败：编辑器或视图为空";
+        qCDebug(lcUi) << "UI设置失败：编辑器或视图为空";
     }
 }
 
@@ -317,9 +322,47 @@ void MainWindow::setupMenuBar()
     m_deleteAction->setShortcut(QKeySequence::Delete);
     connect(m_deleteAction, &QAction::triggered, this, &MainWindow::deleteSelected);
 
+    m_groupAction = new QAction("组合(&G)", this);
+    m_groupAction->setShortcut(QKeySequence("Ctrl+G"));
+    connect(m_groupAction, &QAction::triggered, this, &MainWindow::groupSelected);
+
+    m_ungroupAction = new QAction("取消组合", this);
+    m_ungroupAction->setShortcut(QKeySequence("Ctrl+Shift+G"));
+    connect(m_ungroupAction, &QAction::triggered, this, &MainWindow::ungroupSelected);
+
+    m_findAction = new QAction("查找节点(&F)", this);
+    m_findAction->setShortcut(QKeySequence::Find);
+    connect(m_findAction, &QAction::triggered, this, &MainWindow::findNode);
+
     editMenu->addAction(m_copyAction);
     editMenu->addAction(m_pasteAction);
     editMenu->addAction(m_deleteAction);
+    editMenu->addSeparator();
+    editMenu->addAction(m_groupAction);
+    editMenu->addAction(m_ungroupAction);
+
+    // 对齐与分布，作用于选中的节点
+    QMenu* alignMenu = editMenu->addMenu("对齐");
+    const std::pair<const char*, NodeAlignment> alignments[] = {
+        {"左对齐", NodeAlignment::Left},
+        {"水平居中", NodeAlignment::HorizontalCenter},
+        {"右对齐", NodeAlignment::Right},
+        {"顶端对齐", NodeAlignment::Top},
+        {"垂直居中", NodeAlignment::VerticalCenter},
+        {"底端对齐", NodeAlignment::Bottom}
+    };
+    for (const auto& entry : alignments) {
+        const NodeAlignment alignment = entry.second;
+        connect(alignMenu->addAction(entry.first), &QAction::triggered, this,
+                [this, alignment]() { alignSelected(alignment); });
+    }
+    alignMenu->addSeparator();
+    connect(alignMenu->addAction("水平分布"), &QAction::triggered, this,
+            [this]() { distributeSelected(Qt::Horizontal); });
+    connect(alignMenu->addAction("垂直分布"), &QAction::triggered, this,
+            [this]() { distributeSelected(Qt::Vertical); });
+    editMenu->addSeparator();
+    editMenu->addAction(m_findAction);
 
     // 视图菜单
     QMenu* viewMenu = menuBar()->addMenu("视图(&V)");
@@ -338,6 +381,9 @@ void MainWindow::setupMenuBar()
     m_fitToViewAction = new QAction("适应视图", this);
     connect(m_fitToViewAction, &QAction::triggered, this, &MainWindow::fitToView);
 
+    m_autoLayoutAction = new QAction("自动布局", this);
+    connect(m_autoLayoutAction, &QAction::triggered, this, &MainWindow::autoLayout);
+
     m_showNodePanelAction = new QAction("节点面板", this);
     m_showNodePanelAction->setCheckable(true);
     m_showNodePanelAction->setChecked(true);
@@ -347,6 +393,7 @@ void MainWindow::setupMenuBar()
     viewMenu->addAction(m_zoomOutAction);
     viewMenu->addAction(m_resetZoomAction);
     viewMenu->addAction(m_fitToViewAction);
+    viewMenu->addAction(m_autoLayoutAction);
     viewMenu->addSeparator();
     viewMenu->addAction(m_showNodePanelAction);
 
@@ -363,9 +410,30 @@ void MainWindow::setupMenuBar()
     m_clearAction = new QAction("清除场景", this);
     connect(m_clearAction, &QAction::triggered, this, &MainWindow::clearScene);
 
+    // 性能分析默认关闭，每个节点的采样有开销；热力图和执行时间线需要它时自动开启
+    m_profilingAction = new QAction("记录执行性能", this);
+    m_profilingAction->setCheckable(true);
+    connect(m_profilingAction, &QAction::toggled, this, &MainWindow::setProfilingEnabled);
+
+    m_exportTraceAction = new QAction("导出执行时间线...", this);
+    connect(m_exportTraceAction, &QAction::triggered, this, &MainWindow::exportExecutionTrace);
+
+    m_heatOverlayAction = new QAction("显示耗时热力图", this);
+    m_heatOverlayAction->setCheckable(true);
+    connect(m_heatOverlayAction, &QAction::toggled, this, &MainWindow::showHeatOverlay);
+
+    m_executionStateAction = new QAction("显示执行状态", this);
+    m_executionStateAction->setCheckable(true);
+    connect(m_executionStateAction, &QAction::toggled, this, &MainWindow::showExecutionState);
+
     toolsMenu->addAction(m_executeAction);
     toolsMenu->addAction(m_validateAction);
     toolsMenu->addAction(m_clearAction);
+    toolsMenu->addSeparator();
+    toolsMenu->addAction(m_profilingAction);
+    toolsMenu->addAction(m_heatOverlayAction);
+    toolsMenu->addAction(m_executionStateAction);
+    toolsMenu->addAction(m_exportTraceAction);
 
     // 帮助菜单
     QMenu* helpMenu = menuBar()->addMenu("帮助(&H)");
@@ -446,10 +514,63 @@ void MainWindow::setupDockWidgets()
         }
     )");
 
+    updateNodePalette();
+
+    m_nodeDock->setWidget(m_nodeList);
+    m_nodeDock->setFeatures(QDockWidget::DockWidgetMovable | QDockWidget::DockWidgetFloatable);
+    m_nodeDock->setMinimumWidth(200);
+
+    addDockWidget(Qt::LeftDockWidgetArea, m_nodeDock);
+
+    // 查找面板：输入即搜索，双击或回车定位到节点
+    m_searchDock = new QDockWidget("查找节点", this);
+    m_searchDock->setObjectName("searchDock");
+    QWidget* searchPanel = new QWidget(m_searchDock);
+    QVBoxLayout* searchLayout = new QVBoxLayout(searchPanel);
+    searchLayout->setContentsMargins(4, 4, 4, 4);
+
+    m_searchEdit = new QLineEdit(searchPanel);
+    m_searchEdit->setPlaceholderText("类型、标题、属性或 ID，例如 type:math add");
+    m_searchEdit->setClearButtonEnabled(true);
+    m_searchResults = new QListWidget(searchPanel);
+    m_searchResults->setUniformItemSizes(true);
+    searchLayout->addWidget(m_searchEdit);
+    searchLayout->addWidget(m_searchResults);
+
+    connect(m_searchEdit, &QLineEdit::textChanged, this, &MainWindow::searchNodes);
+    connect(m_searchEdit, &QLineEdit::returnPressed, this, [this]() {
+        if (m_searchResults->count() > 0) {
+            jumpToSearchResult(m_searchResults->currentItem() ? m_searchResults->currentItem() : m_searchResults->item(0));
+        }
+    });
+    connect(m_searchResults, &QListWidget::itemActivated, this, &MainWindow::jumpToSearchResult);
+
+    m_searchDock->setWidget(searchPanel);
+    m_searchDock->setFeatures(QDockWidget::DockWidgetMovable | QDockWidget::DockWidgetFloatable
+                              | QDockWidget::DockWidgetClosable);
+    addDockWidget(Qt::LeftDockWidgetArea, m_searchDock);
+
+    qCDebug(lcUi) << "节点面板设置完成，拖拽已启用";
+}
+
+void MainWindow::updateNodePalette()
+{
+    if (!m_nodeList || !m_editorCore) return;
+    m_nodeList->clear();
+
     // 添加节点类型
     QStringList nodeTypes = {
-        "StartNode", "EndNode", "MathOperation", "TextDisplay"
+        "StartNode", "EndNode", "MathOperation", "TextDisplay", "FileSource", "BufferInfo"
     };
+    // 插件提供的类型，拖入场景时才加载插件；与内置类型同名的由内置类型优先
+    QStringList pluginTypes;
+    for (const QString& nodeType : m_editorCore->pluginNodeTypes()) {
+        if (!nodeTypes.contains(nodeType) && !pluginTypes.contains(nodeType)) {
+            pluginTypes.append(nodeType);
+        }
+    }
+    nodeTypes.append(pluginTypes);
+    qCDebug(lcUi) << "节点面板 - 插件类型:" << pluginTypes;
 
     for (const QString &nodeType : nodeTypes) {
         QListWidgetItem *item = new QListWidgetItem(nodeType, m_nodeList);
@@ -460,15 +581,10 @@ void MainWindow::setupDockWidgets()
         else if (nodeType == "EndNode") item->setToolTip("结束节点");
         else if (nodeType == "MathOperation") item->setToolTip("数学运算节点");
         else if (nodeType == "TextDisplay") item->setToolTip("文本显示节点");
+        else if (nodeType == "FileSource") item->setToolTip("文件数据节点，输出文件内容的数据块");
+        else if (nodeType == "BufferInfo") item->setToolTip("数据块信息节点");
+        else if (pluginTypes.contains(nodeType)) item->setToolTip("插件节点，第一次添加时加载插件");
     }
-
-    m_nodeDock->setWidget(m_nodeList);
-    m_nodeDock->setFeatures(QDockWidget::DockWidgetMovable | QDockWidget::DockWidgetFloatable);
-    m_nodeDock->setMinimumWidth(200);
-
-    addDockWidget(Qt::LeftDockWidgetArea, m_nodeDock);
-
-    qDebug() << "节点面板设置完成，拖拽已启用";
 }
 
 void MainWindow::setupStatusBar()
@@ -476,10 +592,12 @@ void MainWindow::setupStatusBar()
     m_statusLabel = new QLabel("就绪");
     m_nodeCountLabel = new QLabel("节点: 0");
     m_connectionCountLabel = new QLabel("连接: 0");
+    m_diagnosticLabel = new QLabel("错误: 0  警告: 0");
 
     statusBar()->addWidget(m_statusLabel, 1);
     statusBar()->addPermanentWidget(m_nodeCountLabel);
     statusBar()->addPermanentWidget(m_connectionCountLabel);
+    statusBar()->addPermanentWidget(m_diagnosticLabel);
 }
 
 void MainWindow::setupConnections()
@@ -490,10 +608,17 @@ void MainWindow::setupConnections()
         connect(m_editorCore, &NodeEditorCore::nodeRemoved, this, &MainWindow::updateStatusBar);
         connect(m_editorCore, &NodeEditorCore::connectionAdded, this, &MainWindow::updateStatusBar);
         connect(m_editorCore, &NodeEditorCore::connectionRemoved, this, &MainWindow::updateStatusBar);
+        connect(m_editorCore, &NodeEditorCore::graphBatchApplied, this, &MainWindow::updateStatusBar);
+        // 运行时发现新插件或插件加载失败后刷新节点面板
+        connect(m_editorCore, &NodeEditorCore::pluginsChanged, this, &MainWindow::updateNodePalette);
         connect(m_editorCore, &NodeEditorCore::modificationChanged, this, [this](bool modified) {
             m_isModified = modified;
             updateWindowTitle();
         });
+        if (m_editorCore->validator()) {
+            connect(m_editorCore->validator(), &FlowValidator::validationFinished,
+                    this, &MainWindow::onValidationFinished);
+        }
     }
 }
 
@@ -644,8 +769,112 @@ void MainWindow::paste()
 
 void MainWindow::deleteSelected()
 {
-    statusBar()->showMessage("删除选中项", 1000);
-    // 这里可以添加实际的删除逻辑
+    if (!m_editorCore || !m_editorCore->scene()) return;
+
+    const int removed = m_editorCore->removeSelection();
+    statusBar()->showMessage(QString("已删除 %1 项").arg(removed), 2000);
+}
+
+void MainWindow::alignSelected(NodeAlignment alignment)
+{
+    if (!m_editorCore || !m_editorCore->scene()) return;
+
+    const std::vector<NodeId> selected = m_editorCore->scene()->selectedNodes();
+    if (selected.size() < 2) {
+        statusBar()->showMessage("请至少选择两个节点进行对齐", 2000);
+        return;
+    }
+    m_editorCore->alignNodes(selected, alignment);
+}
+
+void MainWindow::distributeSelected(Qt::Orientation orientation)
+{
+    if (!m_editorCore || !m_editorCore->scene()) return;
+
+    const std::vector<NodeId> selected = m_editorCore->scene()->selectedNodes();
+    if (selected.size() < 3) {
+        statusBar()->showMessage("请至少选择三个节点进行分布", 2000);
+        return;
+    }
+    m_editorCore->distributeNodes(selected, orientation);
+}
+
+void MainWindow::groupSelected()
+{
+    if (!m_editorCore || !m_editorCore->scene()) return;
+
+    std::vector<NodeId> selected = m_editorCore->scene()->selectedNodes();
+    if (selected.size() < 2) {
+        statusBar()->showMessage("请至少选择两个节点进行组合", 2000);
+        return;
+    }
+
+    NodeId groupId = m_editorCore->groupNodes(selected);
+    if (groupId == InvalidNodeId) {
+        QMessageBox::warning(this, "组合", "组合节点失败，详见日志");
+        return;
+    }
+    statusBar()->showMessage(QString("已将 %1 个节点组合").arg(selected.size()), 2000);
+}
+
+void MainWindow::findNode()
+{
+    if (!m_searchDock) return;
+
+    m_searchDock->show();
+    m_searchDock->raise();
+    m_searchEdit->setFocus();
+    m_searchEdit->selectAll();
+}
+
+void MainWindow::searchNodes(const QString &query)
+{
+    if (!m_editorCore || !m_editorCore->searchIndex()) return;
+
+    // 只为返回的前几百个结果读取标题，不随场景规模增长
+    const QList<NodeId> nodeIds = m_editorCore->searchIndex()->search(query);
+    auto model = m_editorCore->graphModel();
+
+    m_searchResults->setUpdatesEnabled(false);
+    m_searchResults->clear();
+    for (NodeId nodeId : nodeIds) {
+        const QString caption = model->nodeData(nodeId, NodeRole::Caption).toString();
+        const QString type = model->nodeData(nodeId, NodeRole::Type).toString();
+        QListWidgetItem* item = new QListWidgetItem(QString("%1  [%2]  #%3").arg(caption, type).arg(nodeId),
+                                                    m_searchResults);
+        item->setData(Qt::UserRole, static_cast<qulonglong>(nodeId));
+    }
+    m_searchResults->setUpdatesEnabled(true);
+
+    if (!query.trimmed().isEmpty()) {
+        statusBar()->showMessage(nodeIds.size() >= NodeSearchIndex::DefaultLimit
+                                     ? QString("找到 %1 个以上的节点").arg(nodeIds.size())
+                                     : QString("找到 %1 个节点").arg(nodeIds.size()), 2000);
+    }
+}
+
+void MainWindow::jumpToSearchResult(QListWidgetItem *item)
+{
+    if (!item || !m_editorCore) return;
+
+    const NodeId nodeId = static_cast<NodeId>(item->data(Qt::UserRole).toULongLong());
+    if (!m_editorCore->centerOnNode(nodeId)) {
+        statusBar()->showMessage("节点已不存在", 2000);
+        searchNodes(m_searchEdit->text());
+    }
+}
+
+void MainWindow::ungroupSelected()
+{
+    if (!m_editorCore || !m_editorCore->scene()) return;
+
+    int restored = 0;
+    for (NodeId nodeId : m_editorCore->scene()->selectedNodes()) {
+        if (m_editorCore->graphModel()->nodeData(nodeId, NodeRole::Type).toString() == "GroupNode") {
+            restored += static_cast<int>(m_editorCore->ungroupNode(nodeId).size());
+        }
+    }
+    statusBar()->showMessage(QString("已展开，恢复 %1 个节点").arg(restored), 2000);
 }
 
 // 视图操作槽函数
@@ -681,6 +910,15 @@ void MainWindow::fitToView()
     }
 }
 
+void MainWindow::autoLayout()
+{
+    if (m_editorCore) {
+        m_editorCore->autoLayout();
+        fitToView();
+        statusBar()->showMessage("自动布局完成", 2000);
+    }
+}
+
 void MainWindow::showNodePanel(bool show)
 {
     if (m_nodeDock) {
@@ -712,14 +950,65 @@ void MainWindow::addTextDisplayNode()
 // 工具操作槽函数
 void MainWindow::executeFlow()
 {
-    statusBar()->showMessage("执行数据流...", 2000);
-    QMessageBox::information(this, "执行", "数据流执行完成");
+    if (!m_editorCore) return;
+
+    statusBar()->showMessage("执行数据流...");
+    QElapsedTimer timer;
+    timer.start();
+    bool success = m_editorCore->executeFlow();
+
+    if (success) {
+        qint64 wallNs = timer.nsecsElapsed();
+        statusBar()->showMessage(QString("数据流执行完成，耗时 %1 ms").arg(wallNs / 1e6, 0, 'f', 2), 5000);
+    } else {
+        statusBar()->showMessage("数据流执行失败", 5000);
+        QMessageBox::warning(this, "执行", "数据流执行失败，详见日志");
+    }
 }
 
 void MainWindow::validateFlow()
 {
+    if (!m_editorCore) return;
+
+    // 校验在后台线程进行，完成后在 onValidationFinished 中显示结果
+    m_validationRequested = true;
     statusBar()->showMessage("验证场景...", 2000);
-    QMessageBox::information(this, "验证", "场景验证完成");
+    m_editorCore->validateFlow();
+}
+
+void MainWindow::onValidationFinished(int errorCount, int warningCount)
+{
+    if (m_diagnosticLabel) {
+        m_diagnosticLabel->setText(QString("错误: %1  警告: %2").arg(errorCount).arg(warningCount));
+    }
+
+    if (!m_validationRequested) return;
+    m_validationRequested = false;
+
+    if (errorCount == 0 && warningCount == 0) {
+        QMessageBox::information(this, "验证", "场景验证通过");
+        return;
+    }
+
+    // 只列出前若干条，避免大图时消息框过长
+    const int maxListed = 20;
+    QStringList lines;
+    const QList<FlowDiagnostic> diagnostics = m_editorCore->validator()->allDiagnostics();
+    for (const FlowDiagnostic& diagnostic : diagnostics) {
+        if (lines.size() >= maxListed) break;
+        QString severity = diagnostic.severity == FlowDiagnostic::Severity::Error ? "错误" : "警告";
+        if (diagnostic.nodeId == InvalidNodeId) {
+            lines.append(QString("[%1] %2").arg(severity, diagnostic.message));
+        } else {
+            lines.append(QString("[%1] 节点 %2: %3").arg(severity).arg(diagnostic.nodeId).arg(diagnostic.message));
+        }
+    }
+    if (diagnostics.size() > maxListed) {
+        lines.append(QString("... 共 %1 条").arg(diagnostics.size()));
+    }
+
+    QMessageBox::warning(this, "验证",
+        QString("发现 %1 个错误，%2 个警告:\n%3").arg(errorCount).arg(warningCount).arg(lines.join("\n")));
 }
 
 void MainWindow::clearScene()
@@ -735,6 +1024,53 @@ void MainWindow::clearScene()
     }
 }
 
+void MainWindow::setProfilingEnabled(bool enabled)
+{
+    if (m_editorCore) {
+        m_editorCore->profiler().setEnabled(enabled);
+    }
+}
+
+void MainWindow::exportExecutionTrace()
+{
+    if (!m_editorCore) return;
+
+    if (!m_profilingAction->isChecked()) {
+        m_profilingAction->setChecked(true);
+        statusBar()->showMessage("已开启性能分析，执行数据流后再导出执行时间线", 5000);
+        return;
+    }
+
+    QString fileName = QFileDialog::getSaveFileName(this,
+        "导出执行时间线", "", "Chrome Trace 文件 (*.json)");
+
+    if (fileName.isEmpty()) return;
+
+    if (m_editorCore->exportExecutionTrace(fileName)) {
+        statusBar()->showMessage("执行时间线已导出，可在 chrome://tracing 中打开", 3000);
+    } else {
+        QMessageBox::warning(this, "错误", "导出执行时间线失败");
+    }
+}
+
+void MainWindow::showHeatOverlay(bool show)
+{
+    if (show && !m_profilingAction->isChecked()) {
+        m_profilingAction->setChecked(true);
+        statusBar()->showMessage("已开启性能分析，热力图在下次执行后显示耗时", 5000);
+    }
+    if (m_editorCore) {
+        m_editorCore->setHeatOverlayVisible(show);
+    }
+}
+
+void MainWindow::showExecutionState(bool show)
+{
+    if (m_editorCore) {
+        m_editorCore->setExecutionStateVisible(show);
+    }
+}
+
 // 帮助槽函数
 void MainWindow::showAbout()
 {
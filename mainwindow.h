@@ -12,6 +12,7 @@
 #include <QToolBar>
 #include <QAction>
 #include <QLabel>
+#include <QLineEdit>
 #include <QCloseEvent>
 
 class MainWindow : public QMainWindow
@@ -46,13 +47,21 @@ private slots:
     void copy();
     void paste();
     void deleteSelected();
+    void groupSelected();
+    void ungroupSelected();
+    void findNode();
+    void alignSelected(NodeAlignment alignment);
+    void distributeSelected(Qt::Orientation orientation);
 
     // 视图操作
     void zoomIn();
     void zoomOut();
     void resetZoom();
     void fitToView();
+    void autoLayout();
     void showNodePanel(bool show);
+    void searchNodes(const QString &query);
+    void jumpToSearchResult(QListWidgetItem *item);
 
     // 节点操作
     void addStartNode();
@@ -63,7 +72,12 @@ private slots:
     // 工具操作
     void executeFlow();
     void validateFlow();
+    void onValidationFinished(int errorCount, int warningCount);
     void clearScene();
+    void exportExecutionTrace();
+    void setProfilingEnabled(bool enabled);
+    void showHeatOverlay(bool show);
+    void showExecutionState(bool show);
 
     // 帮助
     void showAbout();
@@ -72,6 +86,7 @@ private slots:
     // 更新界面
     void updateWindowTitle();
     void updateStatusBar();
+    void updateNodePalette();
 
 private:
     void setupUI();
@@ -93,9 +108,13 @@ private:
     // UI 组件
     QDockWidget *m_nodeDock;
     QListWidget *m_nodeList;
+    QDockWidget *m_searchDock = nullptr;
+    QLineEdit *m_searchEdit = nullptr;
+    QListWidget *m_searchResults = nullptr;
     QLabel *m_statusLabel;
     QLabel *m_nodeCountLabel;
     QLabel *m_connectionCountLabel;
+    QLabel *m_diagnosticLabel;
 
     // 动作
     QAction *m_newAction;
@@ -108,20 +127,29 @@ private:
     QAction *m_copyAction;
     QAction *m_pasteAction;
     QAction *m_deleteAction;
+    QAction *m_groupAction;
+    QAction *m_ungroupAction;
+    QAction *m_findAction;
     QAction *m_zoomInAction;
     QAction *m_zoomOutAction;
     QAction *m_resetZoomAction;
     QAction *m_fitToViewAction;
+    QAction *m_autoLayoutAction;
     QAction *m_showNodePanelAction;
     QAction *m_executeAction;
     QAction *m_validateAction;
     QAction *m_clearAction;
+    QAction *m_profilingAction;
+    QAction *m_exportTraceAction;
+    QAction *m_heatOverlayAction;
+    QAction *m_executionStateAction;
     QAction *m_aboutAction;
     QAction *m_helpAction;
 
     // 状态
     QString m_currentFile;
     bool m_isModified;
+    bool m_validationRequested = false;
 };
 
 #endif // MAINWINDOW_H
\ No newline at end of file
@@ -0,0 +1,163 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "TestNodes.h"
+#include "FlowValidator.h"
+#include <QApplication>
+#include <QLoggingCategory>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <new>
+
+// 稳态执行：同一执行计划重复 executeFlow 时不做任何堆分配
+// glibc 上替换 malloc 系列函数，Qt 容器（直接调用 malloc）和 operator new 都会被计数；
+// 其他平台只替换全局 operator new
+namespace {
+
+std::atomic<long> g_allocations{0};
+thread_local bool t_counting = false;
+
+inline void countAllocation()
+{
+    if (t_counting) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace
+
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+
+void* malloc(size_t size)
+{
+    countAllocation();
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size)
+{
+    countAllocation();
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size)
+{
+    countAllocation();
+    return __libc_realloc(pointer, size);
+}
+}
+#else
+void* operator new(size_t size)
+{
+    countAllocation();
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+#endif
+
+namespace {
+
+long countAllocations(const std::function<void()>& body)
+{
+    g_allocations.store(0);
+    t_counting = true;
+    body();
+    t_counting = false;
+    return g_allocations.load();
+}
+
+void testCounterWorks()
+{
+    // 计数本身失效时后面的断言没有意义
+    const long allocations = countAllocations([]() {
+        delete new int(1);
+        QString text = QString::number(12345);
+        Q_UNUSED(text);
+    });
+    check(allocations >= 2, "分配计数能发现 operator new 和 Qt 容器的分配");
+}
+
+void testSteadyStateExecution()
+{
+    NodeEditorCore core;
+    check(core.initialize(), "初始化编辑器");
+    // 校验器的后台任务不属于执行路径，测试期间不让它启动
+    core.validator()->setAutoValidate(false);
+    registerTestNode(core, "Source", [](NodeId, const NodeInputs&) {
+        return NodeValue(1);
+    });
+    registerTestNode(core, "Step", [](NodeId, const NodeInputs& inputs) {
+        return NodeValue(inputs[0].toInt() + 1);
+    });
+
+    // 一条长链加一条分支，覆盖中间结果的提前释放
+    const NodeId source = core.addNode("Source", QPointF(1, 1));
+    NodeId previous = source;
+    for (int i = 0; i < 32; ++i) {
+        const NodeId step = core.addNode("Step", QPointF(200 * (i + 1), 1));
+        core.addConnection(previous, 0, step, 0);
+        previous = step;
+    }
+    const NodeId branch = core.addNode("Step", QPointF(200, 150));
+    core.addConnection(source, 0, branch, 0);
+
+    // 预热：构建执行计划，结果数组等容量在第一次执行时确定
+    for (int i = 0; i < 3; ++i) {
+        check(core.executeFlow(), "预热执行成功");
+    }
+
+    bool success = true;
+    const long allocations = countAllocations([&]() {
+        for (int i = 0; i < 100; ++i) {
+            success = core.executeFlow() && success;
+        }
+    });
+    check(success, "重复执行成功");
+    if (allocations != 0) {
+        qCritical() << "稳态执行 100 次共分配" << allocations << "次";
+    }
+    check(allocations == 0, "同一执行计划重复执行时没有堆分配");
+
+    const QVariantMap results = core.getExecutionResults();
+    check(results.value(QString::number(previous)).toInt() == 33, "链尾结果正确");
+    check(results.value(QString::number(branch)).toInt() == 2, "分支结果正确");
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    // 热路径的 debug 日志默认关闭；环境变量打开时会格式化参数，这里强制关闭
+    QLoggingCategory::setFilterRules(QStringLiteral("nodeeditor.*.debug=false"));
+
+    testCounterWorks();
+    testSteadyStateExecution();
+
+    if (testFailures() > 0) {
+        qCritical().noquote() << "稳态分配测试失败项:" << testFailures();
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "BufferNodes.h"
+#include "TestNodes.h"
+#include <QApplication>
+#include <QFile>
+#include <QTemporaryDir>
+
+// 大块数据经 BufferData 端口和执行器扇出到多个下游时，下游拿到的是同一块数据
+namespace {
+
+SharedBuffer resultBuffer(const NodeEditorCore& core, NodeId nodeId)
+{
+    return core.getExecutionResults().value(QString::number(nodeId)).value<SharedBuffer>();
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    QTemporaryDir dir;
+    check(dir.isValid(), "创建临时目录");
+    const QString filePath = dir.filePath("frame.bin");
+    const QByteArray bytes(4 << 20, '\x5a');
+    {
+        QFile file(filePath);
+        check(file.open(QIODevice::WriteOnly) && file.write(bytes) == bytes.size(), "写入测试文件");
+    }
+
+    NodeEditorCore core;
+    check(core.initialize(), "初始化编辑器");
+    const NodeId source = core.addNode("FileSource", QPointF(1, 1));
+    const NodeId first = core.addNode("BufferInfo", QPointF(200, 1));
+    const NodeId second = core.addNode("BufferInfo", QPointF(200, 150));
+    core.addConnection(source, 0, first, 0);
+    core.addConnection(source, 0, second, 0);
+    core.graphModel()->delegateModel<FileSourceModel>(source)->setFilePath(filePath);
+
+    // 界面数据流：两个下游收到同一个 BufferData
+    const SharedBuffer firstShown = core.graphModel()->delegateModel<BufferInfoModel>(first)->buffer();
+    const SharedBuffer secondShown = core.graphModel()->delegateModel<BufferInfoModel>(second)->buffer();
+    check(!firstShown.isNull() && firstShown.size() == static_cast<size_t>(bytes.size()), "下游收到文件内容");
+    check(firstShown.sharesDataWith(secondShown), "界面扇出不复制数据块");
+
+    // 执行器路径：两个汇点的结果是同一个缓冲区句柄
+    check(core.executeFlow(), "执行成功");
+    const SharedBuffer firstResult = resultBuffer(core, first);
+    const SharedBuffer secondResult = resultBuffer(core, second);
+    check(firstResult.size() == static_cast<size_t>(bytes.size()), "执行结果是文件内容");
+    check(firstResult.sharesDataWith(secondResult), "执行扇出不复制数据块");
+
+    // 路径随场景保存，重新加载后读取同一个文件
+    NodeEditorCore reloaded;
+    check(reloaded.initialize(), "初始化编辑器");
+    check(reloaded.loadScene(core.saveScene()), "加载保存的场景");
+    check(reloaded.executeFlow(), "重新加载后执行成功");
+    check(resultBuffer(reloaded, first).toByteArray() == bytes, "重新加载后读取同一个文件");
+
+    if (testFailures() > 0) {
+        qCritical().noquote() << "数据块节点测试失败项:" << testFailures();
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "TestNodes.h"
+#include <QApplication>
+#include <QTemporaryDir>
+#include <atomic>
+#include <stdexcept>
+
+// 检查点：中途失败的执行再次运行时从检查点前沿继续，已有检查点的节点不再执行
+namespace {
+
+void testResume(bool scheduled)
+{
+    QTemporaryDir directory;
+    check(directory.isValid(), "创建检查点目录");
+
+    NodeEditorCore core;
+    check(core.initialize(), "初始化编辑器");
+    check(core.enableCheckpoints(directory.path(), CheckpointMode::AllNodes), "打开检查点目录");
+    if (scheduled) {
+        core.setMaxParallelNodes(2);
+    }
+
+    auto sourceCalls = std::make_shared<std::atomic<int>>(0);
+    auto failingCalls = std::make_shared<std::atomic<int>>(0);
+    auto stepCalls = std::make_shared<std::atomic<int>>(0);
+    registerTestNode(core, "Source", [sourceCalls](NodeId, const NodeInputs&) {
+        ++*sourceCalls;
+        return NodeValue(1);
+    });
+    // 只在第一次执行时失败
+    registerTestNode(core, "FailOnce", [failingCalls](NodeId, const NodeInputs& inputs) {
+        if (++*failingCalls == 1) {
+            throw std::runtime_error("第一次执行失败");
+        }
+        return NodeValue(inputs[0].toInt() + 1);
+    });
+    registerTestNode(core, "Step", [stepCalls](NodeId, const NodeInputs& inputs) {
+        ++*stepCalls;
+        return NodeValue(inputs[0].toInt() + 1);
+    });
+
+    const NodeId source = core.addNode("Source", QPointF(1, 1));
+    const NodeId failing = core.addNode("FailOnce", QPointF(200, 1));
+    const NodeId step = core.addNode("Step", QPointF(400, 1));
+    const NodeId sink = core.addNode("Step", QPointF(600, 1));
+    core.addConnection(source, 0, failing, 0);
+    core.addConnection(failing, 0, step, 0);
+    core.addConnection(step, 0, sink, 0);
+
+    check(!core.executeFlow(), "第一次执行在中途失败");
+    check(sourceCalls->load() == 1, "失败前上游节点已执行");
+    check(stepCalls->load() == 0, "失败节点的下游没有执行");
+
+    check(core.executeFlow(), "第二次执行成功");
+    check(sourceCalls->load() == 1, "有检查点的上游节点不再执行");
+    check(failingCalls->load() == 2, "失败的节点从检查点前沿重新执行");
+    check(stepCalls->load() == 2, "前沿之后的节点各执行一次");
+    check(core.getExecutionResults().value(QString::number(sink)).toInt() == 4, "从检查点读回的输入参与计算");
+
+    check(core.executeFlow(), "第三次执行成功");
+    check(sourceCalls->load() == 1 && failingCalls->load() == 2 && stepCalls->load() == 2,
+          "全部节点都有检查点时不再执行任何节点");
+    check(core.getExecutionResults().value(QString::number(sink)).toInt() == 4, "汇点结果从检查点读回");
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    testResume(false);
+    testResume(true);
+
+    if (testFailures() > 0) {
+        qCritical().noquote() << "检查点恢复测试失败项:" << testFailures();
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "ColumnKernels.h"
+#include "ExpressionFusion.h"
+#include "TestNodes.h"
+#include <QCoreApplication>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// 列内核的向量实现与标量实现逐位一致：覆盖向量主体之后的尾部元素、NaN、±0 和无穷；
+// 最小/最大值还要与表达式融合（以及数学节点的界面计算）一致
+namespace {
+
+const ColumnOp AllOps[] = {
+    ColumnOp::Add, ColumnOp::Subtract, ColumnOp::Multiply, ColumnOp::Divide, ColumnOp::Min, ColumnOp::Max,
+    ColumnOp::Less, ColumnOp::LessEqual, ColumnOp::Greater, ColumnOp::GreaterEqual, ColumnOp::Equal,
+    ColumnOp::NotEqual
+};
+
+// 包含向量宽度（AVX2 为 4，NEON 为 2）的各种余数以及一个完整的流式块
+const size_t RowCounts[] = {0, 1, 2, 3, 4, 5, 7, 8, 9, 17, ColumnKernels::ChunkRows + 3};
+
+const double Specials[] = {
+    std::numeric_limits<double>::quiet_NaN(), 0.0, -0.0, 1.5, -2.0,
+    std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), 3.0
+};
+
+SharedBuffer float64Column(size_t rows, int stride, int offset)
+{
+    SharedBuffer column = ColumnKernels::makeColumn(ColumnType::Float64, rows);
+    double* data = reinterpret_cast<double*>(column.mutableData());
+    for (size_t i = 0; i < rows; ++i) {
+        data[i] = Specials[(i * stride + offset) % 8];
+    }
+    return column;
+}
+
+SharedBuffer int64Column(size_t rows, int stride, int offset)
+{
+    SharedBuffer column = ColumnKernels::makeColumn(ColumnType::Int64, rows);
+    qint64* data = reinterpret_cast<qint64*>(column.mutableData());
+    for (size_t i = 0; i < rows; ++i) {
+        data[i] = static_cast<qint64>((i * stride + offset) % 11) - 5;
+    }
+    return column;
+}
+
+SharedBuffer run(ColumnOp op, const SharedBuffer& lhs, const SharedBuffer& rhs, bool simd)
+{
+    ColumnKernels::setSimdEnabled(simd);
+    const NodeValue a(lhs);
+    const NodeValue b(rhs);
+    const NodeValue* inputs[] = {&a, &b};
+    return ColumnKernels::binary(op)(1, NodeInputs(inputs, 2));
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    qDebug().noquote() << "向量指令集:" << ColumnKernels::simdBackend();
+
+    for (size_t rows : RowCounts) {
+        const SharedBuffer f64a = float64Column(rows, 3, 0);
+        const SharedBuffer f64b = float64Column(rows, 5, 1);
+        const SharedBuffer i64a = int64Column(rows, 3, 0);
+        const SharedBuffer i64b = int64Column(rows, 7, 2);
+        for (ColumnOp op : AllOps) {
+            check(run(op, f64a, f64b, true).toByteArray() == run(op, f64a, f64b, false).toByteArray(),
+                  "f64 列的向量与标量结果一致");
+            if (op != ColumnOp::Divide) {
+                check(run(op, i64a, i64b, true).toByteArray() == run(op, i64a, i64b, false).toByteArray(),
+                      "i64 列的向量与标量结果一致");
+            }
+        }
+
+        for (ColumnOp op : {ColumnOp::Min, ColumnOp::Max}) {
+            const FusableOp fusable = (op == ColumnOp::Min) ? FusableOp::Min : FusableOp::Max;
+            const SharedBuffer result = run(op, f64a, f64b, true);
+            const double* a = reinterpret_cast<const double*>(f64a.data());
+            const double* b = reinterpret_cast<const double*>(f64b.data());
+            const double* out = reinterpret_cast<const double*>(result.data());
+            bool same = true;
+            for (size_t i = 0; i < rows; ++i) {
+                const double expected = ExpressionFusion::apply(fusable, a[i], b[i]);
+                same = same && std::memcmp(&expected, &out[i], sizeof(double)) == 0;
+            }
+            check(same, "最小/最大值与表达式融合逐位一致");
+        }
+    }
+    ColumnKernels::setSimdEnabled(true);
+
+    if (testFailures() > 0) {
+        qCritical().noquote() << "列内核测试失败项:" << testFailures();
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "MathNodes.h"
+#include "NodeEditorCore.h"
+#include <QApplication>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSet>
+#include <QtDebug>
+
+// 示例场景保存后重新加载：工作进程、守护进程同步场景以及删除节点的回滚都依赖这一点
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* what)
+{
+    if (!condition) {
+        qCritical().noquote() << "失败:" << what;
+        ++failures;
+    }
+}
+
+// 工具栏可以添加的四种内置节点，数学节点使用非默认的运算符
+QJsonObject buildDemoScene(NodeEditorCore& core)
+{
+    const NodeId start = core.addNode("StartNode", QPointF(0, 0));
+    const NodeId end = core.addNode("EndNode", QPointF(200, 0));
+    const NodeId math = core.addNode("MathOperation", QPointF(100, 150));
+    const NodeId display = core.addNode("TextDisplay", QPointF(100, 300));
+    core.graphModel()->delegateModel<MathOperationModel>(math)->setOperation(MathOperationModel::Operation::Multiply);
+    core.addConnection(start, 0, end, 0);
+    core.addConnection(math, 0, display, 0);
+    return core.saveScene();
+}
+
+QHash<int, QJsonObject> nodesById(const QJsonObject& scene)
+{
+    QHash<int, QJsonObject> nodes;
+    for (const QJsonValue& value : scene["nodes"].toArray()) {
+        nodes.insert(value.toObject()["id"].toInt(), value.toObject());
+    }
+    return nodes;
+}
+
+QSet<QByteArray> connectionsOf(const QJsonObject& scene)
+{
+    QSet<QByteArray> connections;
+    for (const QJsonValue& value : scene["connections"].toArray()) {
+        connections.insert(QJsonDocument(value.toObject()).toJson(QJsonDocument::Compact));
+    }
+    return connections;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    NodeEditorCore source;
+    check(source.initialize(), "初始化编辑器");
+    const QJsonObject scene = buildDemoScene(source);
+
+    for (const QJsonObject& node : nodesById(scene)) {
+        check(node["internal-data"].toObject().contains("model-name"), "节点的 internal-data 包含 model-name");
+    }
+
+    NodeEditorCore target;
+    check(target.initialize(), "初始化编辑器");
+    check(target.loadScene(scene), "加载保存的示例场景");
+    check(target.nodeCount() == source.nodeCount(), "节点数一致");
+    check(target.connectionCount() == source.connectionCount(), "连接数一致");
+
+    const QJsonObject reloaded = target.saveScene();
+    check(nodesById(reloaded) == nodesById(scene), "重新保存的节点（类型、位置、参数）一致");
+    check(connectionsOf(reloaded) == connectionsOf(scene), "重新保存的连接一致");
+
+    bool foundMath = false;
+    for (NodeId nodeId : target.graphModel()->allNodeIds()) {
+        if (auto* math = target.graphModel()->delegateModel<MathOperationModel>(nodeId)) {
+            foundMath = true;
+            check(math->operation() == MathOperationModel::Operation::Multiply, "数学节点的运算符加载后不变");
+        }
+    }
+    check(foundMath, "加载后存在数学节点");
+
+    if (failures > 0) {
+        qCritical().noquote() << "场景往返测试失败项:" << failures;
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,147 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#include "TestNodes.h"
+#include <QApplication>
+#include <QThread>
+#include <atomic>
+#include <stdexcept>
+
+// 调度策略：失败重试、超时放弃以及失败后只跳过下游
+namespace {
+
+NodeValue passThrough(NodeId, const NodeInputs& inputs)
+{
+    return NodeValue(inputs[0].toInt() + 1);
+}
+
+bool hasResult(const NodeEditorCore& core, NodeId nodeId)
+{
+    return core.getExecutionResults().contains(QString::number(nodeId));
+}
+
+void testRetry()
+{
+    NodeEditorCore core;
+    check(core.initialize(), "初始化编辑器");
+    auto calls = std::make_shared<std::atomic<int>>(0);
+    registerTestNode(core, "Flaky", [calls](NodeId, const NodeInputs&) {
+        if (++*calls < 3) {
+            throw std::runtime_error("偶发错误");
+        }
+        return NodeValue(1);
+    });
+    registerTestNode(core, "Sink", passThrough);
+
+    NodeExecutionPolicy policy;
+    policy.maxAttempts = 3;
+    policy.retryDelayMs = 1;
+    core.setNodePolicy("Flaky", policy);
+
+    const NodeId flaky = core.addNode("Flaky", QPointF(1, 1));
+    const NodeId sink = core.addNode("Sink", QPointF(200, 1));
+    core.addConnection(flaky, 0, sink, 0);
+
+    check(core.executeFlow(), "重试后执行成功");
+    const ExecutionReport& report = core.lastExecutionReport();
+    check(calls->load() == 3, "偶发失败的节点共执行 3 次");
+    check(report.retryCount == 2, "重试次数为 2");
+    check(report.failedNodes.isEmpty(), "没有失败的节点");
+    check(core.getExecutionResults().value(QString::number(sink)).toInt() == 2, "下游拿到重试成功的结果");
+}
+
+void testTimeout()
+{
+    NodeEditorCore core;
+    check(core.initialize(), "初始化编辑器");
+    registerTestNode(core, "Slow", [](NodeId, const NodeInputs&) {
+        QThread::msleep(300);
+        return NodeValue(1);
+    });
+    registerTestNode(core, "Fast", [](NodeId, const NodeInputs&) { return NodeValue(1); });
+    registerTestNode(core, "Sink", passThrough);
+
+    NodeExecutionPolicy policy;
+    policy.timeoutMs = 50;
+    policy.continueOnError = true;
+    core.setNodePolicy("Slow", policy);
+    core.setMaxParallelNodes(2);
+
+    const NodeId slow = core.addNode("Slow", QPointF(1, 1));
+    const NodeId slowSink = core.addNode("Sink", QPointF(200, 1));
+    const NodeId fast = core.addNode("Fast", QPointF(1, 150));
+    const NodeId fastSink = core.addNode("Sink", QPointF(200, 150));
+    core.addConnection(slow, 0, slowSink, 0);
+    core.addConnection(fast, 0, fastSink, 0);
+
+    check(!core.executeFlow(), "超时的节点使本轮执行失败");
+    const ExecutionReport& report = core.lastExecutionReport();
+    check(!report.aborted, "continueOnError 时不中止整轮");
+    check(report.timeoutCount == 1, "超时次数为 1");
+    check(report.failedNodes == QList<NodeId>{slow}, "超时的节点记为失败");
+    check(report.skippedNodes == QList<NodeId>{slowSink}, "超时节点的下游被跳过");
+    check(hasResult(core, fastSink), "其他分支的结果仍然有效");
+    check(!hasResult(core, slowSink), "被跳过的节点没有结果");
+    // 编辑器析构时被放弃的执行仍在运行，析构函数有限等待它返回
+}
+
+void testContinueOnError()
+{
+    for (bool continueOnError : {true, false}) {
+        NodeEditorCore core;
+        check(core.initialize(), "初始化编辑器");
+        registerTestNode(core, "Broken", [](NodeId, const NodeInputs&) -> NodeValue {
+            throw std::runtime_error("总是失败");
+        });
+        registerTestNode(core, "Source", [](NodeId, const NodeInputs&) { return NodeValue(1); });
+        registerTestNode(core, "Sink", passThrough);
+
+        NodeExecutionPolicy policy;
+        policy.continueOnError = continueOnError;
+        core.setNodePolicy("Broken", policy);
+
+        const NodeId broken = core.addNode("Broken", QPointF(1, 1));
+        const NodeId brokenSink = core.addNode("Sink", QPointF(200, 1));
+        const NodeId brokenSinkNext = core.addNode("Sink", QPointF(400, 1));
+        const NodeId source = core.addNode("Source", QPointF(1, 150));
+        const NodeId sourceSink = core.addNode("Sink", QPointF(200, 150));
+        core.addConnection(broken, 0, brokenSink, 0);
+        core.addConnection(brokenSink, 0, brokenSinkNext, 0);
+        core.addConnection(source, 0, sourceSink, 0);
+
+        check(!core.executeFlow(), "节点失败时执行返回 false");
+        const ExecutionReport& report = core.lastExecutionReport();
+        check(report.failedNodes == QList<NodeId>{broken}, "失败的节点被记录");
+        check(report.errors.value(broken) == "总是失败", "记录失败原因");
+        if (continueOnError) {
+            check(!report.aborted, "continueOnError 时不中止整轮");
+            check(report.skippedNodes.size() == 2 && report.skippedNodes.contains(brokenSink)
+                      && report.skippedNodes.contains(brokenSinkNext), "失败节点的整个下游被跳过");
+            check(hasResult(core, sourceSink), "其他分支继续执行");
+        } else {
+            check(report.aborted, "没有 continueOnError 时中止整轮");
+            check(report.skippedNodes.isEmpty(), "中止时不记录跳过的节点");
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    testRetry();
+    testTimeout();
+    testContinueOnError();
+
+    if (testFailures() > 0) {
+        qCritical().noquote() << "调度策略测试失败项:" << testFailures();
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+//
+// Created by douziguo on 2026/10/19.
+//
+
+#ifndef NODEEDITORDEMO_TESTNODES_H
+#define NODEEDITORDEMO_TESTNODES_H
+
+#include "BasicNodes.h"
+#include "NodeEditorCore.h"
+#include <QtDebug>
+#include <memory>
+
+// 测试专用节点：1 个输入、1 个输出，类型名由注册时指定，执行器由测试提供
+class TestNodeModel : public NodeDelegateModel
+{
+public:
+    explicit TestNodeModel(QString name) : m_name(std::move(name)) {}
+
+    QString caption() const override { return m_name; }
+    QString name() const override { return m_name; }
+    unsigned int nPorts(PortType) const override { return 1; }
+    NodeDataType dataType(PortType, PortIndex) const override { return FlowData().type(); }
+    std::shared_ptr<NodeData> outData(PortIndex) override { return m_data; }
+    void setInData(std::shared_ptr<NodeData>, PortIndex) override {}
+    QWidget* embeddedWidget() override { return nullptr; }
+
+private:
+    QString m_name;
+    std::shared_ptr<NodeData> m_data = std::make_shared<FlowData>();
+};
+
+inline void registerTestNode(NodeEditorCore& core, const QString& name, TypedNodeExecutor executor)
+{
+    core.registry()->registerModel<TestNodeModel>([name]() { return std::make_unique<TestNodeModel>(name); }, "Test");
+    core.registerTypedNodeExecutor(name, std::move(executor));
+}
+
+// 各测试共用的断言：失败时打印说明并计数，main 按计数返回
+inline int& testFailures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+inline void check(bool condition, const char* what)
+{
+    if (!condition) {
+        qCritical().noquote() << "失败:" << what;
+        ++testFailures();
+    }
+}
+
+#endif // NODEEDITORDEMO_TESTNODES_H
\ No newline at end of file